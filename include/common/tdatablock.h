@@ -19,6 +19,7 @@
 #include "tcommon.h"
 #include "tcompression.h"
 #include "tmsg.h"
+#include "tsched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +35,7 @@ typedef struct SBlockOrderInfo {
 
 #define BLOCK_VERSION_1          1
 #define BLOCK_VERSION_2          2
+#define BLOCK_VERSION_3          3  // the data of each column is compressed, see blockCompressEncode
 
 #define NBIT                     (3u)
 #define BitPos(_n)               ((_n) & ((1 << NBIT) - 1))
@@ -223,6 +225,12 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+/**
+ * @brief sort the block on up to numOfThreads threads, taken from pPool and the calling thread. The block is sorted on
+ * the calling thread alone if pPool is NULL. Like blockDataSort, the order of the rows with equal keys is unspecified,
+ * and it may differ from the order blockDataSort gives.
+ */
+int32_t blockDataSortParallel(SSDataBlock* pDataBlock, SArray* pOrderInfo, SSchedQueue* pPool, int32_t numOfThreads);
 /**
  * @brief find how many rows already in order start from first row
  */
@@ -259,6 +267,13 @@ int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 const char* blockDecode(SSDataBlock* pBlock, const char* pData);
 
+// encode with the data of each column compressed directly from the block, the buffer should be at least the size
+// returned by blockGetCompressEncodeSize
+int32_t blockCompressEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
+int32_t blockGetCompressEncodeSize(const SSDataBlock* pBlock);
+// restore a block encoded by blockCompressEncode to the layout of blockEncode
+int32_t blockDecompressEncode(const char* pData, char** ppRes);
+
 // for debug
 char* dumpBlockData(SSDataBlock* pDataBlock, const char* flag, char** dumpBuf, const char* taskIdStr);
 
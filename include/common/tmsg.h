@@ -1525,6 +1525,9 @@ typedef struct {
   int64_t numOfBatchInsertSuccessReqs;
   int32_t numOfCachedTables;
   int32_t learnerProgress;  // use one reservered
+  int64_t bufferUsage;
+  int64_t bufferWaste;
+  int64_t bufferOverflow;
 } SVnodeLoad;
 
 typedef struct {
@@ -3959,6 +3962,8 @@ typedef struct {
 
 int32_t tEncodeSubmitReq(SEncoder* pCoder, const SSubmitReq2* pReq);
 int32_t tDecodeSubmitReq(SDecoder* pCoder, SSubmitReq2* pReq);
+// only the tables in pUidHash are decoded, the others are left out of pReq->aSubmitTbData
+int32_t tDecodeSubmitReqFilter(SDecoder* pCoder, SSubmitReq2* pReq, SHashObj* pUidHash);
 void    tDestroySubmitTbData(SSubmitTbData* pTbData, int32_t flag);
 void    tDestroySubmitReq(SSubmitReq2* pReq, int32_t flag);
 
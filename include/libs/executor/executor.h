@@ -187,6 +187,14 @@ void qProcessRspMsg(void* parent, struct SRpcMsg* pMsg, struct SEpSet* pEpSet);
 
 int32_t qGetExplainExecInfo(qTaskInfo_t tinfo, SArray* pExecInfoList);
 
+/**
+ * start the threads sorting the in-memory runs of the sort operators in parallel. Without them the runs are sorted
+ * on the threads of the queries.
+ */
+int32_t qInitSortPool();
+
+void qCleanupSortPool();
+
 void getNextTimeWindow(const SInterval* pInterval, STimeWindow* tw, int32_t order);
 void getInitialStartTimeWindow(SInterval* pInterval, TSKEY ts, STimeWindow* w, bool ascQuery);
 STimeWindow getAlignQueryTimeWindow(const SInterval* pInterval, int64_t key);
@@ -41,6 +41,9 @@ extern "C" {
 
 #define SYNC_MAX_RETRY_BACKOFF         5
 #define SYNC_LOG_REPL_RETRY_WAIT_MS    100
+#define SYNC_LOG_REPL_MIN_WINDOW       16
+#define SYNC_LOG_REPL_RTT_SLACK_MS     20
+#define SYNC_LOG_REPL_MIN_RTT_WIN_MS   10000
 #define SYNC_APPEND_ENTRIES_TIMEOUT_MS 10000
 #define SYNC_HEART_TIMEOUT_MS          1000 * 15
 
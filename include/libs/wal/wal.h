@@ -98,6 +98,8 @@ typedef struct {
 } SWalCkHead;
 #pragma pack(pop)
 
+typedef struct SWalReadCache SWalReadCache;
+
 typedef struct SWal {
   // cfg
   SWalCfg cfg;
@@ -120,7 +122,13 @@ typedef struct SWal {
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
   char path[WAL_PATH_LEN];
-  // reusable write head
+  // latest entries read, shared by the readers
+  SWalReadCache *pReadCache;
+  // group commit
+  bool inGroupCommit;
+  bool groupNeedFsync;
+  bool groupForceFsync;
+  // reusable write head, ends with a flexible array member
   SWalCkHead writeHead;
 } SWal;
 
@@ -154,6 +162,9 @@ struct SWalReader {
   TdThreadMutex  mutex;
   SWalFilterCond cond;
   SWalCkHead *pHead;
+  int8_t         cached;       // pHead is copied from the read cache, the log file is not read
+  int8_t         shareCache;   // a tq or stream reader, which shares the read cache with the others
+  int8_t         cacheReader;  // counted as a reader by the read cache
 };
 
 // module initialization
@@ -179,6 +190,10 @@ int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMet
 
 void walFsync(SWal *, bool force);
 
+// Group commit: between begin and end, walFsync only records the request, and a single fsync is done on end
+void walBeginGroupCommit(SWal *);
+void walEndGroupCommit(SWal *);
+
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
 int32_t walRollback(SWal *, int64_t ver);
@@ -192,7 +207,7 @@ int32_t walApplyVer(SWal *, int64_t ver);
 // int32_t  walDataCorrupted(SWal*);
 
 // wal reader
-SWalReader *walOpenReader(SWal *, SWalFilterCond *pCond, int64_t id);
+SWalReader *walOpenReader(SWal *, SWalFilterCond *pCond, int64_t id, bool shareCache);
 void        walCloseReader(SWalReader *pRead);
 void        walReadReset(SWalReader *pReader);
 int32_t     walReadVer(SWalReader *pRead, int64_t ver);
@@ -54,6 +54,13 @@ extern "C" {
 
 typedef struct TdFile *TdFilePtr;
 
+#define TD_FILE_MAX_IOV 16
+
+typedef struct TdFileIoVec {
+  const void *buf;
+  int64_t     len;
+} TdFileIoVec;
+
 #define TD_FILE_CREATE        0x0001
 #define TD_FILE_WRITE         0x0002
 #define TD_FILE_READ          0x0004
@@ -91,6 +98,7 @@ int32_t taosFsyncFile(TdFilePtr pFile);
 int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIoVec *pVec, int32_t count);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
 
@@ -121,6 +129,35 @@ int32_t taosLinkFile(char *src, char *dst);
 
 bool lastErrorIsFileNotExist();
 
+// Asynchronous pread/pwrite, by io_uring on Linux if the kernel supports it, or by a shared thread pool otherwise.
+// The files must not be closed and the buffers must not be released until the requests on them are completed. A
+// TdAIOPtr is used by one thread at a time.
+typedef struct STaosAIOReq {
+  TdFilePtr pFile;
+  void     *buf;
+  int64_t   count;
+  int64_t   offset;
+  int8_t    write;
+  int64_t   res;    // bytes read or written when completed, or -1 with errno in code
+  int32_t   code;
+  void     *param;  // of the caller
+} STaosAIOReq;
+
+typedef struct STaosAIO *TdAIOPtr;
+
+#define TD_AIO_RING        0x1  // fails if io_uring is not available
+#define TD_AIO_THREAD_POOL 0x2  // never uses io_uring
+
+TdAIOPtr taosAIOOpen(int32_t depth, int32_t flags);
+void     taosAIOClose(TdAIOPtr pAio);
+// returns the number of requests submitted, which is less than num if there are already depth requests in flight
+int32_t  taosAIOSubmit(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num);
+// returns the number of completed requests, waits for at least one if block is set and any request is in flight
+int32_t  taosAIOGetCompleted(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num, bool block);
+int32_t  taosAIOGetInflight(TdAIOPtr pAio);
+// stops the threads of the thread pool after the queued requests are done
+void     taosAIOCleanup();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * DDSketch, a quantile sketch with relative error guarantee, see "DDSketch: A Fast and Fully-Mergeable Quantile
+ * Sketch with Relative-Error Guarantees", VLDB 2019.
+ *
+ * The sketch has a fixed size and holds no pointer, so that it can be copied as the intermediate result of
+ * aggregate functions. When more bins are required than available, the bins of the smallest magnitude are
+ * collapsed, which keeps the accuracy of the higher quantiles.
+ */
+
+#ifndef _TD_UTIL_DDSKETCH_H_
+#define _TD_UTIL_DDSKETCH_H_
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DDSKETCH_RELATIVE_ACCURACY 0.01
+#define DDSKETCH_POSITIVE_BINS     768
+#define DDSKETCH_NEGATIVE_BINS     256
+
+typedef struct SDDSketchStore {
+  int32_t minKey;  // key of the first bin
+  int32_t maxKey;  // largest key added, valid only if count > 0
+  int64_t count;
+} SDDSketchStore;
+
+typedef struct SDDSketch {
+  double         multiplier;  // 1 / ln(gamma)
+  int64_t        count;
+  int64_t        zeroCount;
+  double         min;
+  double         max;
+  SDDSketchStore pos;
+  SDDSketchStore neg;
+  int64_t        posBins[DDSKETCH_POSITIVE_BINS];
+  int64_t        negBins[DDSKETCH_NEGATIVE_BINS];
+} SDDSketch;
+
+SDDSketch *tDDSketchNewFrom(void *pBuf);
+void       tDDSketchAdd(SDDSketch *pSketch, double v, int64_t n);
+void       tDDSketchMerge(SDDSketch *pDst, const SDDSketch *pSrc);
+double     tDDSketchQuantile(const SDDSketch *pSketch, double q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_UTIL_DDSKETCH_H_*/
@@ -56,6 +56,11 @@ typedef enum {
   RPC_QITEM = 1,
 } EQItype;
 
+typedef enum {
+  QITEM_PRI_NORMAL = 0,
+  QITEM_PRI_HIGH = 1,
+} EQItemPri;
+
 typedef void (*FItem)(SQueueInfo *pInfo, void *pItem);
 typedef void (*FItems)(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfItems);
 
@@ -78,6 +83,7 @@ void        taosSetQueueFp(STaosQueue *queue, FItem itemFp, FItems itemsFp);
 void       *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize);
 void        taosFreeQitem(void *pItem);
 int32_t     taosWriteQitem(STaosQueue *queue, void *pItem);
+int32_t     taosWriteQitemWithPriority(STaosQueue *queue, void *pItem, EQItemPri priority);
 int32_t     taosReadQitem(STaosQueue *queue, void **ppItem);
 bool        taosQueueEmpty(STaosQueue *queue);
 void        taosUpdateItemSize(STaosQueue *queue, int32_t items);
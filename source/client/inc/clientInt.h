@@ -199,6 +199,7 @@ typedef struct SReqResultInfo {
   bool           convertUcs4;
   int32_t        payloadLen;
   char*          convertJson;
+  char*          decompBuf;  // the result block with the column data decompressed
 } SReqResultInfo;
 
 typedef struct SRequestSendRecvBody {
@@ -2195,7 +2195,16 @@ int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableR
   pResultInfo->payloadLen = htonl(pRsp->compLen);
   pResultInfo->precision = pRsp->precision;
 
-  // TODO handle the compressed case
+  if (pResultInfo->numOfRows > 0 && *(int32_t*)pResultInfo->pData == BLOCK_VERSION_3) {
+    taosMemoryFreeClear(pResultInfo->decompBuf);
+    int32_t code = blockDecompressEncode(pResultInfo->pData, &pResultInfo->decompBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      tscError("failed to decompress the result block, code:%s", tstrerror(code));
+      return code;
+    }
+    pResultInfo->pData = pResultInfo->decompBuf;
+  }
+
   pResultInfo->totalRows += pResultInfo->numOfRows;
   return setResultDataPtr(pResultInfo, pResultInfo->fields, pResultInfo->numOfCols, pResultInfo->numOfRows,
                           convertUcs4);
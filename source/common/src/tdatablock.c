@@ -15,9 +15,11 @@
 
 #define _DEFAULT_SOURCE
 #include "tdatablock.h"
+#include "lz4.h"
 #include "tcompare.h"
 #include "tlog.h"
 #include "tname.h"
+#include "tsched.h"
 
 #define MALLOC_ALIGN_BYTES 32
 
@@ -1045,7 +1047,304 @@ static int32_t* createTupleIndex(size_t rows) {
 
 static void destroyTupleIndex(int32_t* index) { taosMemoryFreeClear(index); }
 
+#define BLOCK_SORT_MIN_ROWS_PER_THREAD 16384
+
+typedef struct SBlockSortPartition {
+  int32_t*                     index;
+  int32_t                      rows;
+  int32_t                      code;
+  const SSDataBlockSortHelper* pHelper;
+  tsem_t*                      pDone;
+} SBlockSortPartition;
+
+static void blockSortPartition(SBlockSortPartition* pPart) {
+  terrno = 0;
+  taosqsort(pPart->index, pPart->rows, sizeof(int32_t), pPart->pHelper, dataBlockCompar);
+  pPart->code = terrno;
+}
+
+static void blockSortPartitionTask(SSchedMsg* pMsg) {
+  SBlockSortPartition* pPart = pMsg->ahandle;
+  blockSortPartition(pPart);
+  tsem_post(pPart->pDone);
+}
+
+// merge the two adjacent sorted runs [pSrc, pSrc + leftRows) and [pSrc + leftRows, pSrc + rows) into pDst
+static void blockSortMergeRuns(const int32_t* pSrc, int32_t leftRows, int32_t rows, int32_t* pDst,
+                               const SSDataBlockSortHelper* pHelper) {
+  int32_t i = 0, j = leftRows, k = 0;
+  while (i < leftRows && j < rows) {
+    // take from the left run on ties so that the merge is stable. The result equals the single thread sort only
+    // when the partitions are sorted stably as well, which taosqsort does not promise for equal keys.
+    if (dataBlockCompar(&pSrc[j], &pSrc[i], pHelper) < 0) {
+      pDst[k++] = pSrc[j++];
+    } else {
+      pDst[k++] = pSrc[i++];
+    }
+  }
+
+  if (i < leftRows) memcpy(pDst + k, pSrc + i, (leftRows - i) * sizeof(int32_t));
+  if (j < rows) memcpy(pDst + k, pSrc + j, (rows - j) * sizeof(int32_t));
+}
+
+#define BLOCK_SORT_MIN_RADIX_ROWS 256
+#define BLOCK_SORT_MAX_NORM_KEY   32
+
+static bool isNormKeyType(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      return true;
+    default:
+      // float and double are compared with an epsilon, which a byte-wise key cannot express
+      return false;
+  }
+}
+
+// length of the memcmp-comparable key of the order columns, or 0 if they cannot be normalized
+static int32_t blockSortGetNormKeyLen(const SSDataBlockSortHelper* pHelper) {
+  int32_t keyLen = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pHelper->orderInfo); ++i) {
+    SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pHelper->orderInfo, i);
+    SColumnInfoData* pCol = pOrder->pColData;
+    if (!isNormKeyType(pCol->info.type)) {
+      return 0;
+    }
+
+    keyLen += pCol->info.bytes + (pCol->hasNull ? 1 : 0);
+  }
+
+  return (keyLen <= BLOCK_SORT_MAX_NORM_KEY) ? keyLen : 0;
+}
+
+/*
+ * Encode the order columns of one row into big-endian bytes, so that memcmp on the keys gives the same order as
+ * dataBlockCompar: the sign bit of signed values is flipped, desc columns are inverted, and a leading flag byte
+ * places the null values of a nullable column according to nullFirst.
+ */
+static void blockSortEncodeNormKey(const SSDataBlockSortHelper* pHelper, int32_t row, uint8_t* pKey) {
+  for (int32_t i = 0; i < taosArrayGetSize(pHelper->orderInfo); ++i) {
+    SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pHelper->orderInfo, i);
+    SColumnInfoData* pCol = pOrder->pColData;
+    int32_t          bytes = pCol->info.bytes;
+
+    if (pCol->hasNull) {
+      bool isNull = colDataIsNull_f(pCol->nullbitmap, row);
+      *pKey++ = (isNull == pOrder->nullFirst) ? 0 : 1;
+      if (isNull) {
+        memset(pKey, 0, bytes);
+        pKey += bytes;
+        continue;
+      }
+    }
+
+    uint64_t val = 0;
+    switch (bytes) {
+      case sizeof(uint8_t):
+        val = *(uint8_t*)colDataGetNumData(pCol, row);
+        break;
+      case sizeof(uint16_t):
+        val = *(uint16_t*)colDataGetNumData(pCol, row);
+        break;
+      case sizeof(uint32_t):
+        val = *(uint32_t*)colDataGetNumData(pCol, row);
+        break;
+      default:
+        val = *(uint64_t*)colDataGetNumData(pCol, row);
+        break;
+    }
+
+    if (!IS_UNSIGNED_NUMERIC_TYPE(pCol->info.type)) {
+      val ^= 1ULL << (bytes * 8 - 1);
+    }
+
+    if (pOrder->order == TSDB_ORDER_DESC) {
+      val = ~val;
+    }
+
+    for (int32_t j = bytes - 1; j >= 0; --j) {
+      pKey[j] = (uint8_t)val;
+      val >>= 8;
+    }
+    pKey += bytes;
+  }
+}
+
+/*
+ * LSD radix sort of the tuple index on the normalized keys. Every entry holds the key followed by the row index, and
+ * one counting pass is done per key byte, skipping the bytes that are the same for all rows.
+ */
+static int32_t blockDataRadixSortIndex(int32_t* index, int32_t rows, const SSDataBlockSortHelper* pHelper,
+                                       int32_t keyLen) {
+  int32_t  entrySize = keyLen + sizeof(int32_t);
+  uint8_t* pSrc = taosMemoryMalloc((int64_t)rows * entrySize);
+  uint8_t* pDst = taosMemoryMalloc((int64_t)rows * entrySize);
+  if (pSrc == NULL || pDst == NULL) {
+    taosMemoryFree(pSrc);
+    taosMemoryFree(pDst);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < rows; ++i) {
+    uint8_t* pEntry = pSrc + (int64_t)i * entrySize;
+    blockSortEncodeNormKey(pHelper, index[i], pEntry);
+    memcpy(pEntry + keyLen, &index[i], sizeof(int32_t));
+  }
+
+  int64_t count[256];
+  for (int32_t b = keyLen - 1; b >= 0; --b) {
+    memset(count, 0, sizeof(count));
+    for (int32_t i = 0; i < rows; ++i) {
+      count[pSrc[(int64_t)i * entrySize + b]] += 1;
+    }
+
+    if (count[pSrc[b]] == rows) {
+      continue;
+    }
+
+    int64_t offset = 0;
+    for (int32_t i = 0; i < 256; ++i) {
+      int64_t c = count[i];
+      count[i] = offset;
+      offset += c;
+    }
+
+    for (int32_t i = 0; i < rows; ++i) {
+      uint8_t* pEntry = pSrc + (int64_t)i * entrySize;
+      memcpy(pDst + count[pEntry[b]]++ * entrySize, pEntry, entrySize);
+    }
+
+    uint8_t* p = pSrc;
+    pSrc = pDst;
+    pDst = p;
+  }
+
+  for (int32_t i = 0; i < rows; ++i) {
+    memcpy(&index[i], pSrc + (int64_t)i * entrySize + keyLen, sizeof(int32_t));
+  }
+
+  taosMemoryFree(pSrc);
+  taosMemoryFree(pDst);
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * Sort the tuple index on numOfThreads threads: every partition of the index is sorted by pPool, and the sorted
+ * partitions are merged pairwise afterwards. The calling thread sorts the first partition itself, and any partition
+ * the pool cannot take.
+ */
+static int32_t blockDataSortIndex(int32_t* index, int32_t rows, const SSDataBlockSortHelper* pHelper,
+                                  SSchedQueue* pPool, int32_t numOfThreads) {
+  // integer and timestamp keys are radix sorted, which needs no comparison at all
+  int32_t keyLen = blockSortGetNormKeyLen(pHelper);
+  if (keyLen > 0 && rows >= BLOCK_SORT_MIN_RADIX_ROWS &&
+      blockDataRadixSortIndex(index, rows, pHelper, keyLen) == TSDB_CODE_SUCCESS) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  numOfThreads = TMIN(numOfThreads, rows / BLOCK_SORT_MIN_ROWS_PER_THREAD);
+  if (numOfThreads <= 1 || pPool == NULL) {
+    terrno = 0;
+    taosqsort(index, rows, sizeof(int32_t), pHelper, dataBlockCompar);
+    return terrno;
+  }
+
+  int32_t              code = TSDB_CODE_SUCCESS;
+  int32_t              numOfScheduled = 0;
+  tsem_t               done;
+  int32_t*             pTmp = taosMemoryMalloc(rows * sizeof(int32_t));
+  SBlockSortPartition* pParts = taosMemoryCalloc(numOfThreads, sizeof(SBlockSortPartition));
+  if (pTmp == NULL || pParts == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  if (tsem_init(&done, 0, 0) != 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+  int32_t step = rows / numOfThreads;
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    pParts[i].index = index + i * step;
+    pParts[i].rows = (i == numOfThreads - 1) ? (rows - i * step) : step;
+    pParts[i].pHelper = pHelper;
+    pParts[i].pDone = &done;
+  }
+
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    SSchedMsg schedMsg = {0};
+    schedMsg.fp = blockSortPartitionTask;
+    schedMsg.ahandle = &pParts[i];
+    if (taosScheduleTask(pPool, &schedMsg) != 0) {
+      // the pool is stopped, sort the remaining partitions on the calling thread
+      for (int32_t j = i; j < numOfThreads; ++j) {
+        blockSortPartition(&pParts[j]);
+      }
+      break;
+    }
+    numOfScheduled += 1;
+  }
+
+  blockSortPartition(&pParts[0]);
+
+  for (int32_t i = 0; i < numOfScheduled; ++i) {
+    tsem_wait(&done);
+  }
+  tsem_destroy(&done);
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    if (pParts[i].code != TSDB_CODE_SUCCESS) {
+      code = pParts[i].code;
+      goto _exit;
+    }
+  }
+
+  // merge the sorted partitions pairwise, doubling the run width on each pass
+  int32_t* pSrc = index;
+  int32_t* pDst = pTmp;
+  for (int32_t width = 1; width < numOfThreads; width *= 2) {
+    for (int32_t i = 0; i < numOfThreads; i += 2 * width) {
+      int32_t start = i * step;
+      if (i + width >= numOfThreads) {
+        memcpy(pDst + start, pSrc + start, (rows - start) * sizeof(int32_t));
+        continue;
+      }
+
+      int32_t mid = (i + width) * step;
+      int32_t end = (i + 2 * width >= numOfThreads) ? rows : (i + 2 * width) * step;
+      blockSortMergeRuns(pSrc + start, mid - start, end - start, pDst + start, pHelper);
+    }
+
+    int32_t* p = pSrc;
+    pSrc = pDst;
+    pDst = p;
+  }
+
+  if (pSrc != index) {
+    memcpy(index, pSrc, rows * sizeof(int32_t));
+  }
+
+_exit:
+  taosMemoryFree(pTmp);
+  taosMemoryFree(pParts);
+  terrno = code;
+  return code;
+}
+
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
+  return blockDataSortParallel(pDataBlock, pOrderInfo, NULL, 1);
+}
+
+int32_t blockDataSortParallel(SSDataBlock* pDataBlock, SArray* pOrderInfo, SSchedQueue* pPool, int32_t numOfThreads) {
   if (pDataBlock->info.rows <= 1) {
     return TSDB_CODE_SUCCESS;
   }
@@ -1107,9 +1406,10 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
     pInfo->compFn = getKeyComparFunc(pInfo->pColData->info.type, pInfo->order);
   }
 
-  terrno = 0;
-  taosqsort(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
-  if (terrno) return terrno;
+  if (blockDataSortIndex(index, rows, &helper, pPool, numOfThreads) != TSDB_CODE_SUCCESS) {
+    destroyTupleIndex(index);
+    return terrno;
+  }
 
   int64_t p1 = taosGetTimestampUs();
 
@@ -1130,8 +1430,8 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   int64_t p4 = taosGetTimestampUs();
 
   uDebug("blockDataSort complex sort:%" PRId64 ", create:%" PRId64 ", assign:%" PRId64 ", copyback:%" PRId64
-         ", rows:%d\n",
-         p1 - p0, p2 - p1, p3 - p2, p4 - p3, rows);
+         ", rows:%d, threads:%d\n",
+         p1 - p0, p2 - p1, p3 - p2, p4 - p3, rows, numOfThreads);
   destroyTupleIndex(index);
 
   return TSDB_CODE_SUCCESS;
@@ -2191,12 +2491,25 @@ int32_t buildCtbNameByGroupIdImpl(const char* stbFullName, uint64_t groupId, cha
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+// the column data is stored as is when it can not be compressed smaller
+static int32_t compressColData(const char* pSrc, char* pDst, int32_t len) {
+  int32_t compLen = 0;
+  if (pSrc != NULL && len > 0) {
+    compLen = LZ4_compress_default(pSrc, pDst, len, len - 1);
+    if (compLen <= 0) {
+      memcpy(pDst, pSrc, len);
+      compLen = len;
+    }
+  }
+  return compLen;
+}
+
+static int32_t doBlockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols, bool compress) {
   int32_t dataLen = 0;
 
   // todo extract method
   int32_t* version = (int32_t*)data;
-  *version = BLOCK_VERSION_1;
+  *version = compress ? BLOCK_VERSION_3 : BLOCK_VERSION_1;
   data += sizeof(int32_t);
 
   int32_t* actualLen = (int32_t*)data;
@@ -2253,6 +2566,14 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
     data += metaSize;
     dataLen += metaSize;
 
+    // the length before compression, followed by the compressed data
+    int32_t* rawLen = NULL;
+    if (compress) {
+      rawLen = (int32_t*)data;
+      data += sizeof(int32_t);
+      dataLen += sizeof(int32_t);
+    }
+
     if (pColRes->reassigned && IS_VAR_DATA_TYPE(pColRes->info.type)) {
       colSizes[col] = 0;
       for (int32_t row = 0; row < numOfRows; ++row) {
@@ -2268,6 +2589,14 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
         memmove(data, pColData, colSize);
         data += colSize;
       }
+      if (rawLen != NULL) {
+        *rawLen = colSizes[col];
+      }
+    } else if (compress) {
+      *rawLen = colDataGetLength(pColRes, numOfRows);
+      colSizes[col] = compressColData(pColRes->pData, data, *rawLen);
+      dataLen += colSizes[col];
+      data += colSizes[col];
     } else {
       colSizes[col] = colDataGetLength(pColRes, numOfRows);
       dataLen += colSizes[col];
@@ -2292,6 +2621,87 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
   return dataLen;
 }
 
+int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+  return doBlockEncode(pBlock, data, numOfCols, false);
+}
+
+int32_t blockCompressEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
+  return doBlockEncode(pBlock, data, numOfCols, true);
+}
+
+int32_t blockGetCompressEncodeSize(const SSDataBlock* pBlock) {
+  return blockGetEncodeSize(pBlock) + (int32_t)(taosArrayGetSize(pBlock->pDataBlock) * sizeof(int32_t));
+}
+
+static int32_t decompressColData(const char* pSrc, char* pDst, int32_t len, int32_t rawLen) {
+  if (len == rawLen) {
+    memcpy(pDst, pSrc, len);
+  } else if (LZ4_decompress_safe(pSrc, pDst, len, rawLen) != rawLen) {
+    uError("failed to decompress column data, len:%d, rawLen:%d", len, rawLen);
+    terrno = TSDB_CODE_INVALID_DATA_FMT;
+    return terrno;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t blockDecompressEncode(const char* pData, char** ppRes) {
+  int32_t numOfRows = *(int32_t*)(pData + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+
+  // | version | total length | total rows | total columns | flag seg | block group id | column schema
+  const char*    pSchema = pData + sizeof(int32_t) * 5 + sizeof(uint64_t);
+  int32_t        metaLen = (int32_t)(pSchema - pData) + numOfCols * (sizeof(int8_t) + sizeof(int32_t));
+  const int32_t* colLen = (const int32_t*)(pData + metaLen);
+  const char*    pStart = (const char*)(colLen + numOfCols);
+
+  int32_t     len = metaLen + numOfCols * sizeof(int32_t) + sizeof(bool);
+  const char* p = pStart;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaSize = IS_VAR_DATA_TYPE(type) ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+    p += metaSize;
+    len += metaSize + *(int32_t*)p;
+    p += sizeof(int32_t) + htonl(colLen[i]);
+  }
+
+  char* pRes = taosMemoryMalloc(len);
+  if (pRes == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return terrno;
+  }
+
+  memcpy(pRes, pData, metaLen);
+  *(int32_t*)pRes = BLOCK_VERSION_1;
+  *(int32_t*)(pRes + sizeof(int32_t)) = len;
+
+  int32_t* resColLen = (int32_t*)(pRes + metaLen);
+  char*    q = (char*)(resColLen + numOfCols);
+  p = pStart;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaSize = IS_VAR_DATA_TYPE(type) ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+    memcpy(q, p, metaSize);
+    p += metaSize;
+    q += metaSize;
+
+    int32_t rawLen = *(int32_t*)p;
+    int32_t compLen = htonl(colLen[i]);
+    p += sizeof(int32_t);
+    if (compLen > 0 && decompressColData(p, q, compLen, rawLen) != TSDB_CODE_SUCCESS) {
+      taosMemoryFree(pRes);
+      return terrno;
+    }
+
+    resColLen[i] = htonl(rawLen);
+    p += compLen;
+    q += rawLen;
+  }
+
+  *(bool*)q = *(bool*)p;
+  *ppRes = pRes;
+  return TSDB_CODE_SUCCESS;
+}
+
 const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
   const char* pStart = pData;
 
@@ -2349,25 +2759,33 @@ const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
     if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
       memcpy(pColInfoData->varmeta.offset, pStart, sizeof(int32_t) * numOfRows);
       pStart += sizeof(int32_t) * numOfRows;
+    } else {
+      memcpy(pColInfoData->nullbitmap, pStart, BitmapLen(numOfRows));
+      pStart += BitmapLen(numOfRows);
+    }
+
+    int32_t rawLen = colLen[i];
+    if (version == BLOCK_VERSION_3) {
+      rawLen = *(int32_t*)pStart;
+      pStart += sizeof(int32_t);
+    }
 
-      if (colLen[i] > 0 && pColInfoData->varmeta.allocLen < colLen[i]) {
-        char* tmp = taosMemoryRealloc(pColInfoData->pData, colLen[i]);
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      if (rawLen > 0 && pColInfoData->varmeta.allocLen < rawLen) {
+        char* tmp = taosMemoryRealloc(pColInfoData->pData, rawLen);
         if (tmp == NULL) {
           return NULL;
         }
 
         pColInfoData->pData = tmp;
-        pColInfoData->varmeta.allocLen = colLen[i];
+        pColInfoData->varmeta.allocLen = rawLen;
       }
 
-      pColInfoData->varmeta.length = colLen[i];
-    } else {
-      memcpy(pColInfoData->nullbitmap, pStart, BitmapLen(numOfRows));
-      pStart += BitmapLen(numOfRows);
+      pColInfoData->varmeta.length = rawLen;
     }
 
-    if (colLen[i] > 0) {
-      memcpy(pColInfoData->pData, pStart, colLen[i]);
+    if (colLen[i] > 0 && decompressColData(pStart, pColInfoData->pData, colLen[i], rawLen) != TSDB_CODE_SUCCESS) {
+      return NULL;
     }
 
     // TODO
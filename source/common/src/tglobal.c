@@ -176,6 +176,15 @@ int32_t tsTimeSeriesThreshold = 50;
  */
 int32_t tsCompressMsgSize = -1;
 
+/*
+ * denote if the server compresses the column data of query result blocks before sending them to client or other
+ * nodes, the columns are compressed separately and decompressed only by the receiver.
+ *
+ * -1: the column data are not compressed
+ * other values: if the encoded size of a result block is greater than tsCompressColData, its columns are compressed.
+ */
+int32_t tsCompressColData = -1;
+
 // count/hyperloglog function always return values in case of all NULL data or Empty data set.
 int32_t tsCountAlwaysReturnValue = 1;
 
@@ -601,6 +610,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
     return -1;
   if (cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "compressColData", tsCompressColData, -1, 100000000, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
   if (cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
 
   tsNumOfRpcThreads = tsNumOfCores / 2;
@@ -1144,6 +1155,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsMinIntervalTime = cfgGetItem(pCfg, "minIntervalTime")->i32;
   tsCountAlwaysReturnValue = cfgGetItem(pCfg, "countAlwaysReturnValue")->i32;
   tsQueryBufferSize = cfgGetItem(pCfg, "queryBufferSize")->i32;
+  tsCompressColData = cfgGetItem(pCfg, "compressColData")->i32;
 
   tsNumOfRpcThreads = cfgGetItem(pCfg, "numOfRpcThreads")->i32;
   tsNumOfRpcSessions = cfgGetItem(pCfg, "numOfRpcSessions")->i32;
@@ -1225,11 +1225,10 @@ int32_t tSerializeSStatusReq(void *buf, int32_t bufLen, SStatusReq *pReq) {
   // vnode extra
   for (int32_t i = 0; i < vlen; ++i) {
     SVnodeLoad *pload = taosArrayGet(pReq->pVloads, i);
-    int64_t     reserved = 0;
     if (tEncodeI64(&encoder, pload->syncTerm) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->bufferUsage) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->bufferWaste) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->bufferOverflow) < 0) return -1;
   }
 
   if (tEncodeI64(&encoder, pReq->ipWhiteVer) < 0) return -1;
@@ -1338,11 +1337,10 @@ int32_t tDeserializeSStatusReq(void *buf, int32_t bufLen, SStatusReq *pReq) {
   if (!tDecodeIsEnd(&decoder)) {
     for (int32_t i = 0; i < vlen; ++i) {
       SVnodeLoad *pLoad = taosArrayGet(pReq->pVloads, i);
-      int64_t     reserved = 0;
       if (tDecodeI64(&decoder, &pLoad->syncTerm) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->bufferUsage) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->bufferWaste) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->bufferOverflow) < 0) return -1;
     }
   }
   if (!tDecodeIsEnd(&decoder)) {
@@ -8716,7 +8714,8 @@ static int32_t tEncodeSSubmitTbData(SEncoder *pCoder, const SSubmitTbData *pSubm
   return 0;
 }
 
-static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbData) {
+static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbData, SHashObj *pUidHash,
+                                    bool *skipped) {
   int32_t code = 0;
 
   if (tStartDecode(pCoder) < 0) {
@@ -8753,6 +8752,17 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
     goto _exit;
   }
 
+  // the data of the tables not required is skipped
+  if (pUidHash != NULL && taosHashGet(pUidHash, &pSubmitTbData->uid, sizeof(int64_t)) == NULL) {
+    if (pSubmitTbData->pCreateTbReq) {
+      tDestroySVCreateTbReq(pSubmitTbData->pCreateTbReq, TSDB_MSG_FLG_DECODE);
+      taosMemoryFreeClear(pSubmitTbData->pCreateTbReq);
+    }
+    *skipped = true;
+    tEndDecode(pCoder);
+    goto _exit;
+  }
+
   if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
     uint64_t nColData;
 
@@ -8820,7 +8830,9 @@ int32_t tEncodeSubmitReq(SEncoder *pCoder, const SSubmitReq2 *pReq) {
   return 0;
 }
 
-int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
+int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) { return tDecodeSubmitReqFilter(pCoder, pReq, NULL); }
+
+int32_t tDecodeSubmitReqFilter(SDecoder *pCoder, SSubmitReq2 *pReq, SHashObj *pUidHash) {
   int32_t code = 0;
 
   memset(pReq, 0, sizeof(*pReq));
@@ -8844,10 +8856,15 @@ int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
   }
 
   for (uint64_t i = 0; i < nSubmitTbData; i++) {
-    if (tDecodeSSubmitTbData(pCoder, taosArrayReserve(pReq->aSubmitTbData, 1)) < 0) {
+    SSubmitTbData submitTbData = {0};
+    bool          skipped = false;
+    if (tDecodeSSubmitTbData(pCoder, &submitTbData, pUidHash, &skipped) < 0) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
+    if (!skipped) {
+      taosArrayPush(pReq->aSubmitTbData, &submitTbData);
+    }
   }
 
   tEndDecode(pCoder);
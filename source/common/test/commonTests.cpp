@@ -302,6 +302,111 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, parallel_dataBlock_sort_test) {
+  int32_t      numOfRows = 100000;
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_DOUBLE, 8, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  blockDataEnsureCapacity(b, numOfRows);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    double  k = taosRand() % 1000;
+    int64_t v = i;
+    colDataSetVal(p0, i, (const char*)&k, false);
+    colDataSetVal(p1, i, (const char*)&v, false);
+    b->info.rows++;
+  }
+
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order = {true, TSDB_ORDER_ASC, 0, NULL};
+  taosArrayPush(pOrderInfo, &order);
+  SBlockOrderInfo order1 = {true, TSDB_ORDER_DESC, 1, NULL};
+  taosArrayPush(pOrderInfo, &order1);
+
+  SSchedQueue pool = {0};
+  ASSERT_NE(taosInitScheduler(16, 3, "sort", &pool), nullptr);
+  ASSERT_EQ(blockDataSortParallel(b, pOrderInfo, &pool, 4), 0);
+  taosCleanUpScheduler(&pool);
+  ASSERT_EQ(blockDataGetNumOfRows(b), numOfRows);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 1; i < numOfRows; ++i) {
+    double prevKey = *(double*)colDataGetData(p0, i - 1);
+    double key = *(double*)colDataGetData(p0, i);
+    ASSERT_LE(prevKey, key);
+    if (prevKey == key) {
+      ASSERT_GT(*(int64_t*)colDataGetData(p1, i - 1), *(int64_t*)colDataGetData(p1, i));
+    }
+  }
+
+  blockDataDestroy(b);
+  taosArrayDestroy(pOrderInfo);
+}
+
+TEST(testCase, radix_dataBlock_sort_test) {
+  int32_t      numOfRows = 10000;
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, 8, 2);
+  blockDataAppendColInfo(b, &infoData1);
+  blockDataEnsureCapacity(b, numOfRows);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t k = (int32_t)(taosRand() % 200) - 100;
+    int64_t ts = 1700000000000 - (int64_t)(taosRand() % 100000);
+    colDataSetVal(p0, i, (const char*)&k, (i % 7) == 0);
+    colDataSetVal(p1, i, (const char*)&ts, false);
+    b->info.rows++;
+  }
+
+  // null first, then the int column descending, then the timestamp ascending
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order = {true, TSDB_ORDER_DESC, 0, NULL};
+  taosArrayPush(pOrderInfo, &order);
+  SBlockOrderInfo order1 = {false, TSDB_ORDER_ASC, 1, NULL};
+  taosArrayPush(pOrderInfo, &order1);
+
+  ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+
+  p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  for (int32_t i = 1; i < numOfRows; ++i) {
+    bool    prevNull = colDataIsNull_f(p0->nullbitmap, i - 1);
+    bool    isNull = colDataIsNull_f(p0->nullbitmap, i);
+    int64_t prevTs = *(int64_t*)colDataGetData(p1, i - 1);
+    int64_t ts = *(int64_t*)colDataGetData(p1, i);
+    if (prevNull || isNull) {
+      ASSERT_TRUE(prevNull);
+      if (isNull) {
+        ASSERT_LE(prevTs, ts);
+      }
+      continue;
+    }
+
+    int32_t prevKey = *(int32_t*)colDataGetData(p0, i - 1);
+    int32_t key = *(int32_t*)colDataGetData(p0, i);
+    ASSERT_GE(prevKey, key);
+    if (prevKey == key) {
+      ASSERT_LE(prevTs, ts);
+    }
+  }
+
+  blockDataDestroy(b);
+  taosArrayDestroy(pOrderInfo);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
@@ -408,6 +513,70 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+TEST(testCase, compress_dataBlock_encode_test) {
+  int32_t numOfRows = 4096;
+
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 2);
+  blockDataAppendColInfo(b, &infoData1);
+
+  blockDataEnsureCapacity(b, numOfRows);
+
+  char buf[41] = {0};
+  char buf1[100] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+
+    int32_t v = i % 16;
+    colDataSetVal(p0, i, (const char*)&v, (i % 7) == 0);
+
+    sprintf(buf, "the number of row:%d", i);
+    STR_TO_VARSTR(buf1, buf)
+    colDataSetVal(p1, i, buf1, false);
+    b->info.rows++;
+  }
+
+  int32_t len = blockGetEncodeSize(b);
+  char*   pData = (char*)taosMemoryCalloc(1, len);
+  char*   pCompData = (char*)taosMemoryCalloc(1, blockGetCompressEncodeSize(b));
+  int32_t dataLen = blockEncode(b, pData, 2);
+  int32_t compLen = blockCompressEncode(b, pCompData, 2);
+  ASSERT_LT(compLen, dataLen);
+
+  // restored to the layout of blockEncode
+  char* pRes = NULL;
+  ASSERT_EQ(blockDecompressEncode(pCompData, &pRes), 0);
+  ASSERT_EQ(memcmp(pRes, pData, dataLen), 0);
+
+  SSDataBlock* pBlock = createOneDataBlock(b, false);
+  ASSERT_EQ(blockDecode(pBlock, pCompData), pCompData + compLen);
+  ASSERT_EQ(pBlock->info.rows, numOfRows);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    ASSERT_EQ(colDataIsNull_f(p0->nullbitmap, i), (i % 7) == 0);
+    if ((i % 7) != 0) {
+      ASSERT_EQ(*(int32_t*)colDataGetData(p0, i), i % 16);
+    }
+
+    sprintf(buf, "the number of row:%d", i);
+    char* p = colDataGetData(p1, i);
+    ASSERT_EQ(varDataLen(p), strlen(buf));
+    ASSERT_EQ(memcmp(varDataVal(p), buf, varDataLen(p)), 0);
+  }
+
+  taosMemoryFree(pRes);
+  taosMemoryFree(pData);
+  taosMemoryFree(pCompData);
+  blockDataDestroy(pBlock);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
@@ -530,4 +530,53 @@ for (int r = 0; r < nRows; ++r) {
   taosArrayDestroy(pArray);
   taosMemoryFree(pTSchema);
 }
-#endif
\ No newline at end of file
+#endif
+TEST(testCase, SubmitReqFilterTest) {
+  SSubmitReq2 req = {0};
+  req.aSubmitTbData = taosArrayInit(3, sizeof(SSubmitTbData));
+  for (int64_t uid = 1; uid <= 3; ++uid) {
+    SSubmitTbData tbData = {0};
+    tbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    tbData.suid = 100;
+    tbData.uid = uid;
+    tbData.sver = 1;
+    tbData.aCol = taosArrayInit(0, sizeof(SColData));
+    taosArrayPush(req.aSubmitTbData, &tbData);
+  }
+
+  int32_t  code = 0;
+  uint32_t len = 0;
+  tEncodeSize(tEncodeSubmitReq, &req, len, code);
+  ASSERT_EQ(code, 0);
+
+  void    *buf = taosMemoryMalloc(len);
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, (uint8_t *)buf, len);
+  ASSERT_EQ(tEncodeSubmitReq(&encoder, &req), 0);
+  tEncoderClear(&encoder);
+
+  SHashObj *pUidHash = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+  int64_t   uid = 2;
+  taosHashPut(pUidHash, &uid, sizeof(int64_t), NULL, 0);
+
+  // only the queried table is decoded
+  SSubmitReq2 decoded = {0};
+  SDecoder    decoder = {0};
+  tDecoderInit(&decoder, (uint8_t *)buf, len);
+  ASSERT_EQ(tDecodeSubmitReqFilter(&decoder, &decoded, pUidHash), 0);
+  tDecoderClear(&decoder);
+  ASSERT_EQ(taosArrayGetSize(decoded.aSubmitTbData), 1);
+  EXPECT_EQ(((SSubmitTbData *)taosArrayGet(decoded.aSubmitTbData, 0))->uid, 2);
+  tDestroySubmitReq(&decoded, TSDB_MSG_FLG_DECODE);
+
+  // all tables without the filter
+  tDecoderInit(&decoder, (uint8_t *)buf, len);
+  ASSERT_EQ(tDecodeSubmitReqFilter(&decoder, &decoded, NULL), 0);
+  tDecoderClear(&decoder);
+  ASSERT_EQ(taosArrayGetSize(decoded.aSubmitTbData), 3);
+  tDestroySubmitReq(&decoded, TSDB_MSG_FLG_DECODE);
+
+  taosHashCleanup(pUidHash);
+  taosMemoryFree(buf);
+  tDestroySubmitReq(&req, TSDB_MSG_FLG_ENCODE);
+}
@@ -140,6 +140,20 @@ static void vmProcessFetchQueue(SQueueInfo *pInfo, STaosQall *qall, int32_t numO
   }
 }
 
+// Query heartbeats and metadata reads are put into the high priority lane of the fetch queue, so that they are not
+// stuck behind fetches which may have to run a large part of the query. Messages of query tasks keep their order.
+static EQItemPri vmGetFetchMsgPriority(tmsg_t msgType) {
+  switch (msgType) {
+    case TDMT_SCH_QUERY_HEARTBEAT:
+    case TDMT_VND_TABLE_META:
+    case TDMT_VND_TABLE_CFG:
+    case TDMT_VND_BATCH_META:
+      return QITEM_PRI_HIGH;
+    default:
+      return QITEM_PRI_NORMAL;
+  }
+}
+
 static void vmProcessSyncQueue(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfMsgs) {
   SVnodeObj *pVnode = pInfo->ahandle;
   SRpcMsg   *pMsg = NULL;
@@ -210,7 +224,7 @@ static int32_t vmPutMsgToQueue(SVnodeMgmt *pMgmt, SRpcMsg *pMsg, EQueueType qtyp
       break;
     case FETCH_QUEUE:
       dGTrace("vgId:%d, msg:%p put into vnode-fetch queue", pVnode->vgId, pMsg);
-      taosWriteQitem(pVnode->pFetchQ, pMsg);
+      taosWriteQitemWithPriority(pVnode->pFetchQ, pMsg, vmGetFetchMsgPriority(pMsg->msgType));
       break;
     case WRITE_QUEUE:
       if (!vmDataSpaceSufficient(pVnode)) {
@@ -16,6 +16,7 @@
 #define _DEFAULT_SOURCE
 #include "dmMgmt.h"
 #include "dmNodes.h"
+#include "executor.h"
 #include "index.h"
 #include "qworker.h"
 #include "tstream.h"
@@ -86,6 +87,7 @@ int32_t dmInitDnode(SDnode *pDnode) {
 
   indexInit(tsNumOfCommitThreads);
   streamMetaInit();
+  qInitSortPool();
 
   dmInitStatusClient(pDnode);
   dmInitSyncClient(pDnode);  
@@ -117,6 +119,7 @@ void dmCleanupDnode(SDnode *pDnode) {
   dmClearVars(pDnode);
   rpcCleanup();
   streamMetaCleanup();
+  qCleanupSortPool();
   indexCleanup();
   taosConvDestroy();
 
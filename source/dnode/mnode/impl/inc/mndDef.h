@@ -370,6 +370,9 @@ typedef struct {
   int64_t    startTimeMs;
   ESyncRole  nodeRole;
   int32_t    learnerProgress;
+  int64_t    bufferUsage;
+  int64_t    bufferWaste;
+  int64_t    bufferOverflow;
 } SVnodeGid;
 
 typedef struct {
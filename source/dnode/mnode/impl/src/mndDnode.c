@@ -796,6 +796,9 @@ static int32_t mndProcessStatusReq(SRpcMsg *pReq) {
             pVload->roleTimeMs = statusReq.rebootTime;
           }
           stateChanged = mndUpdateVnodeState(pVgroup->vgId, pGid, pVload);
+          pGid->bufferUsage = pVload->bufferUsage;
+          pGid->bufferWaste = pVload->bufferWaste;
+          pGid->bufferOverflow = pVload->bufferOverflow;
           break;
         }
       }
@@ -231,6 +231,9 @@ static int32_t mndVgroupActionUpdate(SSdb *pSdb, SVgObj *pOld, SVgObj *pNew) {
         pNewGid->syncState = pOldGid->syncState;
         pNewGid->syncRestore = pOldGid->syncRestore;
         pNewGid->syncCanRead = pOldGid->syncCanRead;
+        pNewGid->bufferUsage = pOldGid->bufferUsage;
+        pNewGid->bufferWaste = pOldGid->bufferWaste;
+        pNewGid->bufferOverflow = pOldGid->bufferOverflow;
       }
     }
   }
@@ -1155,6 +1158,15 @@ static int32_t mndRetrieveVnodes(SRpcMsg *pReq, SShowObj *pShow, SSDataBlock *pB
       pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
       colDataSetVal(pColInfo, numOfRows, (const char *)&pGid->syncRestore, false);
 
+      pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+      colDataSetVal(pColInfo, numOfRows, (const char *)&pGid->bufferUsage, !isDnodeOnline);
+
+      pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+      colDataSetVal(pColInfo, numOfRows, (const char *)&pGid->bufferWaste, !isDnodeOnline);
+
+      pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+      colDataSetVal(pColInfo, numOfRows, (const char *)&pGid->bufferOverflow, !isDnodeOnline);
+
       numOfRows++;
       sdbRelease(pSdb, pDnode);
     }
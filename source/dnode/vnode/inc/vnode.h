@@ -194,12 +194,17 @@ typedef struct SIdInfo {
   int32_t index;
 } SIdInfo;
 
+typedef struct STqSubmitCache STqSubmitCache;
+
 typedef struct STqReader {
   SPackedData     msg;
   SSubmitReq2     submit;
+  LRUHandle      *pSubmitHandle;  // the decoded submit is shared with the other readers if not NULL
+  STqSubmitCache *pSubmitCache;
   int32_t         nextBlk;
   int64_t         lastBlkUid;
   SWalReader     *pWalReader;
+  SVnode         *pVnode;
   SMeta          *pVnodeMeta;
   SHashObj       *tbIdHash;
   SArray         *pColIdList;  // SArray<int16_t>
@@ -106,12 +106,22 @@ struct STQ {
   TTB*            pExecStore;
   TTB*            pCheckStore;
   SStreamMeta*    pStreamMeta;
+  STqSubmitCache* pSubmitCache;  // decoded submit messages shared by the readers
 };
 
 int32_t tEncodeSTqHandle(SEncoder* pEncoder, const STqHandle* pHandle);
 int32_t tDecodeSTqHandle(SDecoder* pDecoder, STqHandle* pHandle);
 void    tqDestroyTqHandle(void* data);
 
+// tqSubmitCache
+STqSubmitCache* tqSubmitCacheOpen();
+void            tqSubmitCacheClose(STqSubmitCache* pCache);
+void            tqSubmitCacheAddReader(STqSubmitCache* pCache);
+void            tqSubmitCacheRemoveReader(STqSubmitCache* pCache);
+LRUHandle*      tqSubmitCacheAcquire(STqSubmitCache* pCache, void* msgStr, int32_t msgLen, int64_t ver);
+SSubmitReq2*    tqSubmitCacheGetReq(STqSubmitCache* pCache, LRUHandle* h);
+void            tqSubmitCacheRelease(STqSubmitCache* pCache, LRUHandle* h);
+
 // tqRead
 int32_t tqScanTaosx(STQ* pTq, const STqHandle* pHandle, STaosxRsp* pRsp, SMqMetaRsp* pMetaRsp, STqOffsetVal* offset);
 int32_t tqScanData(STQ* pTq, STqHandle* pHandle, SMqDataRsp* pRsp, STqOffsetVal* pOffset, const SMqPollReq* pRequest);
@@ -642,6 +642,9 @@ typedef struct {
   int32_t     fid;
   int64_t     cid;
   int64_t     blkno;
+
+  TdAIOPtr                pAio;       // the ring shared by the files of a reader, no read ahead if NULL
+  struct STsdbFDPrefetch *pPrefetch;  // pages read ahead asynchronously
 } STsdbFD;
 
 struct SDelFWriter {
@@ -867,6 +870,7 @@ typedef struct {
   void         *pReader;
   void         *idstr;
   bool          rspRows;  // response the rows in stt-file, if possible
+  TdAIOPtr      pAio;     // the ring to read stt blocks ahead, NULL if not
 } SMergeTreeConf;
 
 typedef struct SSttDataInfoForTable {
@@ -99,6 +99,8 @@ struct SVBufPool {
   volatile int32_t  nRef;
   TdThreadSpinlock* lock;
   int64_t           size;
+  int64_t           waste;     // alignment padding and node headers
+  int64_t           overflow;  // bytes allocated out of the anchor node
   uint8_t*          ptr;
   SVBufPoolNode*    pTail;
   SVBufPoolNode     node;
@@ -109,6 +111,7 @@ int32_t vnodeCloseBufPool(SVnode* pVnode);
 void    vnodeBufPoolReset(SVBufPool* pPool);
 void    vnodeBufPoolAddToFreeList(SVBufPool* pPool);
 int32_t vnodeBufPoolRecycle(SVBufPool* pPool);
+void    vnodeGetBufPoolStat(SVnode* pVnode, int64_t* used, int64_t* waste, int64_t* overflow);
 
 // vnodeOpen.c
 int32_t vnodeGetPrimaryDir(const char* relPath, int32_t diskPrimary, STfs* pTfs, char* buf, size_t bufLen);
@@ -76,6 +76,12 @@ STQ* tqOpen(const char* path, SVnode* pVnode) {
   pTq->pCheckInfo = taosHashInit(64, MurmurHash3_32, true, HASH_ENTRY_LOCK);
   taosHashSetFreeFp(pTq->pCheckInfo, (FDelete)tDeleteSTqCheckInfo);
 
+  pTq->pSubmitCache = tqSubmitCacheOpen();
+  if (pTq->pSubmitCache == NULL) {
+    tqClose(pTq);
+    return NULL;
+  }
+
   int32_t code = tqInitialize(pTq);
   if (code != TSDB_CODE_SUCCESS) {
     tqClose(pTq);
@@ -135,6 +141,7 @@ void tqClose(STQ* pTq) {
   taosMemoryFree(pTq->path);
   tqMetaClose(pTq);
   streamMetaClose(pTq->pStreamMeta);
+  tqSubmitCacheClose(pTq->pSubmitCache);
 
   qDebug("end to close tq");
   taosMemoryFree(pTq);
@@ -825,7 +832,7 @@ int32_t tqExpandTask(STQ* pTq, SStreamTask* pTask, int64_t nextProcessVer) {
 
   if (pTask->info.taskLevel == TASK_LEVEL__SOURCE) {
     SWalFilterCond cond = {.deleteMsg = 1};  // delete msg also extract from wal files
-    pTask->exec.pWalReader = walOpenReader(pTq->pVnode->pWal, &cond, pTask->id.taskId);
+    pTask->exec.pWalReader = walOpenReader(pTq->pVnode->pWal, &cond, pTask->id.taskId, true);
   }
 
   streamTaskResetUpstreamStageInfo(pTask);
@@ -247,18 +247,32 @@ END:
   return code;
 }
 
+// the submit messages older than this, or not committed yet, are decoded by the reader itself
+#define TQ_SUBMIT_CACHE_VERSIONS 64
+
+static void tqReaderClearSubmit(STqReader* pReader) {
+  if (pReader->pSubmitHandle != NULL) {
+    tqSubmitCacheRelease(pReader->pSubmitCache, pReader->pSubmitHandle);
+    pReader->pSubmitHandle = NULL;
+    memset(&pReader->submit, 0, sizeof(SSubmitReq2));
+  } else {
+    tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_DECODE);
+  }
+}
+
 STqReader* tqReaderOpen(SVnode* pVnode) {
   STqReader* pReader = taosMemoryCalloc(1, sizeof(STqReader));
   if (pReader == NULL) {
     return NULL;
   }
 
-  pReader->pWalReader = walOpenReader(pVnode->pWal, NULL, 0);
+  pReader->pWalReader = walOpenReader(pVnode->pWal, NULL, 0, true);
   if (pReader->pWalReader == NULL) {
     taosMemoryFree(pReader);
     return NULL;
   }
 
+  pReader->pVnode = pVnode;
   pReader->pVnodeMeta = pVnode->pMeta;
   pReader->pColIdList = NULL;
   pReader->cachedSchemaVer = 0;
@@ -288,7 +302,10 @@ void tqReaderClose(STqReader* pReader) {
   // free hash
   blockDataDestroy(pReader->pResBlock);
   taosHashCleanup(pReader->tbIdHash);
-  tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_DECODE);
+  tqReaderClearSubmit(pReader);
+  if (pReader->pSubmitCache != NULL) {
+    tqSubmitCacheRemoveReader(pReader->pSubmitCache);
+  }
   taosMemoryFree(pReader);
 }
 
@@ -412,7 +429,7 @@ bool tqNextBlockInWal(STqReader* pReader, const char* id, int sourceExcluded) {
         tqTrace("tq reader discard submit block, uid:%" PRId64 ", continue", pSubmitTbData->uid);
       }
     }
-    tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_DECODE);
+    tqReaderClearSubmit(pReader);
     pReader->msg.msgStr = NULL;
 
     if (pDataBlock != NULL) {
@@ -436,10 +453,31 @@ int32_t tqReaderSetSubmitMsg(STqReader* pReader, void* msgStr, int32_t msgLen, i
   pReader->msg.ver = ver;
 
   tqDebug("tq reader set msg %p %d", msgStr, msgLen);
+
+  // the cache is created after the readers of the stream tasks loaded along with the tq
+  STQ* pTq = pReader->pVnode->pTq;
+  if (pReader->pSubmitCache == NULL && pTq != NULL && pTq->pSubmitCache != NULL) {
+    pReader->pSubmitCache = pTq->pSubmitCache;
+    tqSubmitCacheAddReader(pReader->pSubmitCache);
+  }
+
+  tqReaderClearSubmit(pReader);
+
+  // an uncommitted message may be rolled back and replaced by another one of the same version
+  int64_t commitVer = walGetCommittedVer(pReader->pWalReader->pWal);
+  if (pReader->pSubmitCache != NULL && ver <= commitVer && ver > commitVer - TQ_SUBMIT_CACHE_VERSIONS) {
+    pReader->pSubmitHandle = tqSubmitCacheAcquire(pReader->pSubmitCache, msgStr, msgLen, ver);
+    if (pReader->pSubmitHandle != NULL) {
+      pReader->submit = *tqSubmitCacheGetReq(pReader->pSubmitCache, pReader->pSubmitHandle);
+      return 0;
+    }
+  }
+
   SDecoder decoder;
 
+  // the tables not queried are skipped while decoding
   tDecoderInit(&decoder, pReader->msg.msgStr, pReader->msg.msgLen);
-  if (tDecodeSubmitReq(&decoder, &pReader->submit) < 0) {
+  if (tDecodeSubmitReqFilter(&decoder, &pReader->submit, pReader->tbIdHash) < 0) {
     tDecoderClear(&decoder);
     tqError("DecodeSSubmitReq2 error, msgLen:%d, ver:%" PRId64, msgLen, ver);
     return -1;
@@ -482,7 +520,7 @@ bool tqNextBlockImpl(STqReader* pReader, const char* idstr) {
     pReader->nextBlk++;
   }
 
-  tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_DECODE);
+  tqReaderClearSubmit(pReader);
   pReader->nextBlk = 0;
   pReader->msg.msgStr = NULL;
 
@@ -504,7 +542,7 @@ bool tqNextDataBlockFilterOut(STqReader* pReader, SHashObj* filterOutUids) {
     pReader->nextBlk++;
   }
 
-  tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_DECODE);
+  tqReaderClearSubmit(pReader);
   pReader->nextBlk = 0;
   pReader->msg.msgStr = NULL;
 
@@ -715,38 +753,48 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
     SArray*         pRows = pSubmitTbData->aRowP;
     SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
     STSchema*       pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+    int32_t*        pSchemaIdx = taosMemoryMalloc(sizeof(int32_t) * (colActual + 1));
+    if (pTSchema == NULL || pSchemaIdx == NULL) {
+      taosMemoryFree(pTSchema);
+      taosMemoryFree(pSchemaIdx);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
 
-    for (int32_t i = 0; i < numOfRows; i++) {
-      SRow*   pRow = taosArrayGetP(pRows, i);
-      int32_t sourceIdx = 0;
+    // the index in the row of each required column, or -1 if not in the row, so the others are not decoded
+    int32_t sourceIdx = 0;
+    for (int32_t j = 0; j < colActual; j++) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
+      while (sourceIdx < pTSchema->numOfCols && pTSchema->columns[sourceIdx].colId < pColData->info.colId) {
+        sourceIdx++;
+      }
+      pSchemaIdx[j] = -1;
+      if (sourceIdx < pTSchema->numOfCols && pTSchema->columns[sourceIdx].colId == pColData->info.colId) {
+        pSchemaIdx[j] = sourceIdx++;
+      }
+    }
 
-      for (int32_t j = 0; j < colActual; j++) {
-        SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
-        while (1) {
-          SColVal colVal;
-          tRowGet(pRow, pTSchema, sourceIdx, &colVal);
-          if (colVal.cid < pColData->info.colId) {
-            //            tqDebug("colIndex:%d column id:%d in row, ignore, the required colId:%d, total cols in
-            //            schema:%d",
-            //                    sourceIdx, colVal.cid, pColData->info.colId, pTSchema->numOfCols);
-            sourceIdx++;
-            continue;
-          } else if (colVal.cid == pColData->info.colId) {
-            int32_t code = doSetVal(pColData, i, &colVal);
-            if (code != TSDB_CODE_SUCCESS) {
-              return code;
-            }
-
-            sourceIdx++;
-            break;
-          } else {
-            colDataSetNULL(pColData, i);
-            break;
-          }
+    for (int32_t j = 0; j < colActual; j++) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
+      if (pSchemaIdx[j] < 0) {
+        colDataSetNNULL(pColData, 0, numOfRows);
+        continue;
+      }
+
+      for (int32_t i = 0; i < numOfRows; i++) {
+        SRow*   pRow = taosArrayGetP(pRows, i);
+        SColVal colVal;
+        tRowGet(pRow, pTSchema, pSchemaIdx[j], &colVal);
+        int32_t code = doSetVal(pColData, i, &colVal);
+        if (code != TSDB_CODE_SUCCESS) {
+          taosMemoryFree(pTSchema);
+          taosMemoryFree(pSchemaIdx);
+          return code;
         }
       }
     }
 
+    taosMemoryFree(pSchemaIdx);
     taosMemoryFreeClear(pTSchema);
   }
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tlrucache.h"
+#include "tmsg.h"
+#include "tq.h"
+
+// decoded submit messages keyed by version, the first tq reader decoding a message shares it with the later ones
+#define TQ_SUBMIT_CACHE_SIZE      (8 * 1024 * 1024)
+#define TQ_SUBMIT_CACHE_MAX_ENTRY (1024 * 1024)
+
+struct STqSubmitCache {
+  SLRUCache* pCache;
+  int32_t    ref;  // held by the tq and the readers, which may be closed after the tq
+  int32_t    numOfReaders;
+};
+
+typedef struct {
+  int32_t     msgLen;
+  void*       msgStr;  // the decoded message refers to this copy
+  SSubmitReq2 submit;
+} STqSubmitEntry;
+
+static void tqSubmitEntryFree(STqSubmitEntry* pEntry) {
+  tDestroySubmitReq(&pEntry->submit, TSDB_MSG_FLG_DECODE);
+  taosMemoryFree(pEntry->msgStr);
+  taosMemoryFree(pEntry);
+}
+
+static void tqSubmitCacheDeleter(const void* key, size_t keyLen, void* value, void* ud) { tqSubmitEntryFree(value); }
+
+STqSubmitCache* tqSubmitCacheOpen() {
+  STqSubmitCache* pCache = taosMemoryCalloc(1, sizeof(STqSubmitCache));
+  if (pCache == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pCache->pCache = taosLRUCacheInit(TQ_SUBMIT_CACHE_SIZE, 0, .5);
+  if (pCache->pCache == NULL) {
+    taosMemoryFree(pCache);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pCache->ref = 1;
+  return pCache;
+}
+
+static void tqSubmitCacheUnref(STqSubmitCache* pCache) {
+  if (atomic_sub_fetch_32(&pCache->ref, 1) > 0) {
+    return;
+  }
+
+  taosLRUCacheEraseUnrefEntries(pCache->pCache);
+  taosLRUCacheCleanup(pCache->pCache);
+  taosMemoryFree(pCache);
+}
+
+void tqSubmitCacheClose(STqSubmitCache* pCache) {
+  if (pCache != NULL) {
+    tqSubmitCacheUnref(pCache);
+  }
+}
+
+void tqSubmitCacheAddReader(STqSubmitCache* pCache) {
+  atomic_add_fetch_32(&pCache->ref, 1);
+  atomic_add_fetch_32(&pCache->numOfReaders, 1);
+}
+
+void tqSubmitCacheRemoveReader(STqSubmitCache* pCache) {
+  if (atomic_sub_fetch_32(&pCache->numOfReaders, 1) < 2) {
+    taosLRUCacheEraseUnrefEntries(pCache->pCache);
+  }
+  tqSubmitCacheUnref(pCache);
+}
+
+// a handle of the decoded message, or NULL if the reader should decode it on its own
+LRUHandle* tqSubmitCacheAcquire(STqSubmitCache* pCache, void* msgStr, int32_t msgLen, int64_t ver) {
+  if (atomic_load_32(&pCache->numOfReaders) < 2 || ver < 0 || msgLen > TQ_SUBMIT_CACHE_MAX_ENTRY) {
+    return NULL;
+  }
+
+  LRUHandle* h = taosLRUCacheLookup(pCache->pCache, &ver, sizeof(ver));
+  if (h != NULL) {
+    STqSubmitEntry* pEntry = taosLRUCacheValue(pCache->pCache, h);
+    if (pEntry->msgLen == msgLen) {
+      return h;
+    }
+    taosLRUCacheRelease(pCache->pCache, h, false);
+    return NULL;
+  }
+
+  STqSubmitEntry* pEntry = taosMemoryCalloc(1, sizeof(STqSubmitEntry));
+  if (pEntry == NULL) {
+    return NULL;
+  }
+
+  pEntry->msgStr = taosMemoryMalloc(msgLen);
+  if (pEntry->msgStr == NULL) {
+    taosMemoryFree(pEntry);
+    return NULL;
+  }
+
+  memcpy(pEntry->msgStr, msgStr, msgLen);
+  pEntry->msgLen = msgLen;
+
+  SDecoder decoder;
+  tDecoderInit(&decoder, pEntry->msgStr, msgLen);
+  int32_t code = tDecodeSubmitReq(&decoder, &pEntry->submit);
+  tDecoderClear(&decoder);
+  if (code < 0) {
+    tqSubmitEntryFree(pEntry);
+    return NULL;
+  }
+
+  // one decoded by another reader in the meantime is overwritten, and freed once released
+  (void)taosLRUCacheInsert(pCache->pCache, &ver, sizeof(ver), pEntry, msgLen, tqSubmitCacheDeleter, &h,
+                           TAOS_LRU_PRIORITY_LOW, NULL);
+  return h;
+}
+
+SSubmitReq2* tqSubmitCacheGetReq(STqSubmitCache* pCache, LRUHandle* h) {
+  STqSubmitEntry* pEntry = taosLRUCacheValue(pCache->pCache, h);
+  return &pEntry->submit;
+}
+
+void tqSubmitCacheRelease(STqSubmitCache* pCache, LRUHandle* h) { taosLRUCacheRelease(pCache->pCache, h, false); }
@@ -527,7 +527,7 @@ int32_t tqGetStreamExecInfo(SVnode* pVnode, int64_t streamId, int64_t* pDelay, b
     SVersionRange verRange = {0};
     walReaderValidVersionRange(pTask->exec.pWalReader, &verRange.minVer, &verRange.maxVer);
 
-    SWalReader* pReader = walOpenReader(pTask->exec.pWalReader->pWal, NULL, 0);
+    SWalReader* pReader = walOpenReader(pTask->exec.pWalReader->pWal, NULL, 0, false);
     if (pReader == NULL) {
       tqError("failed to open wal reader to extract exec progress, vgId:%d", pMeta->vgId);
       continue;
@@ -112,6 +112,8 @@ int32_t tsdbDataFileReaderOpen(const char *fname[], const SDataFileReaderConfig
     }
   }
 
+  tsdbDataFileReaderSetAio(reader[0], config->pAio);
+
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(config->tsdb->pVnode), lino, code);
@@ -394,6 +396,21 @@ _exit:
   return code;
 }
 
+// read the block data ahead asynchronously, a following load of the block takes it without waiting for the disk
+int32_t tsdbDataFilePrefetchBlockData(SDataFileReader *reader, const SBrinRecord *record) {
+  if (reader->fd[TSDB_FTYPE_DATA] == NULL) {
+    return 0;
+  }
+  return tsdbPrefetchFile(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockSize);
+}
+
+// only the blocks of the data file are read ahead
+void tsdbDataFileReaderSetAio(SDataFileReader *reader, TdAIOPtr pAio) {
+  if (reader->fd[TSDB_FTYPE_DATA]) {
+    reader->fd[TSDB_FTYPE_DATA]->pAio = pAio;
+  }
+}
+
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray) {
   int32_t code = 0;
@@ -49,6 +49,7 @@ typedef struct SDataFileReaderConfig {
     STFile file;
   } files[TSDB_FTYPE_MAX];
   uint8_t **bufArr;
+  TdAIOPtr  pAio;  // the ring to read blocks ahead, NULL if not
 } SDataFileReaderConfig;
 
 int32_t tsdbDataFileReaderOpen(const char *fname[/* TSDB_FTYPE_MAX */], const SDataFileReaderConfig *config,
@@ -61,6 +62,8 @@ int32_t tsdbDataFileReadBrinBlock(SDataFileReader *reader, const SBrinBlk *brinB
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData);
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid);
+int32_t tsdbDataFilePrefetchBlockData(SDataFileReader *reader, const SBrinRecord *record);
+void    tsdbDataFileReaderSetAio(SDataFileReader *reader, TdAIOPtr pAio);
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
@@ -28,10 +28,14 @@
 #define SL_SET_NODE_FORWARD(n, l, p)  atomic_store_ptr(&SL_NODE_FORWARD(n, l), p)
 #define SL_SET_NODE_BACKWARD(n, l, p) atomic_store_ptr(&SL_NODE_BACKWARD(n, l), p)
 
+// the node of the next row in the nodes allocated by tbDataAllocColNodes
+#define SL_NEXT_COL_NODE(n) ((SMemSkipListNode *)POINTER_SHIFT(n, SL_NODE_SIZE((n)->level)))
+
 #define SL_MOVE_BACKWARD 0x1
 #define SL_MOVE_FROM_POS 0x2
 
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *pKey, int32_t flags);
+static bool    tbDataMovePosToTail(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *pKey);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
@@ -299,21 +303,7 @@ bool tsdbTbDataIterNext(STbDataIter *pIter) {
   return true;
 }
 
-int64_t tsdbCountTbDataRows(STbData *pTbData) {
-  SMemSkipListNode *pNode = pTbData->sl.pHead;
-  int64_t           rowsNum = 0;
-
-  while (NULL != pNode) {
-    pNode = SL_GET_NODE_FORWARD(pNode, 0);
-    if (pNode == pTbData->sl.pTail) {
-      return rowsNum;
-    }
-
-    rowsNum++;
-  }
-
-  return rowsNum;
-}
+int64_t tsdbCountTbDataRows(STbData *pTbData) { return atomic_load_64(&pTbData->sl.size); }
 
 void tsdbMemTableCountRows(SMemTable *pMemTable, SSHashObj *pTableMap, int64_t *rowsNum) {
   taosRLockLatch(&pMemTable->latch);
@@ -433,6 +423,39 @@ _err:
   return code;
 }
 
+static FORCE_INLINE void tbDataGetNodeKey(SMemSkipListNode *pNode, TSDBKEY *pKey) {
+  if (pNode->flag == TSDBROW_ROW_FMT) {
+    pKey->version = pNode->version;
+    pKey->ts = ((SRow *)pNode->pData)->ts;
+  } else if (pNode->flag == TSDBROW_COL_FMT) {
+    pKey->version = ((SBlockData *)pNode->pData)->aVersion[pNode->iRow];
+    pKey->ts = ((SBlockData *)pNode->pData)->aTSKEY[pNode->iRow];
+  }
+}
+
+/*
+ * Fast path for in-order writes: if pKey is greater than the last key in the skiplist, the predecessors of the
+ * insert position at every level are just the backward pointers of the tail, so no search is needed and the row can
+ * be appended with a forward put in O(1). Returns false if the key is not an append.
+ */
+static bool tbDataMovePosToTail(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *pKey) {
+  SMemSkipListNode *pLast = SL_NODE_BACKWARD(pTbData->sl.pTail, 0);
+  TSDBKEY           tKey = {0};
+
+  if (pLast != pTbData->sl.pHead) {
+    tbDataGetNodeKey(pLast, &tKey);
+    if (tsdbKeyCmprFn(&tKey, pKey) >= 0) {
+      return false;
+    }
+  }
+
+  for (int8_t iLevel = 0; iLevel < pTbData->sl.maxLevel; iLevel++) {
+    pos[iLevel] = SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel);
+  }
+
+  return true;
+}
+
 static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *pKey, int32_t flags) {
   SMemSkipListNode *px;
   SMemSkipListNode *pn;
@@ -455,13 +478,7 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
       for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
         pn = SL_GET_NODE_BACKWARD(px, iLevel);
         while (pn != pTbData->sl.pHead) {
-          if (pn->flag == TSDBROW_ROW_FMT) {
-            tKey.version = pn->version;
-            tKey.ts = ((SRow *)pn->pData)->ts;
-          } else if (pn->flag == TSDBROW_COL_FMT) {
-            tKey.version = ((SBlockData *)pn->pData)->aVersion[pn->iRow];
-            tKey.ts = ((SBlockData *)pn->pData)->aTSKEY[pn->iRow];
-          }
+          tbDataGetNodeKey(pn, &tKey);
 
           int32_t c = tsdbKeyCmprFn(&tKey, pKey);
           if (c <= 0) {
@@ -490,13 +507,7 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
       for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
         pn = SL_GET_NODE_FORWARD(px, iLevel);
         while (pn != pTbData->sl.pTail) {
-          if (pn->flag == TSDBROW_ROW_FMT) {
-            tKey.version = pn->version;
-            tKey.ts = ((SRow *)pn->pData)->ts;
-          } else if (pn->flag == TSDBROW_COL_FMT) {
-            tKey.version = ((SBlockData *)pn->pData)->aVersion[pn->iRow];
-            tKey.ts = ((SBlockData *)pn->pData)->aTSKEY[pn->iRow];
-          }
+          tbDataGetNodeKey(pn, &tKey);
 
           int32_t c = tsdbKeyCmprFn(&tKey, pKey);
           if (c >= 0) {
@@ -513,9 +524,9 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
   }
 }
 
-static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
+static FORCE_INLINE int8_t tsdbMemSkipListRandLevelImpl(SMemSkipList *pSl, int8_t curLevel) {
   int8_t level = 1;
-  int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
+  int8_t tlevel = TMIN(pSl->maxLevel, curLevel + 1);
 
   while ((taosRandR(&pSl->seed) & 0x3) == 0 && level < tlevel) {
     level++;
@@ -523,13 +534,66 @@ static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
 
   return level;
 }
+
+static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
+  return tsdbMemSkipListRandLevelImpl(pSl, pSl->level);
+}
+
+/*
+ * Allocate the skiplist nodes of all rows in a column block with one buffer pool allocation. Node levels are drawn
+ * exactly as they would be on a row-by-row put: the first pass sums up the node sizes, and the second one draws the
+ * same levels again from the saved seed while it fills the nodes. The nodes are laid out contiguously in row order so
+ * that in-order batches are also scanned sequentially in memory, and the node of a row follows the one of the row
+ * before it (SL_NEXT_COL_NODE).
+ */
+static int32_t tbDataAllocColNodes(SVBufPool *pPool, STbData *pTbData, SBlockData *pBlockData,
+                                   SMemSkipListNode **ppNode) {
+  uint32_t seed = pTbData->sl.seed;
+  int8_t   level = pTbData->sl.level;
+  int64_t  size = 0;
+
+  for (int32_t iRow = 0; iRow < pBlockData->nRow; iRow++) {
+    int8_t nodeLevel = tsdbMemSkipListRandLevelImpl(&pTbData->sl, level);
+    level = TMAX(level, nodeLevel);
+    size += SL_NODE_SIZE(nodeLevel);
+  }
+
+  uint8_t *pBuf = (uint8_t *)vnodeBufPoolMallocAligned(pPool, size);
+  if (pBuf == NULL) {
+    *ppNode = NULL;
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  *ppNode = (SMemSkipListNode *)pBuf;
+
+  pTbData->sl.seed = seed;
+  level = pTbData->sl.level;
+  for (int32_t iRow = 0; iRow < pBlockData->nRow; iRow++) {
+    SMemSkipListNode *pNode = (SMemSkipListNode *)pBuf;
+
+    pNode->level = tsdbMemSkipListRandLevelImpl(&pTbData->sl, level);
+    pNode->flag = TSDBROW_COL_FMT;
+    pNode->iRow = iRow;
+    pNode->pData = pBlockData;
+    level = TMAX(level, pNode->level);
+
+    pBuf += SL_NODE_SIZE(pNode->level);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
-                           int8_t forward) {
-  int32_t           code = 0;
-  int8_t            level;
-  SMemSkipListNode *pNode = NULL;
-  SVBufPool        *pPool = pMemTable->pTsdb->pVnode->inUse;
-  int64_t           nSize;
+                           int8_t forward, SMemSkipListNode *pNode) {
+  int32_t    code = 0;
+  int8_t     level;
+  SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
+  int64_t    nSize;
+
+  if (pNode) {
+    // node is pre-allocated and initialized, only link it
+    level = pNode->level;
+    goto _link;
+  }
 
   // create node
   level = tsdbMemSkipListRandLevel(&pTbData->sl);
@@ -559,6 +623,7 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
     ASSERT(0);
   }
 
+_link:
   // set node
   if (forward) {
     for (int8_t iLevel = 0; iLevel < level; iLevel++) {
@@ -593,7 +658,8 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
     }
   }
 
-  pTbData->sl.size++;
+  // readers may count rows concurrently without the latch
+  atomic_add_fetch_64(&pTbData->sl.size, 1);
   if (pTbData->sl.level < pNode->level) {
     pTbData->sl.level = pNode->level;
   }
@@ -604,7 +670,8 @@ _exit:
 
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
-  int32_t code = 0;
+  int32_t           code = 0;
+  SMemSkipListNode *pNode = NULL;
 
   SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
   int32_t    nColData = TARRAY_SIZE(pSubmitTbData->aCol);
@@ -653,6 +720,9 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
+  code = tbDataAllocColNodes(pPool, pTbData, pBlockData, &pNode);
+  if (code) goto _exit;
+
   // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
@@ -660,16 +730,21 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   TSDBROW           lRow;  // last row
 
   // first row
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
+  bool append = tbDataMovePosToTail(pTbData, pos, &key);
+  if (!append) {
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+  }
+  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, append, pNode))) goto _exit;
   pTbData->minKey = TMIN(pTbData->minKey, key.ts);
   lRow = tRow;
 
   // remain row
   ++tRow.iRow;
   if (tRow.iRow < pBlockData->nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+    if (!append) {
+      for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+      }
     }
 
     while (tRow.iRow < pBlockData->nRow) {
@@ -679,7 +754,8 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+      pNode = SL_NEXT_COL_NODE(pNode);
+      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, pNode))) goto _exit;
       lRow = tRow;
 
       ++tRow.iRow;
@@ -717,11 +793,14 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   int32_t           iRow = 0;
   TSDBROW           lRow;
 
-  // backward put first data
+  // put first data, append at tail if in order, otherwise backward put
   tRow.pTSRow = aRow[iRow++];
   key.ts = tRow.pTSRow->ts;
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+  bool append = tbDataMovePosToTail(pTbData, pos, &key);
+  if (!append) {
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+  }
+  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, append, NULL);
   if (code) goto _exit;
   lRow = tRow;
 
@@ -729,8 +808,10 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
 
   // forward put rest data
   if (iRow < nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+    if (!append) {
+      for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+      }
     }
 
     while (iRow < nRow) {
@@ -741,7 +822,7 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
+      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, NULL);
       if (code) goto _exit;
 
       lRow = tRow;
@@ -768,7 +849,7 @@ _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return atomic_load_64(&pTbData->sl.size); }
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
@@ -155,6 +155,15 @@ static SBlockData *loadLastBlock(SLDataIter *pIter, const char *idStr) {
   updateBlockLoadSlot(pInfo);
   int64_t st = taosGetTimestampUs();
 
+  // read the next stt block ahead, it is likely to be loaded for the same table or the next one in uid order
+  int32_t next = pIter->iSttBlk + (pIter->backward ? -1 : 1);
+  if (next >= 0 && next < taosArrayGetSize(pInfo->aSttBlk)) {
+    SSttBlk *p = taosArrayGet(pInfo->aSttBlk, next);
+    if (p->minKey <= pIter->timeWindow.ekey && p->maxKey >= pIter->timeWindow.skey) {
+      tsdbSttFilePrefetchBlockData(pIter->pReader, p);
+    }
+  }
+
   SBlockData *pBlock = &pInfo->blockData[pInfo->currentLoadBlockIndex].data;
   code = tsdbSttFileReadBlockDataByColumn(pIter->pReader, pIter->pSttBlk, pBlock, pInfo->pSchema, &pInfo->colIds[1],
                                           pInfo->numOfCols - 1);
@@ -776,7 +785,8 @@ int32_t tMergeTreeOpen2(SMergeTree *pMTree, SMergeTreeConf *pConf, SSttDataInfoF
       // open stt file reader if not opened yet
       // if failed to open this stt file, ignore the error and try next one
       if (pSttFileReader == NULL) {
-        SSttFileReaderConfig conf = {.tsdb = pConf->pTsdb, .szPage = pConf->pTsdb->pVnode->config.tsdbPageSize};
+        SSttFileReaderConfig conf = {
+            .tsdb = pConf->pTsdb, .szPage = pConf->pTsdb->pVnode->config.tsdbPageSize, .pAio = pConf->pAio};
         conf.file[0] = *pSttLevel->fobjArr->data[i]->f;
 
         code = tsdbSttFileReaderOpen(pSttLevel->fobjArr->data[i]->fname, &conf, &pSttFileReader);
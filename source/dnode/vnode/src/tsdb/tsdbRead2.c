@@ -83,7 +83,7 @@ static int32_t setColumnIdSlotList(SBlockLoadSuppInfo* pSupInfo, SColumnInfo* pC
                                    int32_t numOfCols) {
   pSupInfo->smaValid = true;
   pSupInfo->numOfCols = numOfCols;
-  pSupInfo->colId = taosMemoryMalloc(numOfCols * (sizeof(int16_t) * 2 + POINTER_BYTES));
+  pSupInfo->colId = taosMemoryMalloc(numOfCols * (sizeof(int16_t) * 3 + POINTER_BYTES + sizeof(bool)));
   if (pSupInfo->colId == NULL) {
     taosMemoryFree(pSupInfo->colId);
     return TSDB_CODE_OUT_OF_MEMORY;
@@ -91,6 +91,8 @@ static int32_t setColumnIdSlotList(SBlockLoadSuppInfo* pSupInfo, SColumnInfo* pC
 
   pSupInfo->slotId = (int16_t*)((char*)pSupInfo->colId + (sizeof(int16_t) * numOfCols));
   pSupInfo->buildBuf = (char**)((char*)pSupInfo->slotId + (sizeof(int16_t) * numOfCols));
+  pSupInfo->loadColId = (int16_t*)((char*)pSupInfo->buildBuf + (POINTER_BYTES * numOfCols));
+  pSupInfo->colLoad = (bool*)((char*)pSupInfo->loadColId + (sizeof(int16_t) * numOfCols));
   for (int32_t i = 0; i < numOfCols; ++i) {
     pSupInfo->colId[i] = pCols[i].colId;
     pSupInfo->slotId[i] = pSlotIdList[i];
@@ -205,7 +207,8 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
     STFileObj** pFileObj = pReader->status.pCurrentFileset->farr;
     if (pFileObj[0] != NULL || pFileObj[3] != NULL) {
-      SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
+      SDataFileReaderConfig conf = {
+          .tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize, .pAio = pReader->pAio};
 
       const char* filesName[4] = {0};
 
@@ -272,6 +275,7 @@ _err:
 static void resetDataBlockIterator(SDataBlockIter* pIter, int32_t order) {
   pIter->order = order;
   pIter->index = -1;
+  pIter->prefetchIndex = -1;
   pIter->numOfBlocks = 0;
   if (pIter->blockList == NULL) {
     pIter->blockList = taosArrayInit(4, sizeof(SFileDataBlockInfo));
@@ -352,8 +356,31 @@ static int32_t tsdbReleaseReader(STsdbReader* pReader) {
   return code;
 }
 
+// the reader that the current data block comes from
+static STsdbReader* getCurrentBlockReader(STsdbReader* pReader) {
+  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
+    if (pReader->step == EXTERNAL_ROWS_PREV) {
+      return pReader->innerReader[0];
+    } else if (pReader->step == EXTERNAL_ROWS_NEXT) {
+      return pReader->innerReader[1];
+    }
+  }
+
+  return pReader;
+}
+
 void tsdbReleaseDataBlock2(STsdbReader* pReader) {
   SReaderStatus* pStatus = &pReader->status;
+  STsdbReader*   pTReader = getCurrentBlockReader(pReader);
+
+  // the partial retrieve has released the reader already, only drop the remain columns
+  if (pTReader->status.partialLoaded) {
+    tsdbAcquireReader(pReader);
+    pTReader->status.partialLoaded = false;
+    tsdbReleaseReader(pReader);
+    return;
+  }
+
   if (!pStatus->composedDataBlock) {
     tsdbReleaseReader(pReader);
   }
@@ -902,7 +929,8 @@ static void blockInfoToRecord(SBrinRecord* record, SFileDataBlockInfo* pBlockInf
   record->count = pBlockInfo->count;
 }
 
-static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
+// pColLoad: copy only the output columns marked in it, the others in result block are left untouched. NULL for all.
+static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, const bool* pColLoad) {
   SReaderStatus*      pStatus = &pReader->status;
   SDataBlockIter*     pBlockIter = &pStatus->blockIter;
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
@@ -1008,6 +1036,11 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
   while (i < numOfOutputCols && colIndex < num) {
     rowIndex = 0;
 
+    if (pColLoad != NULL && !pColLoad[i]) {
+      i += 1;
+      continue;
+    }
+
     SColData* pData = tBlockDataGetColDataByIdx(pBlockData, colIndex);
     if (pData->cid < pSupInfo->colId[i]) {
       colIndex += 1;
@@ -1041,8 +1074,10 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
 
   // fill the mis-matched columns with null value
   while (i < numOfOutputCols) {
-    pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-    colDataSetNNULL(pColData, 0, dumpedRows);
+    if (pColLoad == NULL || pColLoad[i]) {
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+      colDataSetNNULL(pColData, 0, dumpedRows);
+    }
     i += 1;
   }
 
@@ -1094,8 +1129,54 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+// issue asynchronous reads of the next blocks, so the disk works on them while the current one is decoded
+static void prefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  int32_t step = ASCENDING_TRAVERSE(pBlockIter->order) ? 1 : -1;
+
+  // one ring for the files of the reader, opened by the first file with blocks to read ahead and kept until the
+  // reader is closed. A reader of a few blocks does not pay for it.
+  if (pReader->pAio == NULL) {
+    int32_t remain = (step > 0) ? (pBlockIter->numOfBlocks - 1 - pBlockIter->index) : pBlockIter->index;
+    if (remain <= 1 || pReader->aioFailed) {
+      return;
+    }
+
+    pReader->pAio = taosAIOOpen(TSDB_READ_PREFETCH_DEPTH, 0);
+    if (pReader->pAio == NULL) {
+      tsdbWarn("%p failed to open the ring to read blocks ahead since %s, %s", pReader, strerror(errno),
+               pReader->idStr);
+      pReader->aioFailed = true;
+      return;
+    }
+    tsdbDataFileReaderSetAio(pReader->pFileReader, pReader->pAio);
+  }
+
+  int32_t index = pBlockIter->index + step;
+  if ((pBlockIter->prefetchIndex - pBlockIter->index) * step > 0) {
+    index = pBlockIter->prefetchIndex + step;
+  }
+
+  for (; index >= 0 && index < pBlockIter->numOfBlocks; index += step) {
+    if ((index - pBlockIter->index) * step > TSDB_READ_PREFETCH_BLOCKS) {
+      break;
+    }
+
+    SBrinRecord record;
+    blockInfoToRecord(&record, taosArrayGet(pBlockIter->blockList, index));
+
+    int32_t code = tsdbDataFilePrefetchBlockData(pReader->pFileReader, &record);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbDebug("%p failed to read ahead file block, global index:%d, code:%s %s", pReader, index, tstrerror(code),
+                pReader->idStr);
+      break;
+    }
+
+    pBlockIter->prefetchIndex = index;
+  }
+}
+
+static int32_t doLoadFileBlockDataImpl(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                       uint64_t uid, int16_t* pColId, int32_t numOfCols) {
   int32_t   code = 0;
   STSchema* pSchema = pReader->info.pSchema;
   int64_t   st = taosGetTimestampUs();
@@ -1114,11 +1195,12 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  prefetchFileBlocks(pReader, pBlockIter);
+
   SBrinRecord tmp;
   blockInfoToRecord(&tmp, pBlockInfo);
   SBrinRecord* pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, pColId, numOfCols);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1140,6 +1222,12 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  return doLoadFileBlockDataImpl(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1);
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2062,6 +2150,7 @@ static bool initSttBlockReader(SSttBlockReader* pSttBlockReader, STableBlockScan
       .pReader = pReader,
       .idstr = pReader->idStr,
       .rspRows = (pReader->info.execMode == READER_EXEC_ROWS),
+      .pAio = pReader->pAio,
   };
 
   SSttDataInfoForTable info = {.pTimeWindowList = taosArrayInit(4, sizeof(STimeWindow))};
@@ -2340,7 +2429,7 @@ static int32_t buildComposedDataBlock(STsdbReader* pReader) {
   if (isCleanFileDataBlock(pReader, pBlockInfo, pBlockScanInfo, keyInBuf) && (pBlockInfo->numRow <= cap)) {
     if (((asc && (pBlockInfo->firstKey < keyInBuf.ts)) || (!asc && (pBlockInfo->lastKey > keyInBuf.ts))) &&
         (pBlockScanInfo->sttKeyInfo.status == STT_FILE_NO_DATA)) {
-      code = copyBlockDataToSDataBlock(pReader);
+      code = copyBlockDataToSDataBlock(pReader, NULL);
       if (code) {
         goto _end;
       }
@@ -4164,6 +4253,10 @@ void tsdbReaderClose2(STsdbReader* pReader) {
   destroySttBlockReader(pReader->status.pLDataIterArray, &pCost->sttCost);
   taosMemoryFreeClear(pReader->status.uidList.tableUidList);
 
+  // all files reading ahead on the ring are closed by now
+  taosAIOClose(pReader->pAio);
+  pReader->pAio = NULL;
+
   qTrace("tsdb/reader-close: %p, untake snapshot", pReader);
   void* p = pReader->pReadSnap;
   if ((p == atomic_val_compare_exchange_ptr((void**)&pReader->pReadSnap, p, NULL)) && (p != NULL)) {
@@ -4278,6 +4371,12 @@ static int32_t tsdbSetQueryReseek(void* pQHandle) {
       return code;
     }
 
+    // the remain columns of a partially retrieved file block are still to be loaded
+    if (getCurrentBlockReader(pReader)->status.partialLoaded) {
+      tsdbReleaseReader(pReader);
+      return TSDB_CODE_VND_QUERY_BUSY;
+    }
+
     tsdbReaderSuspend2(pReader);
     tsdbReleaseReader(pReader);
 
@@ -4449,6 +4548,7 @@ static int32_t doTsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
   *hasNext = false;
 
   SReaderStatus* pStatus = &pReader->status;
+  pStatus->partialLoaded = false;
   if (tSimpleHashGetSize(pStatus->pTableMap) == 0) {
     return code;
   }
@@ -4714,10 +4814,42 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
-static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
+// Mark the output columns in pIdList to be loaded by a partial retrieve. Return false if all columns are in it.
+static bool setPartialLoadColumns(SBlockLoadSuppInfo* pSup, SArray* pIdList, int32_t* numOfLoad) {
+  *numOfLoad = 0;
+  pSup->colLoad[0] = true;
+
+  for (int32_t i = 1; i < pSup->numOfCols; ++i) {
+    pSup->colLoad[i] = (taosArraySearch(pIdList, &pSup->colId[i], compareInt16Val, TD_EQ) != NULL);
+    if (pSup->colLoad[i]) {
+      pSup->loadColId[(*numOfLoad)++] = pSup->colId[i];
+    }
+  }
+
+  return (*numOfLoad) < pSup->numOfCols - 1;
+}
+
+// the columns not copied by the previous partial retrieve
+static void setRemainLoadColumns(SBlockLoadSuppInfo* pSup, int32_t* numOfLoad) {
+  *numOfLoad = 0;
+
+  for (int32_t i = 1; i < pSup->numOfCols; ++i) {
+    pSup->colLoad[i] = !pSup->colLoad[i];
+    if (pSup->colLoad[i]) {
+      pSup->loadColId[(*numOfLoad)++] = pSup->colId[i];
+    }
+  }
+}
+
+static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader, SArray* pIdList) {
   SReaderStatus*      pStatus = &pReader->status;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
   int32_t             code = TSDB_CODE_SUCCESS;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pStatus->blockIter);
+  int16_t*            pColId = &pSup->colId[1];
+  int32_t             numOfLoad = pSup->numOfCols - 1;
+  const bool*         pColLoad = NULL;
+  bool                partial = false;
 
   if (pReader->code != TSDB_CODE_SUCCESS) {
     return NULL;
@@ -4728,39 +4860,65 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
     return NULL;
   }
 
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  if (pIdList != NULL) {
+    partial = setPartialLoadColumns(pSup, pIdList, &numOfLoad);
+    if (partial) {
+      pColId = pSup->loadColId;
+      pColLoad = pSup->colLoad;
+    } else {
+      numOfLoad = pSup->numOfCols - 1;
+    }
+  } else if (pStatus->partialLoaded) {
+    setRemainLoadColumns(pSup, &numOfLoad);
+    pColId = pSup->loadColId;
+    pColLoad = pSup->colLoad;
+  }
+
+  pStatus->partialLoaded = false;
+  SFileBlockDumpInfo dumpInfo = pStatus->fBlockDumpInfo;
+
+  code = doLoadFileBlockDataImpl(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid, pColId,
+                                 numOfLoad);
   if (code != TSDB_CODE_SUCCESS) {
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
     return NULL;
   }
 
-  code = copyBlockDataToSDataBlock(pReader);
+  code = copyBlockDataToSDataBlock(pReader, pColLoad);
   if (code != TSDB_CODE_SUCCESS) {
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
     return NULL;
   }
 
+  if (partial) {
+    // the remain columns are copied by the next retrieve, which must start from the same row
+    pStatus->fBlockDumpInfo = dumpInfo;
+    pStatus->partialLoaded = true;
+    pReader->resBlockInfo.pResBlock->info.dataLoad = 0;
+  }
+
   return pReader->resBlockInfo.pResBlock;
 }
 
 SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
-  STsdbReader* pTReader = pReader;
-  if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
-    if (pReader->step == EXTERNAL_ROWS_PREV) {
-      pTReader = pReader->innerReader[0];
-    } else if (pReader->step == EXTERNAL_ROWS_NEXT) {
-      pTReader = pReader->innerReader[1];
-    }
-  }
+  STsdbReader* pTReader = getCurrentBlockReader(pReader);
 
   SReaderStatus* pStatus = &pTReader->status;
   if (pStatus->composedDataBlock || pReader->info.execMode == READER_EXEC_ROWS) {
     return pTReader->resBlockInfo.pResBlock;
   }
 
-  SSDataBlock* ret = doRetrieveDataBlock(pTReader);
+  // the partial retrieve has released the reader, take it again to load the remain columns
+  if (pIdList == NULL && pStatus->partialLoaded) {
+    tsdbAcquireReader(pReader);
+    qTrace("tsdb/read-retrieve: %p, take read mutex for the remain columns", pReader);
+  }
+
+  // the reader is released after a partial retrieve as well, so it is not locked while the filter runs. A reseek in
+  // between is refused as busy, see tsdbSetQueryReseek, so the file block is still there for the remain columns.
+  SSDataBlock* ret = doRetrieveDataBlock(pTReader, pIdList);
 
   qTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
   tsdbReleaseReader(pReader);
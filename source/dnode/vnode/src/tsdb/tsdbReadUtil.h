@@ -26,6 +26,11 @@ extern "C" {
 
 #define ASCENDING_TRAVERSE(o) (o == TSDB_ORDER_ASC)
 
+// number of file blocks read ahead of the one being loaded
+#define TSDB_READ_PREFETCH_BLOCKS 4
+// requests in flight on the ring of a reader, shared by its data file and stt files
+#define TSDB_READ_PREFETCH_DEPTH 32
+
 #define INIT_TIMEWINDOW(_w) \
   do {                      \
     (_w)->skey = INT64_MAX; \
@@ -158,6 +163,8 @@ typedef struct SBlockLoadSuppInfo {
   int16_t*            slotId;
   int32_t             numOfCols;
   char**              buildBuf;  // build string tmp buffer, todo remove it later after all string format being updated.
+  int16_t*            loadColId;  // column id list of a partial retrieve
+  bool*               colLoad;    // output columns copied by a partial retrieve
   bool                smaValid;  // the sma on all queried columns are activated
 } SBlockLoadSuppInfo;
 
@@ -202,6 +209,7 @@ typedef struct SFileDataBlockInfo {
 typedef struct SDataBlockIter {
   int32_t    numOfBlocks;
   int32_t    index;
+  int32_t    prefetchIndex;  // the last block read ahead along the scan order
   SArray*    blockList;  // SArray<SFileDataBlockInfo>
   int32_t    order;
   SDataBlk   block;  // current SDataBlk data
@@ -219,6 +227,7 @@ typedef struct SReaderStatus {
   bool                  suspendInvoked;
   bool                  loadFromFile;       // check file stage
   bool                  composedDataBlock;  // the returned data block is a composed block or not
+  bool                  partialLoaded;      // only part of the columns of current file block are copied
   SSHashObj*            pTableMap;          // SHash<STableBlockScanInfo>
   STableBlockScanInfo** pTableIter;         // table iterator used in building in-memory buffer data blocks.
   STableUidList         uidList;            // check tables in uid order, to avoid the repeatly load of blocks in STT.
@@ -267,6 +276,8 @@ struct STsdbReader {
   bool                 bFilesetDelimited;   // duration by duration output
   TsdReaderNotifyCbFn  notifyFn;
   void*              notifyParam;
+  TdAIOPtr           pAio;  // the ring of the blocks read ahead, shared by the files of the reader
+  bool               aioFailed;
 };
 
 typedef struct SBrinRecordIter {
@@ -91,6 +91,234 @@ _exit:
   return code;
 }
 
+// =============== READ AHEAD ===============
+#define TSDB_FD_PREFETCH_SLOTS     8
+#define TSDB_FD_PREFETCH_MAX_PAGES 256
+
+enum {
+  TSDB_PREFETCH_FREE = 0,
+  TSDB_PREFETCH_INFLIGHT,
+  TSDB_PREFETCH_READY,
+};
+
+typedef struct {
+  int8_t      state;
+  STsdbFD    *pFD;
+  int64_t     pgno;  // first page
+  int64_t     nPage;
+  int64_t     szBuf;
+  uint8_t    *pBuf;
+  STaosAIOReq req;
+} STsdbPrefetchSlot;
+
+struct STsdbFDPrefetch {
+  int32_t           next;  // the slot tried first by the next prefetch, which is the oldest one
+  STsdbPrefetchSlot slots[TSDB_FD_PREFETCH_SLOTS];
+};
+
+// the buffer is released with the slot, so the memory of a file only covers the pages not taken yet
+static void tsdbPrefetchFreeSlot(STsdbPrefetchSlot *pSlot) {
+  taosMemoryFreeClear(pSlot->pBuf);
+  pSlot->szBuf = 0;
+  pSlot->state = TSDB_PREFETCH_FREE;
+}
+
+// take the completed requests of all files on the ring, each request finds its slot by the param
+static int32_t tsdbPrefetchReap(TdAIOPtr pAio, bool block) {
+  STaosAIOReq *pReqs[TSDB_FD_PREFETCH_SLOTS];
+
+  int32_t num = taosAIOGetCompleted(pAio, pReqs, TSDB_FD_PREFETCH_SLOTS, block);
+  for (int32_t i = 0; i < num; ++i) {
+    STsdbPrefetchSlot *pDone = pReqs[i]->param;
+    STsdbFD           *pFD = pDone->pFD;
+    if (pReqs[i]->res == pDone->nPage * pFD->szPage) {
+      pDone->state = TSDB_PREFETCH_READY;
+    } else {
+      // the pages are read synchronously later, which reports the error if any
+      tsdbDebug("failed to read ahead %" PRId64 " pages from page %" PRId64 " of file %s since %s", pDone->nPage,
+                pDone->pgno, pFD->path, pReqs[i]->res < 0 ? strerror(pReqs[i]->code) : "short read");
+      tsdbPrefetchFreeSlot(pDone);
+    }
+  }
+
+  return num;
+}
+
+// wait until the slot is read ahead or failed
+static void tsdbPrefetchWait(STsdbFD *pFD, STsdbPrefetchSlot *pSlot) {
+  while (pSlot->state == TSDB_PREFETCH_INFLIGHT) {
+    if (tsdbPrefetchReap(pFD->pAio, true) <= 0) {
+      tsdbError("failed to wait for the pages read ahead of file %s since %s", pFD->path, strerror(errno));
+      break;
+    }
+  }
+}
+
+static void tsdbPrefetchDestroy(STsdbFD *pFD) {
+  struct STsdbFDPrefetch *pPrefetch = pFD->pPrefetch;
+  if (pPrefetch == NULL) {
+    return;
+  }
+
+  // the ring is shared with other files, only the requests of this file are waited for before the buffers are released
+  for (int32_t i = 0; i < TSDB_FD_PREFETCH_SLOTS; ++i) {
+    STsdbPrefetchSlot *pSlot = &pPrefetch->slots[i];
+    tsdbPrefetchWait(pFD, pSlot);
+    if (pSlot->state == TSDB_PREFETCH_INFLIGHT) {
+      // the kernel may still write into the buffer, so it is leaked
+      continue;
+    }
+    taosMemoryFree(pSlot->pBuf);
+  }
+  taosMemoryFree(pPrefetch);
+  pFD->pPrefetch = NULL;
+}
+
+// copy the page to pFD->pBuf if it has been read ahead
+static bool tsdbPrefetchGetPage(STsdbFD *pFD, int64_t pgno) {
+  struct STsdbFDPrefetch *pPrefetch = pFD->pPrefetch;
+  if (pPrefetch == NULL) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < TSDB_FD_PREFETCH_SLOTS; ++i) {
+    STsdbPrefetchSlot *pSlot = &pPrefetch->slots[i];
+    if (pSlot->state == TSDB_PREFETCH_FREE || pgno < pSlot->pgno || pgno >= pSlot->pgno + pSlot->nPage) {
+      continue;
+    }
+
+    tsdbPrefetchWait(pFD, pSlot);
+    if (pSlot->state != TSDB_PREFETCH_READY) {
+      return false;
+    }
+
+    memcpy(pFD->pBuf, pSlot->pBuf + (pgno - pSlot->pgno) * pFD->szPage, pFD->szPage);
+
+    // blocks are read in page order, so the slot is done after its last page
+    if (pgno == pSlot->pgno + pSlot->nPage - 1) {
+      tsdbPrefetchFreeSlot(pSlot);
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// the oldest slot which is not in flight, NULL if all of them are
+static STsdbPrefetchSlot *tsdbPrefetchGetSlot(struct STsdbFDPrefetch *pPrefetch) {
+  for (int32_t n = 0; n < TSDB_FD_PREFETCH_SLOTS; ++n) {
+    int32_t i = (pPrefetch->next + n) % TSDB_FD_PREFETCH_SLOTS;
+    if (pPrefetch->slots[i].state != TSDB_PREFETCH_INFLIGHT) {
+      pPrefetch->next = (i + 1) % TSDB_FD_PREFETCH_SLOTS;
+      return &pPrefetch->slots[i];
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Read the pages of [offset, offset + size) of a read only file asynchronously on the ring set by the owner of the
+ * file, so that a following tsdbReadFile on them does not wait for the disk. At most TSDB_FD_PREFETCH_SLOTS ranges
+ * are kept, the oldest one not in flight is dropped when a new range is read ahead. It never waits for the disk, the
+ * range is skipped if all slots are in flight or the ring is full.
+ */
+int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size) {
+  int32_t code = 0;
+
+  if (size <= 0 || pFD->flag != TD_FILE_READ || pFD->pAio == NULL) {
+    return code;
+  }
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) {
+      goto _exit;
+    }
+  }
+
+  if (pFD->s3File) {
+    return code;
+  }
+
+  if (pFD->pPrefetch == NULL) {
+    pFD->pPrefetch = taosMemoryCalloc(1, sizeof(struct STsdbFDPrefetch));
+    if (pFD->pPrefetch == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+  }
+
+  struct STsdbFDPrefetch *pPrefetch = pFD->pPrefetch;
+
+  // the slots done by now are reused or skipped below
+  if (tsdbPrefetchReap(pFD->pAio, false) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+  int64_t pgno = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset, pFD->szPage), pFD->szPage);
+  int64_t pgnoEnd = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, pFD->szPage), pFD->szPage);
+
+  // skip the pages in pFD->pBuf or read ahead already
+  for (bool skipped = true; skipped && pgno <= pgnoEnd;) {
+    skipped = false;
+    if (pgno == pFD->pgno) {
+      pgno++;
+      skipped = true;
+    }
+
+    for (int32_t i = 0; i < TSDB_FD_PREFETCH_SLOTS; ++i) {
+      STsdbPrefetchSlot *pSlot = &pPrefetch->slots[i];
+      if (pSlot->state != TSDB_PREFETCH_FREE && pgno >= pSlot->pgno && pgno < pSlot->pgno + pSlot->nPage) {
+        pgno = pSlot->pgno + pSlot->nPage;
+        skipped = true;
+      }
+    }
+  }
+
+  if (pgno > pgnoEnd) {
+    return code;
+  }
+
+  STsdbPrefetchSlot *pSlot = tsdbPrefetchGetSlot(pPrefetch);
+  if (pSlot == NULL) {
+    return code;
+  }
+  pSlot->state = TSDB_PREFETCH_FREE;
+
+  int64_t nPage = TMIN(pgnoEnd - pgno + 1, TSDB_FD_PREFETCH_MAX_PAGES);
+  if (pSlot->szBuf < nPage * pFD->szPage) {
+    uint8_t *pBuf = taosMemoryRealloc(pSlot->pBuf, nPage * pFD->szPage);
+    if (pBuf == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    pSlot->pBuf = pBuf;
+    pSlot->szBuf = nPage * pFD->szPage;
+  }
+
+  pSlot->pFD = pFD;
+  pSlot->pgno = pgno;
+  pSlot->nPage = nPage;
+  pSlot->req = (STaosAIOReq){
+      .pFile = pFD->pFD,
+      .buf = pSlot->pBuf,
+      .count = nPage * pFD->szPage,
+      .offset = PAGE_OFFSET(pgno, pFD->szPage),
+      .param = pSlot,
+  };
+
+  STaosAIOReq *pReq = &pSlot->req;
+  if (taosAIOSubmit(pFD->pAio, &pReq, 1) == 1) {
+    pSlot->state = TSDB_PREFETCH_INFLIGHT;
+  } else {
+    tsdbPrefetchFreeSlot(pSlot);
+  }
+
+_exit:
+  return code;
+}
+
 // =============== PAGE-WISE FILE ===============
 int32_t tsdbOpenFile(const char *path, STsdb *pTsdb, int32_t flag, STsdbFD **ppFD) {
   int32_t  code = 0;
@@ -122,6 +350,7 @@ _exit:
 void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
+    tsdbPrefetchDestroy(pFD);
     taosMemoryFree(pFD->pBuf);
     if (!pFD->s3File) {
       taosCloseFile(&pFD->pFD);
@@ -202,7 +431,7 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
     memcpy(pFD->pBuf, pBlock + (offset - blk_offset), pFD->szPage);
 
     tsdbCacheRelease(pFD->pTsdb->bCache, handle);
-  } else {
+  } else if (!tsdbPrefetchGetPage(pFD, pgno)) {
     // seek
     int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
     if (n < 0) {
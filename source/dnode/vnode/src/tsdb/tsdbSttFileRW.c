@@ -55,6 +55,7 @@ int32_t tsdbSttFileReaderOpen(const char *fname, const SSttFileReaderConfig *con
     code = tsdbOpenFile(fname1, config->tsdb, TD_FILE_READ, &reader[0]->fd);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
+  reader[0]->fd->pAio = config->pAio;
 
   // // open each segment reader
   int64_t offset = config->file->size - sizeof(SSttFooter);
@@ -346,6 +347,10 @@ _exit:
   return code;
 }
 
+int32_t tsdbSttFilePrefetchBlockData(SSttFileReader *reader, const SSttBlk *sttBlk) {
+  return tsdbPrefetchFile(reader->fd, sttBlk->bInfo.offset, sttBlk->bInfo.szBlock);
+}
+
 int32_t tsdbSttFileReadStatisBlock(SSttFileReader *reader, const SStatisBlk *statisBlk, STbStatisBlock *statisBlock) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -50,6 +50,7 @@ int32_t tsdbSttFileReadTombBlk(SSttFileReader *reader, const TTombBlkArray **del
 int32_t tsdbSttFileReadBlockData(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData);
 int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData,
                                          STSchema *pTSchema, int16_t cids[], int32_t ncid);
+int32_t tsdbSttFilePrefetchBlockData(SSttFileReader *reader, const SSttBlk *sttBlk);
 int32_t tsdbSttFileReadStatisBlock(SSttFileReader *reader, const SStatisBlk *statisBlk, STbStatisBlock *sData);
 int32_t tsdbSttFileReadTombBlock(SSttFileReader *reader, const STombBlk *delBlk, STombBlock *dData);
 
@@ -58,6 +59,7 @@ struct SSttFileReaderConfig {
   int32_t   szPage;
   STFile    file[1];
   uint8_t **bufArr;
+  TdAIOPtr  pAio;  // the ring to read blocks ahead, NULL if not
 };
 
 // SSttFileWriter ==========================================
@@ -117,61 +117,47 @@ void vnodeBufPoolReset(SVBufPool *pPool) {
   ASSERT(pPool->size == pPool->ptr - pPool->node.data);
 
   pPool->size = 0;
+  pPool->waste = 0;
+  pPool->overflow = 0;
   pPool->ptr = pPool->node.data;
 }
 
-void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
-  SVBufPoolNode *pNode;
-  void          *p = NULL;
-  uint8_t       *ptr = NULL;
-  int            paddingLen = 0;
-  ASSERT(pPool != NULL);
-
-  if (pPool->lock) taosThreadSpinLock(pPool->lock);
-
-  ptr = pPool->ptr;
-  paddingLen = (((long)ptr + 7) & ~7) - (long)ptr;
-
-  if (pPool->node.size >= pPool->ptr - pPool->node.data + size + paddingLen) {
-    // allocate from the anchor node
-    p = pPool->ptr + paddingLen;
-    size += paddingLen;
-    pPool->ptr = pPool->ptr + size;
-    pPool->size += size;
-  } else {
-    // allocate a new node
-    pNode = taosMemoryMalloc(sizeof(*pNode) + size);
-    if (pNode == NULL) {
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
-      if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+// Bump allocation from the anchor node. It is lock free so concurrent writers (e.g. rsma) only take the pool lock
+// when the anchor node is exhausted and a new node has to be linked. Return NULL if the anchor node has no room.
+static void *vnodeBufPoolMallocFromAnchor(SVBufPool *pPool, int size, bool aligned) {
+  uint8_t *ptr = NULL;
+  uint8_t *nptr = NULL;
+  int      paddingLen = 0;
+
+  do {
+    ptr = (uint8_t *)atomic_load_ptr(&pPool->ptr);
+    paddingLen = aligned ? ((((long)ptr + 7) & ~7) - (long)ptr) : 0;
+    if (pPool->node.size < ptr - pPool->node.data + size + paddingLen) {
       return NULL;
     }
+    nptr = ptr + paddingLen + size;
+  } while (atomic_val_compare_exchange_ptr(&pPool->ptr, ptr, nptr) != ptr);
 
-    p = pNode->data;
-    pNode->size = size;
-    pNode->prev = pPool->pTail;
-    pNode->pnext = &pPool->pTail;
-    pPool->pTail->pnext = &pNode->prev;
-    pPool->pTail = pNode;
-
-    pPool->size = pPool->size + sizeof(*pNode) + size;
+  atomic_add_fetch_64(&pPool->size, size + paddingLen);
+  if (paddingLen) {
+    atomic_add_fetch_64(&pPool->waste, paddingLen);
   }
-  if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
-  return p;
+  return ptr + paddingLen;
 }
 
-void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
+static void *vnodeBufPoolMallocImpl(SVBufPool *pPool, int size, bool aligned) {
   SVBufPoolNode *pNode;
   void          *p = NULL;
   ASSERT(pPool != NULL);
 
+  p = vnodeBufPoolMallocFromAnchor(pPool, size, aligned);
+  if (p) return p;
+
   if (pPool->lock) taosThreadSpinLock(pPool->lock);
-  if (pPool->node.size >= pPool->ptr - pPool->node.data + size) {
-    // allocate from the anchor node
-    p = pPool->ptr;
-    pPool->ptr = pPool->ptr + size;
-    pPool->size += size;
-  } else {
+
+  // check again since another writer may have been here
+  p = vnodeBufPoolMallocFromAnchor(pPool, size, aligned);
+  if (p == NULL) {
     // allocate a new node
     pNode = taosMemoryMalloc(sizeof(*pNode) + size);
     if (pNode == NULL) {
@@ -187,12 +173,18 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
     pPool->pTail->pnext = &pNode->prev;
     pPool->pTail = pNode;
 
-    pPool->size = pPool->size + sizeof(*pNode) + size;
+    atomic_add_fetch_64(&pPool->size, sizeof(*pNode) + size);
+    atomic_add_fetch_64(&pPool->waste, sizeof(*pNode));
+    atomic_add_fetch_64(&pPool->overflow, size);
   }
   if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
   return p;
 }
 
+void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) { return vnodeBufPoolMallocImpl(pPool, size, true); }
+
+void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) { return vnodeBufPoolMallocImpl(pPool, size, false); }
+
 void vnodeBufPoolFree(SVBufPool *pPool, void *p) {
   // uint8_t       *ptr = (uint8_t *)p;
   // SVBufPoolNode *pNode;
@@ -328,3 +320,20 @@ _exit:
   taosThreadMutexUnlock(&pPool->mutex);
   return code;
 }
+
+void vnodeGetBufPoolStat(SVnode *pVnode, int64_t *used, int64_t *waste, int64_t *overflow) {
+  *used = 0;
+  *waste = 0;
+  *overflow = 0;
+
+  taosThreadMutexLock(&pVnode->mutex);
+  for (int32_t i = 0; i < VNODE_BUFPOOL_SEGMENTS; i++) {
+    SVBufPool *pPool = pVnode->aBufPool[i];
+    if (pPool == NULL) continue;
+
+    *used += atomic_load_64(&pPool->size);
+    *waste += atomic_load_64(&pPool->waste);
+    *overflow += atomic_load_64(&pPool->overflow);
+  }
+  taosThreadMutexUnlock(&pVnode->mutex);
+}
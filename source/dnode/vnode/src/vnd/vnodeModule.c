@@ -53,4 +53,5 @@ void vnodeCleanup() {
 
   walCleanUp();
   smaCleanUp();
+  taosAIOCleanup();
 }
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tq.h"
+
+using namespace std;
+
+// a submit message of one table of the uid, without any column
+static void *encodeSubmit(int64_t uid, int32_t *pLen) {
+  SSubmitReq2   req = {0};
+  SSubmitTbData tbData = {0};
+  SEncoder      encoder;
+  void         *pBuf = NULL;
+
+  tbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+  tbData.uid = uid;
+  tbData.sver = 1;
+  tbData.aCol = taosArrayInit(1, sizeof(SColData));
+  req.aSubmitTbData = taosArrayInit(1, sizeof(SSubmitTbData));
+  taosArrayPush(req.aSubmitTbData, &tbData);
+
+  tEncoderInit(&encoder, NULL, 0);
+  tEncodeSubmitReq(&encoder, &req);
+  *pLen = encoder.pos;
+  tEncoderClear(&encoder);
+
+  pBuf = taosMemoryMalloc(*pLen);
+  tEncoderInit(&encoder, (uint8_t *)pBuf, *pLen);
+  tEncodeSubmitReq(&encoder, &req);
+  tEncoderClear(&encoder);
+
+  taosArrayDestroy(tbData.aCol);
+  taosArrayDestroy(req.aSubmitTbData);
+  return pBuf;
+}
+
+static int64_t submitUid(STqSubmitCache *pCache, LRUHandle *h) {
+  SSubmitReq2 *pReq = tqSubmitCacheGetReq(pCache, h);
+  if (taosArrayGetSize(pReq->aSubmitTbData) != 1) {
+    return -1;
+  }
+  return ((SSubmitTbData *)taosArrayGet(pReq->aSubmitTbData, 0))->uid;
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+// a single reader decodes on its own
+TEST(testCase, submitCacheSingleReaderTest) {
+  int32_t         len = 0;
+  void           *pMsg = encodeSubmit(100, &len);
+  STqSubmitCache *pCache = tqSubmitCacheOpen();
+  ASSERT_NE(pCache, nullptr);
+
+  ASSERT_EQ(tqSubmitCacheAcquire(pCache, pMsg, len, 1), nullptr);
+  tqSubmitCacheAddReader(pCache);
+  ASSERT_EQ(tqSubmitCacheAcquire(pCache, pMsg, len, 1), nullptr);
+
+  tqSubmitCacheRemoveReader(pCache);
+  tqSubmitCacheClose(pCache);
+  taosMemoryFree(pMsg);
+}
+
+// the readers share the message decoded by the first one, even after the tq is closed
+TEST(testCase, submitCacheSharedTest) {
+  int32_t         len = 0;
+  void           *pMsg = encodeSubmit(100, &len);
+  STqSubmitCache *pCache = tqSubmitCacheOpen();
+  ASSERT_NE(pCache, nullptr);
+
+  tqSubmitCacheAddReader(pCache);
+  tqSubmitCacheAddReader(pCache);
+
+  LRUHandle *h1 = tqSubmitCacheAcquire(pCache, pMsg, len, 1);
+  ASSERT_NE(h1, nullptr);
+  ASSERT_EQ(submitUid(pCache, h1), 100);
+
+  LRUHandle *h2 = tqSubmitCacheAcquire(pCache, pMsg, len, 1);
+  ASSERT_EQ(h2, h1);
+  tqSubmitCacheRelease(pCache, h2);
+
+  // another message of the same version is not taken for the cached one
+  ASSERT_EQ(tqSubmitCacheAcquire(pCache, pMsg, len - 1, 1), nullptr);
+
+  tqSubmitCacheClose(pCache);
+  ASSERT_EQ(submitUid(pCache, h1), 100);
+  tqSubmitCacheRelease(pCache, h1);
+
+  tqSubmitCacheRemoveReader(pCache);
+  tqSubmitCacheRemoveReader(pCache);
+  taosMemoryFree(pMsg);
+}
+
+static void acquireSubmits(STqSubmitCache *pCache, int32_t owner, vector<void *> *pMsgs, vector<int32_t> *pLens,
+                           atomic<bool> *pStart, atomic<int32_t> *pErrors) {
+  uint32_t seed = owner + 1;
+  while (!*pStart) {
+  }
+
+  for (int32_t i = 0; i < 20000; i++) {
+    int32_t    ver = taosRandR(&seed) % pMsgs->size();
+    LRUHandle *h = tqSubmitCacheAcquire(pCache, (*pMsgs)[ver], (*pLens)[ver], ver);
+    if (h == NULL || submitUid(pCache, h) != ver + 100) {
+      (*pErrors)++;
+    }
+    if (h != NULL) {
+      tqSubmitCacheRelease(pCache, h);
+    }
+  }
+}
+
+// readers acquire and decode the messages of the same versions at once
+TEST(testCase, submitCacheConcurrentTest) {
+  const int32_t nThread = 8;
+
+  vector<void *>  msgs;
+  vector<int32_t> lens;
+  vector<thread>  threads;
+  atomic<bool>    start(false);
+  atomic<int32_t> errors(0);
+
+  STqSubmitCache *pCache = tqSubmitCacheOpen();
+  ASSERT_NE(pCache, nullptr);
+
+  for (int32_t ver = 0; ver < 256; ver++) {
+    int32_t len = 0;
+    msgs.push_back(encodeSubmit(ver + 100, &len));
+    lens.push_back(len);
+  }
+
+  for (int32_t i = 0; i < nThread; i++) {
+    tqSubmitCacheAddReader(pCache);
+  }
+  for (int32_t i = 0; i < nThread; i++) {
+    threads.push_back(thread(acquireSubmits, pCache, i, &msgs, &lens, &start, &errors));
+  }
+  start = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(errors, 0);
+
+  for (int32_t i = 0; i < nThread; i++) {
+    tqSubmitCacheRemoveReader(pCache);
+  }
+  tqSubmitCacheClose(pCache);
+  for (void *pMsg : msgs) {
+    taosMemoryFree(pMsg);
+  }
+}
+
+#pragma GCC diagnostic pop
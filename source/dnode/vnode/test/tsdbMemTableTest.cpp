@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "vnodeTestUtil.h"
+
+using namespace std;
+
+typedef vector<pair<int64_t, int64_t>> SKeyList;  // ts and version of the rows of a table
+
+// insert the keys [from, to) with the step into the table, and into the expected rows
+static void insertKeys(SMemVnode *pVnode, int64_t uid, int64_t version, int64_t from, int64_t to, int64_t step,
+                       bool colFmt, SKeyList &expected) {
+  vector<int64_t> keys;
+  for (int64_t ts = from; ts < to; ts += step) {
+    keys.push_back(ts);
+    expected.push_back(make_pair(ts, version));
+  }
+  ASSERT_EQ(memVnodeInsert(pVnode, uid, version, keys.data(), (int32_t)keys.size(), colFmt), 0);
+}
+
+// the table has exactly the expected rows, in key order both ways
+static void checkRows(SMemVnode *pVnode, int64_t uid, SKeyList expected) {
+  sort(expected.begin(), expected.end());
+
+  int32_t         nRow = (int32_t)expected.size();
+  vector<int64_t> keys(nRow + 1), versions(nRow + 1);
+
+  ASSERT_TRUE(memVnodeCheckSkipList(pVnode, uid));
+  ASSERT_EQ(memVnodeCountRows(pVnode, uid), nRow);
+
+  ASSERT_EQ(memVnodeScan(pVnode, uid, false, keys.data(), versions.data(), nRow + 1), nRow);
+  for (int32_t i = 0; i < nRow; i++) {
+    ASSERT_EQ(keys[i], expected[i].first) << "row " << i;
+    ASSERT_EQ(versions[i], expected[i].second) << "row " << i;
+  }
+
+  ASSERT_EQ(memVnodeScan(pVnode, uid, true, keys.data(), versions.data(), nRow + 1), nRow);
+  for (int32_t i = 0; i < nRow; i++) {
+    ASSERT_EQ(keys[i], expected[nRow - 1 - i].first) << "row " << i;
+    ASSERT_EQ(versions[i], expected[nRow - 1 - i].second) << "row " << i;
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+// in-order submits are appended at the tail of the skiplist
+TEST(testCase, memTableAppendTest) {
+  SMemVnode *pVnode = NULL;
+  SKeyList   expected;
+  ASSERT_EQ(memVnodeOpen(64 << 20, false, &pVnode), 0);
+
+  int64_t version = 1;
+  for (int64_t ts = 0; ts < 20000; ts += 100) {
+    insertKeys(pVnode, 1, version++, ts, ts + 100, 1, false, expected);
+  }
+  checkRows(pVnode, 1, expected);
+
+  // a submit of one row at a time
+  for (int64_t ts = 20000; ts < 21000; ts++) {
+    insertKeys(pVnode, 1, version++, ts, ts + 1, 1, false, expected);
+  }
+  checkRows(pVnode, 1, expected);
+
+  memVnodeClose(pVnode);
+}
+
+// submits before, between and on the keys of the table go through the search, the appends after them do not
+TEST(testCase, memTableOutOfOrderTest) {
+  SMemVnode *pVnode = NULL;
+  SKeyList   expected;
+  ASSERT_EQ(memVnodeOpen(64 << 20, false, &pVnode), 0);
+
+  int64_t version = 1;
+  insertKeys(pVnode, 1, version++, 10000, 20000, 2, false, expected);
+  // the first key is an append, the rest are not
+  insertKeys(pVnode, 1, version++, 19999, 30000, 2, false, expected);
+  // before the first key
+  insertKeys(pVnode, 1, version++, 0, 5000, 1, false, expected);
+  // appends again
+  insertKeys(pVnode, 1, version++, 30000, 31000, 1, false, expected);
+  // keys already in the table with a newer version
+  insertKeys(pVnode, 1, version++, 10000, 12000, 4, false, expected);
+  // the last key with a newer version is an append as well
+  insertKeys(pVnode, 1, version++, 30999, 31001, 1, false, expected);
+  checkRows(pVnode, 1, expected);
+
+  // single row submits alternating between the tail and the middle
+  for (int64_t ts = 40000; ts < 41000; ts++) {
+    insertKeys(pVnode, 1, version++, ts, ts + 1, 1, false, expected);
+    insertKeys(pVnode, 1, version++, ts - 35000, ts - 34999, 1, false, expected);
+  }
+  checkRows(pVnode, 1, expected);
+
+  memVnodeClose(pVnode);
+}
+
+// the rows of tables do not mix
+TEST(testCase, memTableTablesTest) {
+  SMemVnode *pVnode = NULL;
+  SKeyList   expected[3];
+  ASSERT_EQ(memVnodeOpen(64 << 20, false, &pVnode), 0);
+
+  int64_t version = 1;
+  for (int64_t ts = 0; ts < 3000; ts += 300) {
+    for (int64_t uid = 1; uid <= 3; uid++) {
+      insertKeys(pVnode, uid, version++, ts + uid, ts + 300, uid, false, expected[uid - 1]);
+      insertKeys(pVnode, uid, version++, ts, ts + 1, 1, false, expected[uid - 1]);
+    }
+  }
+  for (int64_t uid = 1; uid <= 3; uid++) {
+    checkRows(pVnode, uid, expected[uid - 1]);
+  }
+
+  memVnodeClose(pVnode);
+}
+
+// the nodes of a column format submit come from one allocation, in row order, wherever the rows are linked
+TEST(testCase, memTableColumnSubmitTest) {
+  SMemVnode *pVnode = NULL;
+  SKeyList   expected;
+  ASSERT_EQ(memVnodeOpen(64 << 20, false, &pVnode), 0);
+
+  int64_t version = 1;
+  for (int64_t ts = 100000; ts < 200000; ts += 10000) {
+    insertKeys(pVnode, 1, version++, ts, ts + 10000, 1, true, expected);
+  }
+  checkRows(pVnode, 1, expected);
+
+  // between the rows of the submits before, with the first row appended or not
+  insertKeys(pVnode, 1, version++, 150000, 250000, 3, true, expected);
+  insertKeys(pVnode, 1, version++, 0, 300000, 7, true, expected);
+  // one row submits
+  insertKeys(pVnode, 1, version++, 300000, 300001, 1, true, expected);
+  insertKeys(pVnode, 1, version++, 5, 6, 1, true, expected);
+  checkRows(pVnode, 1, expected);
+
+  // mixed with row format submits
+  for (int64_t ts = 300000; ts < 310000; ts += 1000) {
+    insertKeys(pVnode, 1, version++, ts + 1, ts + 500, 2, false, expected);
+    insertKeys(pVnode, 1, version++, ts + 2, ts + 1000, 2, true, expected);
+    insertKeys(pVnode, 1, version++, ts - 200000, ts - 199000, 5, true, expected);
+  }
+  checkRows(pVnode, 1, expected);
+
+  memVnodeClose(pVnode);
+}
+
+// a column format submit larger than the anchor node of the buffer pool
+TEST(testCase, memTableLargeColumnSubmitTest) {
+  SMemVnode *pVnode = NULL;
+  SKeyList   expected;
+  ASSERT_EQ(memVnodeOpen(3 << 20, false, &pVnode), 0);
+
+  insertKeys(pVnode, 1, 1, 0, 200000, 2, true, expected);
+  insertKeys(pVnode, 1, 2, 1, 200000, 2, true, expected);
+  checkRows(pVnode, 1, expected);
+
+  memVnodeClose(pVnode);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tsdbPrefetchTestUtil.h"
+
+using namespace std;
+
+#define PREFETCH_PAGE_SIZE  4096
+#define PREFETCH_BLOCK_SIZE 10000  // a block spans the pages like the blocks of a data file
+#define PREFETCH_BLOCKS     40
+
+typedef struct {
+  SPageTsdb *pTsdb;
+  char       path[2][PATH_MAX];
+} SPageFiles;
+
+static uint8_t getByte(int32_t file, int64_t offset) { return (uint8_t)(file * 131 + offset * 7 + offset / 251); }
+
+// a file of PREFETCH_BLOCKS blocks written by the page-wise file writer, so every page has its checksum
+static void writeFile(SPageTsdb *pTsdb, const char *path, int32_t file) {
+  SPageFile *pFD = NULL;
+  ASSERT_EQ(pageFileOpen(pTsdb, path, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, NULL, &pFD), 0);
+
+  vector<uint8_t> buf(PREFETCH_BLOCK_SIZE);
+  for (int64_t offset = 0; offset < PREFETCH_BLOCK_SIZE * PREFETCH_BLOCKS; offset += PREFETCH_BLOCK_SIZE) {
+    for (int32_t i = 0; i < PREFETCH_BLOCK_SIZE; ++i) {
+      buf[i] = getByte(file, offset + i);
+    }
+    ASSERT_EQ(pageFileWrite(pFD, offset, buf.data(), PREFETCH_BLOCK_SIZE), 0);
+  }
+  ASSERT_EQ(pageFileSync(pFD), 0);
+  pageFileClose(&pFD);
+}
+
+// two files of blocks for a test, removed by closePageFiles
+static void openPageFiles(SPageFiles *pFiles) {
+  pFiles->pTsdb = pageTsdbOpen(PREFETCH_PAGE_SIZE);
+  for (int32_t i = 0; i < 2; ++i) {
+    snprintf(pFiles->path[i], sizeof(pFiles->path[i]), "%s/tsdbPrefetchTest%d.data", TD_TMP_DIR_PATH, i);
+    writeFile(pFiles->pTsdb, pFiles->path[i], i);
+  }
+}
+
+static void closePageFiles(SPageFiles *pFiles) {
+  for (int32_t i = 0; i < 2; ++i) {
+    taosRemoveFile(pFiles->path[i]);
+  }
+  pageTsdbClose(pFiles->pTsdb);
+}
+
+static SPageFile *openFile(SPageTsdb *pTsdb, const char *path, TdAIOPtr pAio) {
+  SPageFile *pFD = NULL;
+  EXPECT_EQ(pageFileOpen(pTsdb, path, TD_FILE_READ, pAio, &pFD), 0);
+  return pFD;
+}
+
+static void checkBlock(SPageFile *pFD, int32_t file, int32_t block) {
+  vector<uint8_t> buf(PREFETCH_BLOCK_SIZE);
+  int64_t         offset = (int64_t)block * PREFETCH_BLOCK_SIZE;
+  ASSERT_EQ(pageFileRead(pFD, offset, buf.data(), PREFETCH_BLOCK_SIZE), 0);
+  for (int32_t i = 0; i < PREFETCH_BLOCK_SIZE; ++i) {
+    ASSERT_EQ(buf[i], getByte(file, offset + i)) << "file:" << file << " block:" << block << " byte:" << i;
+  }
+}
+
+static void shareRing(SPageFiles *pFiles, int32_t flags) {
+  TdAIOPtr pAio = taosAIOOpen(32, flags);
+  ASSERT_NE(pAio, nullptr);
+
+  SPageFile *pFD[2] = {openFile(pFiles->pTsdb, pFiles->path[0], pAio), openFile(pFiles->pTsdb, pFiles->path[1], pAio)};
+  ASSERT_NE(pFD[0], nullptr);
+  ASSERT_NE(pFD[1], nullptr);
+
+  for (int32_t block = 0; block < PREFETCH_BLOCKS; block += 4) {
+    for (int32_t i = 0; i < 4; ++i) {
+      ASSERT_EQ(pageFilePrefetch(pFD[0], (int64_t)(block + i) * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+      ASSERT_EQ(pageFilePrefetch(pFD[1], (int64_t)(block + i) * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    }
+    for (int32_t i = 0; i < 4; ++i) {
+      checkBlock(pFD[1], 1, block + i);
+      checkBlock(pFD[0], 0, block + i);
+    }
+  }
+
+  // a file with reads in flight is closed, the other one takes its pages from the ring afterwards
+  for (int32_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(pageFilePrefetch(pFD[1], (int64_t)(i + 8) * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    ASSERT_EQ(pageFilePrefetch(pFD[0], (int64_t)i * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+  }
+  pageFileClose(&pFD[0]);
+  for (int32_t i = 0; i < 8; ++i) {
+    checkBlock(pFD[1], 1, i + 8);
+  }
+  pageFileClose(&pFD[1]);
+  ASSERT_EQ(taosAIOGetInflight(pAio), 0);
+  taosAIOClose(pAio);
+}
+
+static void readBeyondSlots(SPageFiles *pFiles, int32_t flags) {
+  TdAIOPtr pAio = taosAIOOpen(32, flags);
+  TdAIOPtr pSmall = taosAIOOpen(2, flags);
+  ASSERT_NE(pAio, nullptr);
+  ASSERT_NE(pSmall, nullptr);
+
+  SPageFile *pFD[2] = {openFile(pFiles->pTsdb, pFiles->path[0], pAio),
+                       openFile(pFiles->pTsdb, pFiles->path[1], pSmall)};
+  ASSERT_NE(pFD[0], nullptr);
+  ASSERT_NE(pFD[1], nullptr);
+
+  for (int32_t block = 0; block < PREFETCH_BLOCKS; ++block) {
+    ASSERT_EQ(pageFilePrefetch(pFD[0], (int64_t)block * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    ASSERT_EQ(pageFilePrefetch(pFD[1], (int64_t)block * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    ASSERT_LE(taosAIOGetInflight(pSmall), 2);
+  }
+  for (int32_t block = 0; block < PREFETCH_BLOCKS; ++block) {
+    checkBlock(pFD[0], 0, block);
+    checkBlock(pFD[1], 1, block);
+  }
+
+  // the pages of a block read ahead twice are taken once
+  for (int32_t block = PREFETCH_BLOCKS - 1; block >= 0; --block) {
+    ASSERT_EQ(pageFilePrefetch(pFD[0], (int64_t)block * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    ASSERT_EQ(pageFilePrefetch(pFD[0], (int64_t)block * PREFETCH_BLOCK_SIZE, PREFETCH_BLOCK_SIZE), 0);
+    checkBlock(pFD[0], 0, block);
+  }
+
+  pageFileClose(&pFD[0]);
+  pageFileClose(&pFD[1]);
+  taosAIOClose(pSmall);
+  taosAIOClose(pAio);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+// the blocks of two files are read ahead on one ring, each completion goes to the file it was issued for
+TEST(testCase, prefetchShareRingTest) {
+  SPageFiles files;
+  openPageFiles(&files);
+  shareRing(&files, 0);
+  shareRing(&files, TD_AIO_THREAD_POOL);
+  closePageFiles(&files);
+}
+
+// more ranges than the slots of a file or the depth of the ring are read ahead before any of them is read, the
+// ranges which find no slot are skipped and their pages are read synchronously
+TEST(testCase, prefetchBeyondSlotsTest) {
+  SPageFiles files;
+  openPageFiles(&files);
+  readBeyondSlots(&files, 0);
+  readBeyondSlots(&files, TD_AIO_THREAD_POOL);
+  closePageFiles(&files);
+}
+
+// a file without a ring is never read ahead
+TEST(testCase, prefetchNoRingTest) {
+  SPageFiles files;
+  openPageFiles(&files);
+
+  SPageFile *pFD = openFile(files.pTsdb, files.path[0], NULL);
+  ASSERT_NE(pFD, nullptr);
+  ASSERT_EQ(pageFilePrefetch(pFD, 0, PREFETCH_BLOCK_SIZE), 0);
+  ASSERT_FALSE(pageFileHasSlots(pFD));
+  checkBlock(pFD, 0, 0);
+  pageFileClose(&pFD);
+  closePageFiles(&files);
+}
+
+#pragma GCC diagnostic pop
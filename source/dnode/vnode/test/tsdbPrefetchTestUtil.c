@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tsdbPrefetchTestUtil.h"
+#include "tsdbDef.h"
+#include "vnodeInt.h"
+
+struct SPageTsdb {
+  STsdb  tsdb;
+  SVnode vnode;
+};
+
+SPageTsdb *pageTsdbOpen(int32_t szPage) {
+  SPageTsdb *pTsdb = taosMemoryCalloc(1, sizeof(SPageTsdb));
+  if (pTsdb == NULL) {
+    return NULL;
+  }
+
+  pTsdb->vnode.config.tsdbPageSize = szPage;
+  pTsdb->tsdb.pVnode = &pTsdb->vnode;
+  return pTsdb;
+}
+
+void pageTsdbClose(SPageTsdb *pTsdb) { taosMemoryFree(pTsdb); }
+
+int32_t pageFileOpen(SPageTsdb *pTsdb, const char *path, int32_t flag, TdAIOPtr pAio, SPageFile **ppFD) {
+  STsdbFD *pFD = NULL;
+  int32_t  code = tsdbOpenFile(path, &pTsdb->tsdb, flag, &pFD);
+  if (code == 0) {
+    pFD->pAio = pAio;
+  }
+  *ppFD = (SPageFile *)pFD;
+  return code;
+}
+
+void pageFileClose(SPageFile **ppFD) { tsdbCloseFile((STsdbFD **)ppFD); }
+
+int32_t pageFileWrite(SPageFile *pFD, int64_t offset, const uint8_t *pBuf, int64_t size) {
+  return tsdbWriteFile((STsdbFD *)pFD, offset, pBuf, size);
+}
+
+int32_t pageFileSync(SPageFile *pFD) { return tsdbFsyncFile((STsdbFD *)pFD); }
+
+int32_t pageFileRead(SPageFile *pFD, int64_t offset, uint8_t *pBuf, int64_t size) {
+  return tsdbReadFile((STsdbFD *)pFD, offset, pBuf, size, 0);
+}
+
+int32_t pageFilePrefetch(SPageFile *pFD, int64_t offset, int64_t size) {
+  return tsdbPrefetchFile((STsdbFD *)pFD, offset, size);
+}
+
+bool pageFileHasSlots(SPageFile *pFD) { return ((STsdbFD *)pFD)->pPrefetch != NULL; }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_VNODE_TSDB_PREFETCH_TEST_UTIL_H_
+#define _TD_VNODE_TSDB_PREFETCH_TEST_UTIL_H_
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the page-wise files of tsdb for the tests in C++, which cannot include tsdb.h
+typedef struct SPageTsdb SPageTsdb;
+typedef struct SPageFile SPageFile;
+
+SPageTsdb *pageTsdbOpen(int32_t szPage);
+void       pageTsdbClose(SPageTsdb *pTsdb);
+
+int32_t pageFileOpen(SPageTsdb *pTsdb, const char *path, int32_t flag, TdAIOPtr pAio, SPageFile **ppFD);
+void    pageFileClose(SPageFile **ppFD);
+int32_t pageFileWrite(SPageFile *pFD, int64_t offset, const uint8_t *pBuf, int64_t size);
+int32_t pageFileSync(SPageFile *pFD);
+int32_t pageFileRead(SPageFile *pFD, int64_t offset, uint8_t *pBuf, int64_t size);
+int32_t pageFilePrefetch(SPageFile *pFD, int64_t offset, int64_t size);
+bool    pageFileHasSlots(SPageFile *pFD);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_VNODE_TSDB_PREFETCH_TEST_UTIL_H_*/
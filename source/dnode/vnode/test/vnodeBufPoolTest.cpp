@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "vnodeTestUtil.h"
+
+using namespace std;
+
+typedef struct {
+  uint8_t *p;
+  int32_t  size;
+} SBufAlloc;
+
+// fill each allocation with the bytes of its owner and sequence number
+static uint8_t allocByte(int32_t owner, int32_t seq, int32_t i) { return (uint8_t)(owner * 67 + seq * 13 + i); }
+
+static void allocBufs(SMemVnode *pVnode, int32_t owner, int32_t nAlloc, vector<SBufAlloc> *pAllocs,
+                      atomic<int64_t> *pSize, atomic<bool> *pStart) {
+  uint32_t seed = owner + 1;
+  while (!*pStart) {
+  }
+  for (int32_t seq = 0; seq < nAlloc; seq++) {
+    int32_t size = taosRandR(&seed) % 200 + 1;
+    bool    aligned = seq % 2;
+    uint8_t *p = (uint8_t *)memVnodeMalloc(pVnode, size, aligned);
+    if (p == NULL || (aligned && ((uintptr_t)p & 7))) {
+      pAllocs->clear();
+      return;
+    }
+
+    for (int32_t i = 0; i < size; i++) {
+      p[i] = allocByte(owner, seq, i);
+    }
+    pAllocs->push_back({p, size});
+    *pSize += size;
+  }
+}
+
+static void checkBufs(int32_t owner, const vector<SBufAlloc> &allocs) {
+  for (int32_t seq = 0; seq < allocs.size(); seq++) {
+    for (int32_t i = 0; i < allocs[seq].size; i++) {
+      ASSERT_EQ(allocs[seq].p[i], allocByte(owner, seq, i)) << "owner:" << owner << " seq:" << seq << " byte:" << i;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+// alignment padding goes to the waste, allocations beyond the anchor node to the overflow
+TEST(testCase, bufPoolStatTest) {
+  SMemVnode *pVnode = NULL;
+  int64_t    used = 0, waste = 0, overflow = 0;
+  ASSERT_EQ(memVnodeOpen(3 << 20, false, &pVnode), 0);
+
+  uint8_t *p1 = (uint8_t *)memVnodeMalloc(pVnode, 3, false);
+  uint8_t *p2 = (uint8_t *)memVnodeMalloc(pVnode, 8, true);
+  ASSERT_NE(p1, nullptr);
+  ASSERT_NE(p2, nullptr);
+  ASSERT_EQ((uintptr_t)p2 & 7, 0);
+  memVnodeGetBufStat(pVnode, &used, &waste, &overflow);
+  ASSERT_EQ(waste, p2 - p1 - 3);
+  ASSERT_EQ(used, 11 + waste);
+  ASSERT_EQ(overflow, 0);
+
+  // the anchor node holds 1MB
+  ASSERT_NE(memVnodeMalloc(pVnode, 2 << 20, false), nullptr);
+  memVnodeGetBufStat(pVnode, &used, &waste, &overflow);
+  ASSERT_EQ(overflow, 2 << 20);
+  ASSERT_GT(waste, p2 - p1 - 3);
+  ASSERT_EQ(used, 11 + (2 << 20) + waste);
+
+  memVnodeClose(pVnode);
+}
+
+static void concurrentMalloc(int64_t szBuf) {
+  const int32_t nThread = 8;
+  const int32_t nAlloc = 20000;
+
+  SMemVnode                *pVnode = NULL;
+  vector<vector<SBufAlloc>> allocs(nThread);
+  vector<thread>            threads;
+  atomic<int64_t>           size(0);
+  atomic<bool>              start(false);
+  int64_t                   used = 0, waste = 0, overflow = 0;
+  ASSERT_EQ(memVnodeOpen(szBuf, true, &pVnode), 0);
+
+  for (int32_t i = 0; i < nThread; i++) {
+    threads.push_back(thread(allocBufs, pVnode, i, nAlloc, &allocs[i], &size, &start));
+  }
+  start = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (int32_t i = 0; i < nThread; i++) {
+    ASSERT_EQ(allocs[i].size(), nAlloc);
+    checkBufs(i, allocs[i]);
+  }
+
+  memVnodeGetBufStat(pVnode, &used, &waste, &overflow);
+  ASSERT_EQ(used, size + waste);
+  if (size > szBuf / 3) {
+    ASSERT_GT(overflow, 0);
+    ASSERT_LT(overflow, size);
+  } else {
+    ASSERT_EQ(overflow, 0);
+  }
+
+  memVnodeClose(pVnode);
+}
+
+// writers of a rsma vnode allocate concurrently, from the anchor node and beyond it, and never share a byte
+TEST(testCase, bufPoolConcurrentMallocTest) {
+  for (int32_t round = 0; round < 4; round++) {
+    concurrentMalloc(96 << 20);
+    concurrentMalloc(3 << 20);
+  }
+}
+
+#pragma GCC diagnostic pop
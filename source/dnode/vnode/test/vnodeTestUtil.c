@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vnodeTestUtil.h"
+#include "tsdb.h"
+#include "vnd.h"
+
+#define MEM_VNODE_SL_LEVEL 5
+
+#define SL_NODE_FORWARD(n, l)  ((n)->forwards[l])
+#define SL_NODE_BACKWARD(n, l) ((n)->forwards[(n)->level + (l)])
+
+struct SMemVnode {
+  SVnode    vnode;
+  STsdb     tsdb;
+  STSchema *pTSchema;
+};
+
+int32_t memVnodeOpen(int64_t szBuf, bool isRsma, SMemVnode **ppVnode) {
+  int32_t    code = 0;
+  SMemVnode *pVnode = taosMemoryCalloc(1, sizeof(SMemVnode));
+  if (pVnode == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  SSchema aSchema[] = {
+      {.colId = PRIMARYKEY_TIMESTAMP_COL_ID, .type = TSDB_DATA_TYPE_TIMESTAMP, .bytes = 8},
+      {.colId = PRIMARYKEY_TIMESTAMP_COL_ID + 1, .type = TSDB_DATA_TYPE_BIGINT, .bytes = 8},
+  };
+  pVnode->pTSchema = tBuildTSchema(aSchema, 2, 1);
+  if (pVnode->pTSchema == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  pVnode->vnode.config.vgId = 2;
+  pVnode->vnode.config.szBuf = szBuf;
+  pVnode->vnode.config.isRsma = isRsma;
+  pVnode->vnode.config.tsdbCfg.slLevel = MEM_VNODE_SL_LEVEL;
+  taosThreadMutexInit(&pVnode->vnode.mutex, NULL);
+  taosThreadCondInit(&pVnode->vnode.poolNotEmpty, NULL);
+  if (vnodeOpenBufPool(&pVnode->vnode) < 0) {
+    code = terrno;
+    goto _exit;
+  }
+
+  // the pool in use is referred by the vnode as on a vnode begin
+  pVnode->vnode.inUse = pVnode->vnode.freeList;
+  pVnode->vnode.freeList = pVnode->vnode.inUse->freeNext;
+  pVnode->vnode.inUse->freeNext = NULL;
+  pVnode->vnode.inUse->nRef = 1;
+
+  pVnode->tsdb.pVnode = &pVnode->vnode;
+  code = tsdbMemTableCreate(&pVnode->tsdb, &pVnode->tsdb.mem);
+
+_exit:
+  if (code && pVnode) {
+    memVnodeClose(pVnode);
+    pVnode = NULL;
+  }
+  *ppVnode = pVnode;
+  return code;
+}
+
+void memVnodeClose(SMemVnode *pVnode) {
+  if (pVnode == NULL) return;
+
+  if (pVnode->tsdb.mem) {
+    tsdbMemTableDestroy(pVnode->tsdb.mem, false);
+  }
+  vnodeCloseBufPool(&pVnode->vnode);
+  taosThreadCondDestroy(&pVnode->vnode.poolNotEmpty);
+  taosThreadMutexDestroy(&pVnode->vnode.mutex);
+  taosMemoryFree(pVnode->pTSchema);
+  taosMemoryFree(pVnode);
+}
+
+static int32_t memVnodeBuildRows(SMemVnode *pVnode, const int64_t *aKey, int32_t nRow, SArray **paRowP) {
+  int32_t code = 0;
+  SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+  SArray *aRowP = taosArrayInit(nRow, sizeof(SRow *));
+  if (aColVal == NULL || aRowP == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (int32_t i = 0; i < nRow; i++) {
+    SRow *pRow = NULL;
+
+    taosArrayClear(aColVal);
+    taosArrayPush(aColVal, &COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP,
+                                          ((SValue){.val = aKey[i]})));
+    taosArrayPush(aColVal, &COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID + 1, TSDB_DATA_TYPE_BIGINT,
+                                          ((SValue){.val = aKey[i] * 10})));
+    code = tRowBuild(aColVal, pVnode->pTSchema, &pRow);
+    if (code) goto _exit;
+    taosArrayPush(aRowP, &pRow);
+  }
+
+_exit:
+  taosArrayDestroy(aColVal);
+  if (code) {
+    taosArrayDestroyP(aRowP, (FDelete)tRowDestroy);
+    aRowP = NULL;
+  }
+  *paRowP = aRowP;
+  return code;
+}
+
+static int32_t memVnodeBuildCols(const int64_t *aKey, int32_t nRow, SArray **paCol) {
+  int32_t code = 0;
+  SArray *aCol = taosArrayInit(2, sizeof(SColData));
+  if (aCol == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  SColData *pTsCol = taosArrayReserve(aCol, 1);
+  SColData *pValCol = taosArrayReserve(aCol, 1);
+  tColDataInit(pTsCol, PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, 0);
+  tColDataInit(pValCol, PRIMARYKEY_TIMESTAMP_COL_ID + 1, TSDB_DATA_TYPE_BIGINT, 0);
+  for (int32_t i = 0; i < nRow; i++) {
+    code = tColDataAppendValue(
+        pTsCol, &COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, ((SValue){.val = aKey[i]})));
+    if (code) goto _exit;
+    code = tColDataAppendValue(pValCol, &COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID + 1, TSDB_DATA_TYPE_BIGINT,
+                                                       ((SValue){.val = aKey[i] * 10})));
+    if (code) goto _exit;
+  }
+
+_exit:
+  if (code) {
+    taosArrayDestroyEx(aCol, tColDataDestroy);
+    aCol = NULL;
+  }
+  *paCol = aCol;
+  return code;
+}
+
+int32_t memVnodeInsert(SMemVnode *pVnode, int64_t uid, int64_t version, const int64_t *aKey, int32_t nRow,
+                       bool colFmt) {
+  int32_t       code = 0;
+  int32_t       affectedRows = 0;
+  SSubmitTbData submitTbData = {.suid = 0, .uid = uid, .sver = 1};
+
+  if (colFmt) {
+    submitTbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    code = memVnodeBuildCols(aKey, nRow, &submitTbData.aCol);
+  } else {
+    code = memVnodeBuildRows(pVnode, aKey, nRow, &submitTbData.aRowP);
+  }
+  if (code) return code;
+
+  code = tsdbInsertTableData(&pVnode->tsdb, version, &submitTbData, &affectedRows);
+  if (code == 0 && affectedRows != nRow) {
+    code = TSDB_CODE_FAILED;
+  }
+
+  if (colFmt) {
+    taosArrayDestroyEx(submitTbData.aCol, tColDataDestroy);
+  } else {
+    taosArrayDestroyP(submitTbData.aRowP, (FDelete)tRowDestroy);
+  }
+  return code;
+}
+
+int32_t memVnodeScan(SMemVnode *pVnode, int64_t uid, bool backward, int64_t *aKey, int64_t *aVersion, int32_t maxRow) {
+  STbData    *pTbData = tsdbGetTbDataFromMemTable(pVnode->tsdb.mem, 0, uid);
+  STbDataIter iter = {0};
+  int32_t     nRow = 0;
+
+  if (pTbData == NULL) return 0;
+
+  tsdbTbDataIterOpen(pTbData, NULL, backward, &iter);
+  for (TSDBROW *pRow; nRow < maxRow && (pRow = tsdbTbDataIterGet(&iter)) != NULL; tsdbTbDataIterNext(&iter)) {
+    aKey[nRow] = TSDBROW_TS(pRow);
+    aVersion[nRow] = TSDBROW_VERSION(pRow);
+    nRow++;
+  }
+  return nRow;
+}
+
+int64_t memVnodeCountRows(SMemVnode *pVnode, int64_t uid) {
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pVnode->tsdb.mem, 0, uid);
+  return pTbData ? tsdbCountTbDataRows(pTbData) : 0;
+}
+
+bool memVnodeCheckSkipList(SMemVnode *pVnode, int64_t uid) {
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pVnode->tsdb.mem, 0, uid);
+  if (pTbData == NULL) return false;
+
+  SMemSkipList *pSl = &pTbData->sl;
+  for (int8_t iLevel = 0; iLevel < pSl->maxLevel; iLevel++) {
+    SMemSkipListNode *pPrev = pSl->pHead;
+    int64_t           nNode = 0;
+
+    for (SMemSkipListNode *pNode = SL_NODE_FORWARD(pSl->pHead, iLevel);; pNode = SL_NODE_FORWARD(pNode, iLevel)) {
+      if (pNode == NULL || pNode->level <= iLevel || SL_NODE_BACKWARD(pNode, iLevel) != pPrev) {
+        return false;
+      }
+      if (pNode == pSl->pTail) break;
+
+      TSDBROW row = pNode->flag == TSDBROW_ROW_FMT ? tsdbRowFromTSRow(pNode->version, pNode->pData)
+                                                    : tsdbRowFromBlockData(pNode->pData, pNode->iRow);
+      if (pPrev != pSl->pHead) {
+        TSDBROW prevRow = pPrev->flag == TSDBROW_ROW_FMT ? tsdbRowFromTSRow(pPrev->version, pPrev->pData)
+                                                          : tsdbRowFromBlockData(pPrev->pData, pPrev->iRow);
+        TSDBKEY key = TSDBROW_KEY(&row);
+        TSDBKEY prevKey = TSDBROW_KEY(&prevRow);
+        if (tsdbKeyCmprFn(&prevKey, &key) >= 0) {
+          return false;
+        }
+      }
+
+      pPrev = pNode;
+      nNode++;
+    }
+
+    // every node is on level 0
+    if (iLevel == 0 && nNode != pSl->size) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void *memVnodeMalloc(SMemVnode *pVnode, int32_t size, bool aligned) {
+  if (aligned) {
+    return vnodeBufPoolMallocAligned(pVnode->vnode.inUse, size);
+  }
+  return vnodeBufPoolMalloc(pVnode->vnode.inUse, size);
+}
+
+void memVnodeGetBufStat(SMemVnode *pVnode, int64_t *used, int64_t *waste, int64_t *overflow) {
+  vnodeGetBufPoolStat(&pVnode->vnode, used, waste, overflow);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_VNODE_TEST_UTIL_H_
+#define _TD_VNODE_TEST_UTIL_H_
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// a vnode with its buffer pools and a memtable only, for the tests in C++ which cannot include vnodeInt.h
+typedef struct SMemVnode SMemVnode;
+
+int32_t memVnodeOpen(int64_t szBuf, bool isRsma, SMemVnode **ppVnode);
+void    memVnodeClose(SMemVnode *pVnode);
+
+// insert rows of keys aKey into table uid by a row format or a column format submit
+int32_t memVnodeInsert(SMemVnode *pVnode, int64_t uid, int64_t version, const int64_t *aKey, int32_t nRow,
+                       bool colFmt);
+// scan the rows of table uid in the memtable, return the number of rows
+int32_t memVnodeScan(SMemVnode *pVnode, int64_t uid, bool backward, int64_t *aKey, int64_t *aVersion, int32_t maxRow);
+int64_t memVnodeCountRows(SMemVnode *pVnode, int64_t uid);
+// check the skiplist of table uid: keys ascend on each level and every backward link mirrors a forward one
+bool memVnodeCheckSkipList(SMemVnode *pVnode, int64_t uid);
+
+// allocate from the buffer pool in use
+void *memVnodeMalloc(SMemVnode *pVnode, int32_t size, bool aligned);
+void  memVnodeGetBufStat(SMemVnode *pVnode, int64_t *used, int64_t *waste, int64_t *overflow);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_VNODE_TEST_UTIL_H_*/
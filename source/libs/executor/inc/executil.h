@@ -218,4 +218,23 @@ SNodeList* makeColsNodeArrFromSortKeys(SNodeList* pSortKeys);
 
 int32_t extractKeysLen(const SArray* keys);
 
+// partition of each row of a block spilled by key partitions, and the rows of the partition being written
+typedef struct SSpillRowBuf {
+  int32_t rowCap;
+  int8_t* rowPart;  // -1 if the row is not spilled
+  bool*   rowSel;
+} SSpillRowBuf;
+
+/**
+ * @brief create the disk based buffer rows like pSrc are spilled to, and the block to read them back
+ */
+int32_t createSpillBuf(SDiskbasedBuf** ppBuf, SSDataBlock** ppBlock, SSDataBlock* pSrc, int32_t numOfPages,
+                       const char* id);
+/**
+ * @brief write the rows of pBlock to new pages of pBuf, and append the ids of the pages to pPageIdList
+ */
+int32_t addBlockToSpillBuf(SDiskbasedBuf* pBuf, SSDataBlock* pBlock, SArray* pPageIdList);
+int32_t ensureSpillRowBuf(SSpillRowBuf* pRowBuf, int32_t rows);
+void    destroySpillRowBuf(SSpillRowBuf* pRowBuf);
+
 #endif  // TDENGINE_EXECUTIL_H
@@ -143,6 +143,7 @@ typedef struct SLoadRemoteDataInfo {
   uint64_t totalSize;     // total load bytes from remote
   uint64_t totalRows;     // total number of rows
   uint64_t totalElapsed;  // total elapsed time
+  uint64_t waitElapsed;   // time blocked on waiting for the fetch responses
 } SLoadRemoteDataInfo;
 
 typedef struct SLimitInfo {
@@ -196,6 +197,7 @@ typedef struct SExchangeInfo {
   bool         seqLoadData;      // sequential load data or not, false by default
   bool         dynamicOp;
   int32_t      current;
+  int32_t      roundStartIdx;  // the source a round of the concurrent load starts from
   SLoadRemoteDataInfo loadInfo;
   uint64_t            self;
   SLimitInfo          limitInfo;
@@ -262,6 +264,7 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SArray*         pFilterColIds;  // data columns used by the filter, loaded before the others
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -820,6 +823,8 @@ int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* de
 extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo);
+int32_t doFilterEvaluate(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColumnInfoData** p, int32_t* status);
+void    doFilterApply(SSDataBlock* pBlock, SColumnInfoData* p, int32_t status, SColMatchInfo* pColMatchInfo);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, SExecTaskInfo* pTask, STableMetaCacheInfo* pCache);
 
@@ -841,6 +846,8 @@ int32_t projectApplyFunctions(SExprInfo* pExpr, SSDataBlock* pResult, SSDataBloc
 void setInputDataBlock(SExprSupp* pExprSupp, SSDataBlock* pBlock, int32_t order, int32_t scanFlag, bool createDummyCol);
 
 int32_t checkForQueryBuf(size_t numOfTables);
+int64_t reserveQueryBufBytes(int64_t maxSize);
+void    releaseQueryBufBytes(int64_t size);
 
 int32_t createDataSinkParam(SDataSinkNode* pNode, void** pParam, SExecTaskInfo* pTask, SReadHandle* readHandle);
 
@@ -20,6 +20,14 @@ extern "C" {
 #endif
 
 #define HASH_JOIN_DEFAULT_PAGE_SIZE 10485760
+#define HASH_JOIN_MAX_BUILD_MEM_SIZE 1073741824L
+#define HASH_JOIN_MIN_BUILD_MEM_SIZE 1048576L
+#define HASH_JOIN_PARTITION_NUM 16
+#define HASH_JOIN_SPILL_BUF_PAGES 256
+#define HASH_JOIN_BLOOM_MIN_ENTRIES 1048576
+#define HASH_JOIN_BLOOM_MAX_ENTRIES 67108864
+#define HASH_JOIN_BLOOM_ERROR_RATE 0.01
+#define HASH_JOIN_BLOOM_MEM_RATIO 8
 
 #pragma pack(push, 1) 
 typedef struct SBufRowInfo {
@@ -90,8 +98,33 @@ typedef struct SHJoinExecInfo {
   int64_t probeBlkRows;
   int64_t resRows;
   int64_t expectRows;
+  int64_t spillBuildRows;
+  int64_t spillProbeRows;
+  int64_t bloomSkipRows;
+  int64_t spillRounds;
 } SHJoinExecInfo;
 
+typedef struct SHJoinPartition {
+  SArray* pBuildPages;
+  SArray* pProbePages;
+} SHJoinPartition;
+
+typedef struct SHJoinSpillCtx {
+  bool            spilled;
+  bool            probeDone;
+  bool            roundLoaded;
+  int32_t         partIdx;
+  int32_t         buildPageIdx;
+  int32_t         probePageIdx;
+  SSpillRowBuf    rowBuf;
+  SBloomFilter*   pBloom;
+  SDiskbasedBuf*  pBuildBuf;
+  SDiskbasedBuf*  pProbeBuf;
+  SSDataBlock*    pBuildBlk;
+  SSDataBlock*    pProbeBlk;
+  SHJoinPartition parts[HASH_JOIN_PARTITION_NUM];
+} SHJoinSpillCtx;
+
 
 typedef struct SHJoinOperatorInfo {
   int32_t          joinType;
@@ -105,7 +138,11 @@ typedef struct SHJoinOperatorInfo {
   SNode*           pCond;
   SSHashObj*       pKeyHash;
   bool             keyHashBuilt;
+  int64_t          keyHashRows;
+  int64_t          memReserved;
+  int64_t          memLimit;
   SHJoinCtx        ctx;
+  SHJoinSpillCtx   spill;
   SHJoinExecInfo   execInfo;
 } SHJoinOperatorInfo;
 
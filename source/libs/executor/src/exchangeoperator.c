@@ -30,6 +30,10 @@ typedef struct SFetchRspHandleWrapper {
   int32_t  sourceIndex;
 } SFetchRspHandleWrapper;
 
+// the max size of the fetch responses consumed in one round. The ready sources beyond it keep their responses and get
+// no new fetch request until the next round, so that their sinks fill up and the upstream tasks pause.
+#define EXCHANGE_MAX_ROUND_RSP_SIZE (16 * 1048576)
+
 typedef struct SSourceDataInfo {
   int32_t            index;
   SRetrieveTableRsp* pRsp;
@@ -58,6 +62,24 @@ static int32_t handleLimitOffset(SOperatorInfo* pOperator, SLimitInfo* pLimitInf
                                  bool holdDataInBuf);
 static int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo);
 
+static void waitForFetchRsp(SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo) {
+  int64_t st = taosGetTimestampUs();
+  qDebug("prepare wait for ready, %p, %s", pExchangeInfo, GET_TASKID(pTaskInfo));
+  tsem_wait(&pExchangeInfo->ready);
+  pExchangeInfo->loadInfo.waitElapsed += (taosGetTimestampUs() - st);
+}
+
+static bool hasReadySource(SExchangeInfo* pExchangeInfo) {
+  size_t totalSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
+  for (int32_t i = 0; i < totalSources; ++i) {
+    SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
+    if (pDataInfo->status == EX_SOURCE_DATA_READY) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo,
                                            SExecTaskInfo* pTaskInfo) {
   int32_t code = 0;
@@ -71,14 +93,25 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
   SSourceDataInfo* pDataInfo = NULL;
 
   while (1) {
-    qDebug("prepare wait for ready, %p, %s", pExchangeInfo, GET_TASKID(pTaskInfo));
-    tsem_wait(&pExchangeInfo->ready);
+    // the responses arrived during the last round are consumed without waiting, the semaphore may be posted more
+    // times than it is waited, which only leads to an extra round of checking.
+    if (!hasReadySource(pExchangeInfo)) {
+      waitForFetchRsp(pExchangeInfo, pTaskInfo);
+    }
 
     if (isTaskKilled(pTaskInfo)) {
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
 
-    for (int32_t i = 0; i < totalSources; ++i) {
+    // take all the ready responses and send the next fetch requests to these sources at once, instead of one source
+    // per round, so that the round trips of all sources overlap with each other and with the upstream operators.
+    // A round starts from the source where the last one stopped, the ones after the size limit are not starved.
+    int64_t rspSize = 0;
+    int32_t startIdx = pExchangeInfo->roundStartIdx;
+    for (int32_t n = 0; n < totalSources && rspSize < EXCHANGE_MAX_ROUND_RSP_SIZE; ++n) {
+      int32_t i = (startIdx + n) % totalSources;
+      pExchangeInfo->roundStartIdx = (i + 1) % totalSources;
+
       pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
       if (pDataInfo->status == EX_SOURCE_DATA_EXHAUSTED) {
         continue;
@@ -114,7 +147,7 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
                  pExchangeInfo->loadInfo.totalRows, i + 1, totalSources);
           taosMemoryFreeClear(pDataInfo->pRsp);
         }
-        break;
+        continue;
       }
 
       code = doExtractResultBlocks(pExchangeInfo, pDataInfo);
@@ -125,6 +158,7 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
       SRetrieveTableRsp* pRetrieveRsp = pDataInfo->pRsp;
       updateLoadRemoteInfo(pLoadInfo, pRetrieveRsp->numOfRows, pRetrieveRsp->compLen, pDataInfo->startTime, pOperator);
       pDataInfo->totalRows += pRetrieveRsp->numOfRows;
+      rspSize += pRetrieveRsp->compLen;
 
       if (pRsp->completed == 1) {
         pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
@@ -151,9 +185,12 @@ static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeIn
           goto _error;
         }
       }
-      return;
     }  // end loop
 
+    if (taosArrayGetSize(pExchangeInfo->pResultBlockList) > 0) {
+      return;
+    }
+
     int32_t complete1 = getCompletedSources(pExchangeInfo->pSourceDataInfo);
     if (complete1 == totalSources) {
       qDebug("all sources are completed, %s", GET_TASKID(pTaskInfo));
@@ -173,9 +210,10 @@ static SSDataBlock* doLoadRemoteDataImpl(SOperatorInfo* pOperator) {
 
   SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
   if (pOperator->status == OP_EXEC_DONE) {
-    qDebug("%s all %" PRIzu " source(s) are exhausted, total rows:%" PRIu64 " bytes:%" PRIu64 ", elapsed:%.2f ms",
+    qDebug("%s all %" PRIzu " source(s) are exhausted, total rows:%" PRIu64 " bytes:%" PRIu64
+           ", elapsed:%.2f ms, wait:%.2f ms",
            GET_TASKID(pTaskInfo), totalSources, pLoadInfo->totalRows, pLoadInfo->totalSize,
-           pLoadInfo->totalElapsed / 1000.0);
+           pLoadInfo->totalElapsed / 1000.0, pLoadInfo->waitElapsed / 1000.0);
     return NULL;
   }
 
@@ -575,6 +613,9 @@ int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pCo
   if (pColList == NULL) {  // data from other sources
     blockDataCleanup(pRes);
     *pNextStart = (char*)blockDecode(pRes, pData);
+    if (*pNextStart == NULL) {
+      return terrno;
+    }
   } else {  // extract data according to pColList
     char* pStart = pData;
 
@@ -597,7 +638,10 @@ int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pCo
       blockDataAppendColInfo(pBlock, &idata);
     }
 
-    blockDecode(pBlock, pStart);
+    if (blockDecode(pBlock, pStart) == NULL) {
+      blockDataDestroy(pBlock);
+      return TSDB_CODE_INVALID_MSG;
+    }
     blockDataEnsureCapacity(pRes, pBlock->info.rows);
 
     // data from mnode
@@ -617,9 +661,9 @@ void* setAllSourcesCompleted(SOperatorInfo* pOperator) {
 
   SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
   size_t               totalSources = taosArrayGetSize(pExchangeInfo->pSources);
-  qDebug("%s all %" PRIzu " sources are exhausted, total rows: %" PRIu64 ", %.2f Kb, elapsed:%.2f ms",
+  qDebug("%s all %" PRIzu " sources are exhausted, total rows: %" PRIu64 ", %.2f Kb, elapsed:%.2f ms, wait:%.2f ms",
          GET_TASKID(pTaskInfo), totalSources, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0,
-         pLoadInfo->totalElapsed / 1000.0);
+         pLoadInfo->totalElapsed / 1000.0, pLoadInfo->waitElapsed / 1000.0);
 
   setOperatorCompleted(pOperator);
   return NULL;
@@ -709,11 +753,17 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
       return TSDB_CODE_SUCCESS;
     }
 
+    // the request may have been sent in advance when the previous response of this source was consumed
     SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, pExchangeInfo->current);
-    pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+    if (pDataInfo->status != EX_SOURCE_DATA_STARTED && pDataInfo->status != EX_SOURCE_DATA_READY) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+      code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _error;
+      }
+    }
 
-    doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
-    tsem_wait(&pExchangeInfo->ready);
+    waitForFetchRsp(pExchangeInfo, pTaskInfo);
     if (isTaskKilled(pTaskInfo)) {
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
@@ -768,6 +818,19 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
     pDataInfo->totalRows += pRetrieveRsp->numOfRows;
 
     taosMemoryFreeClear(pDataInfo->pRsp);
+
+    // prefetch the next response of this source while the current one is processed by the upstream operators, no need
+    // for the local source since it is executed in the current thread. A dynamic exchange may get new table uids for
+    // the source before its next load, which must go with the next request.
+    if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+      if (!pSource->localExec && !pExchangeInfo->dynamicOp) {
+        code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
+        if (code != TSDB_CODE_SUCCESS) {
+          goto _error;
+        }
+      }
+    }
     return TSDB_CODE_SUCCESS;
   }
 
@@ -800,6 +863,7 @@ int32_t addSingleExchangeSource(SOperatorInfo* pOperator, SExchangeOperatorBasic
     if (pDataInfo->status == EX_SOURCE_DATA_EXHAUSTED) {
       pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
     }
+    taosArrayDestroy(pDataInfo->pSrcUidList);
     pDataInfo->pSrcUidList = taosArrayDup(pBasicParam->uidList, NULL);
     pDataInfo->srcOpType = pBasicParam->srcOpType;
     pDataInfo->tableSeq = pBasicParam->tableSeq;
@@ -2389,3 +2389,87 @@ int32_t extractKeysLen(const SArray* keys) {
   len += sizeof(int8_t) * keyNum; //null flag
   return len;
 }
+
+int32_t createSpillBuf(SDiskbasedBuf** ppBuf, SSDataBlock** ppBlock, SSDataBlock* pSrc, int32_t numOfPages,
+                       const char* id) {
+  if (!osTempSpaceAvailable()) {
+    terrno = TSDB_CODE_NO_DISKSPACE;
+    qError("create %s failed since %s, tempDir:%s", id, terrstr(), tsTempDir);
+    return terrno;
+  }
+
+  int32_t numOfCols = taosArrayGetSize(pSrc->pDataBlock);
+  int32_t pageSize = getProperSortPageSize(blockDataGetRowSize(pSrc), numOfCols);
+  int32_t code = createDiskbasedBuf(ppBuf, pageSize, pageSize * numOfPages, id, tsTempDir);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+  dBufSetPrintInfo(*ppBuf);
+
+  *ppBlock = createOneDataBlock(pSrc, false);
+  if (*ppBlock == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t numOfRows = (pageSize - blockDataGetSerialMetaSize(numOfCols)) / blockDataGetSerialRowSize(*ppBlock);
+  return blockDataEnsureCapacity(*ppBlock, numOfRows);
+}
+
+int32_t addBlockToSpillBuf(SDiskbasedBuf* pBuf, SSDataBlock* pBlock, SArray* pPageIdList) {
+  int32_t pageSize = getBufPageSize(pBuf);
+  int32_t start = 0;
+
+  while (start < pBlock->info.rows) {
+    int32_t stop = 0;
+    blockDataSplitRows(pBlock, pBlock->info.hasVarCol, start, &stop, pageSize);
+    SSDataBlock* p = blockDataExtractBlock(pBlock, start, stop - start + 1);
+    if (p == NULL) {
+      return terrno;
+    }
+
+    int32_t pageId = -1;
+    void*   pPage = getNewBufPage(pBuf, &pageId);
+    if (pPage == NULL) {
+      blockDataDestroy(p);
+      return terrno;
+    }
+
+    taosArrayPush(pPageIdList, &pageId);
+    blockDataToBuf(pPage, p);
+
+    setBufPageDirty(pPage, true);
+    releaseBufPage(pBuf, pPage);
+
+    blockDataDestroy(p);
+    start = stop + 1;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t ensureSpillRowBuf(SSpillRowBuf* pRowBuf, int32_t rows) {
+  if (pRowBuf->rowCap >= rows) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int8_t* rowPart = taosMemoryRealloc(pRowBuf->rowPart, rows * sizeof(*pRowBuf->rowPart));
+  if (NULL == rowPart) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pRowBuf->rowPart = rowPart;
+
+  bool* rowSel = taosMemoryRealloc(pRowBuf->rowSel, rows * sizeof(*pRowBuf->rowSel));
+  if (NULL == rowSel) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pRowBuf->rowSel = rowSel;
+  pRowBuf->rowCap = rows;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+void destroySpillRowBuf(SSpillRowBuf* pRowBuf) {
+  taosMemoryFreeClear(pRowBuf->rowPart);
+  taosMemoryFreeClear(pRowBuf->rowSel);
+  pRowBuf->rowCap = 0;
+}
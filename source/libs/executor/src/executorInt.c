@@ -507,20 +507,32 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
     return TSDB_CODE_SUCCESS;
   }
 
+  SColumnInfoData* p = NULL;
+  int32_t          status = 0;
+
+  int32_t code = doFilterEvaluate(pBlock, pFilterInfo, &p, &status);
+  if (code == TSDB_CODE_SUCCESS) {
+    doFilterApply(pBlock, p, status, pColMatchInfo);
+  }
+
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
+// evaluate the filter only, the rows of pBlock are kept until doFilterApply
+int32_t doFilterEvaluate(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColumnInfoData** p, int32_t* status) {
   SFilterColumnParam param1 = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
-  SColumnInfoData*   p = NULL;
 
   int32_t code = filterSetDataFromSlotId(pFilterInfo, &param1);
   if (code != TSDB_CODE_SUCCESS) {
-    goto _err;
+    return code;
   }
 
-  int32_t status = 0;
-  code = filterExecute(pFilterInfo, pBlock, &p, NULL, param1.numOfCols, &status);
-  if (code != TSDB_CODE_SUCCESS) {
-    goto _err;
-  }
+  return filterExecute(pFilterInfo, pBlock, p, NULL, param1.numOfCols, status);
+}
 
+void doFilterApply(SSDataBlock* pBlock, SColumnInfoData* p, int32_t status, SColMatchInfo* pColMatchInfo) {
   extractQualifiedTupleByFilterResult(pBlock, p, status);
 
   if (pColMatchInfo != NULL) {
@@ -536,12 +548,6 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
       }
     }
   }
-  code = TSDB_CODE_SUCCESS;
-
-_err:
-  colDataDestroy(p);
-  taosMemoryFree(p);
-  return code;
 }
 
 void extractQualifiedTupleByFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status) {
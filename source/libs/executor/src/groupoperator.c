@@ -25,9 +25,37 @@
 #include "operator.h"
 #include "querytask.h"
 #include "tcompare.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "ttypes.h"
 
+#define GROUPBY_MAX_MEM_SIZE        1073741824L
+#define GROUPBY_MIN_MEM_SIZE        1048576L
+#define GROUPBY_SPILL_PARTITION_NUM 16
+#define GROUPBY_SPILL_PARTITION_BITS 4
+#define GROUPBY_SPILL_BUF_PAGES     256
+
+typedef struct SGroupbySpillPart {
+  int32_t level;
+  SArray* pPageIds;   // SArray<int32_t>
+  SArray* pGroupIds;  // SArray<uint64_t>, group id of the block each page is split from
+} SGroupbySpillPart;
+
+// rows of the groups that do not fit into memory, aggregated by later passes one partition at a time
+typedef struct SGroupbySpillInfo {
+  int64_t        memReserved;  // bytes reserved from the query buffer
+  int64_t        memLimit;
+  int32_t        level;       // partition level of the rows being aggregated
+  int32_t        partIdx[GROUPBY_SPILL_PARTITION_NUM];  // index in pParts of the partitions created by this pass
+  SArray*        pParts;      // SArray<SGroupbySpillPart>, partitions not aggregated yet
+  SDiskbasedBuf* pBuf;
+  SSDataBlock*   pBlock;      // block to read the spilled rows back
+  SSpillRowBuf   rowBuf;      // partition of each row in current block, -1 if aggregated
+  int32_t        blockSpillRows;
+  int64_t        spillRows;
+  int32_t        passes;
+} SGroupbySpillInfo;
+
 typedef struct SGroupbyOperatorInfo {
   SOptrBasicInfo binfo;
   SAggSupporter  aggSup;
@@ -38,6 +66,7 @@ typedef struct SGroupbyOperatorInfo {
   int32_t        groupKeyLen;    // total group by column width
   SGroupResInfo  groupResInfo;
   SExprSupp      scalarSup;
+  SGroupbySpillInfo spill;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -73,6 +102,23 @@ static void freeGroupKey(void* param) {
   taosMemoryFree(pKey->pData);
 }
 
+static void destroyGroupbySpillInfo(SGroupbySpillInfo* pSpill) {
+  if (pSpill->passes > 0 || pSpill->spillRows > 0) {
+    qDebug("group by spilled %" PRId64 " rows, %d passes", pSpill->spillRows, pSpill->passes);
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pSpill->pParts); ++i) {
+    SGroupbySpillPart* pPart = taosArrayGet(pSpill->pParts, i);
+    taosArrayDestroy(pPart->pPageIds);
+    taosArrayDestroy(pPart->pGroupIds);
+  }
+  taosArrayDestroy(pSpill->pParts);
+  destroyDiskbasedBuf(pSpill->pBuf);
+  blockDataDestroy(pSpill->pBlock);
+  destroySpillRowBuf(&pSpill->rowBuf);
+  releaseQueryBufBytes(pSpill->memReserved);
+}
+
 static void destroyGroupOperatorInfo(void* param) {
   SGroupbyOperatorInfo* pInfo = (SGroupbyOperatorInfo*)param;
   if (pInfo == NULL) {
@@ -87,6 +133,7 @@ static void destroyGroupOperatorInfo(void* param) {
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   cleanupAggSup(&pInfo->aggSup);
+  destroyGroupbySpillInfo(&pInfo->spill);
   taosMemoryFreeClear(param);
 }
 
@@ -272,20 +319,160 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static FORCE_INLINE int64_t getGroupbyMemSize(SGroupbyOperatorInfo* pInfo) {
+  SSHashObj* pHashmap = pInfo->aggSup.pResultRowHashTable;
+  return tSimpleHashGetMemSize(pHashmap) +
+         (int64_t)tSimpleHashGetSize(pHashmap) * (GET_RES_WINDOW_KEY_LEN(pInfo->groupKeyLen) +
+                                                  sizeof(SResultRowPosition) + pInfo->aggSup.resultRowSize);
+}
+
+static bool groupbyResultRowExists(SGroupbyOperatorInfo* pInfo, int32_t len, uint64_t groupId) {
+  SAggSupporter* pSup = &pInfo->aggSup;
+
+  // same key as the one built by doSetResultOutBufByKey
+  SET_RES_WINDOW_KEY(pSup->keyBuf, pInfo->keyBuf, len, groupId);
+  *(uint64_t*)pSup->keyBuf = calcGroupId(pSup->keyBuf, GET_RES_WINDOW_KEY_LEN(len));
+  return NULL != tSimpleHashGet(pSup->pResultRowHashTable, pSup->keyBuf, GET_RES_WINDOW_KEY_LEN(len));
+}
+
+static int32_t ensureGroupbySpillRowBuf(SGroupbySpillInfo* pSpill, int32_t rows) {
+  int32_t code = ensureSpillRowBuf(&pSpill->rowBuf, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  memset(pSpill->rowBuf.rowPart, -1, rows * sizeof(*pSpill->rowBuf.rowPart));
+  pSpill->blockSpillRows = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void doGroupbyAggRows(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t rowIndex, int32_t num) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupbySpillInfo*    pSpill = &pInfo->spill;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+
+  int32_t len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
+
+  // no room for a new group, keep its rows for a later pass over the partition of its key
+  if (tSimpleHashGetSize(pInfo->aggSup.pResultRowHashTable) > 0 && getGroupbyMemSize(pInfo) >= pSpill->memLimit &&
+      !groupbyResultRowExists(pInfo, len, pBlock->info.id.groupId)) {
+    int32_t shift = (pSpill->level * GROUPBY_SPILL_PARTITION_BITS) % 64;
+    int8_t  part = (calcGroupId(pInfo->keyBuf, len) >> shift) % GROUPBY_SPILL_PARTITION_NUM;
+    memset(pSpill->rowBuf.rowPart + rowIndex, part, num);
+    pSpill->blockSpillRows += num;
+    return;
+  }
+
+  int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
+                                        len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+  if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+  }
+
+  applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+                                  pOperator->exprSupp.numOfExprs);
+
+  // assign the group keys or user input constant values if required
+  doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+}
+
+static SGroupbySpillPart* getGroupbySpillPart(SGroupbySpillInfo* pSpill, int32_t part) {
+  if (pSpill->pParts == NULL) {
+    pSpill->pParts = taosArrayInit(GROUPBY_SPILL_PARTITION_NUM, sizeof(SGroupbySpillPart));
+    if (pSpill->pParts == NULL) {
+      return NULL;
+    }
+  }
+
+  if (pSpill->partIdx[part] < 0) {
+    SGroupbySpillPart newPart = {.level = pSpill->level + 1,
+                                 .pPageIds = taosArrayInit(4, sizeof(int32_t)),
+                                 .pGroupIds = taosArrayInit(4, sizeof(uint64_t))};
+    if (newPart.pPageIds == NULL || newPart.pGroupIds == NULL || taosArrayPush(pSpill->pParts, &newPart) == NULL) {
+      taosArrayDestroy(newPart.pPageIds);
+      taosArrayDestroy(newPart.pGroupIds);
+      return NULL;
+    }
+    pSpill->partIdx[part] = taosArrayGetSize(pSpill->pParts) - 1;
+  }
+
+  return taosArrayGet(pSpill->pParts, pSpill->partIdx[part]);
+}
+
+static int32_t doSpillGroupbyRows(SGroupbyOperatorInfo* pInfo, SSDataBlock* pBlock) {
+  SGroupbySpillInfo* pSpill = &pInfo->spill;
+  int32_t            rows = pBlock->info.rows;
+  int32_t            code = TSDB_CODE_SUCCESS;
+
+  if (pSpill->pBuf == NULL) {
+    code = createSpillBuf(&pSpill->pBuf, &pSpill->pBlock, pBlock, GROUPBY_SPILL_BUF_PAGES, "groupbySpillBuf");
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  for (int32_t p = 0; p < GROUPBY_SPILL_PARTITION_NUM; ++p) {
+    int32_t partRows = 0;
+    for (int32_t i = 0; i < rows; ++i) {
+      pSpill->rowBuf.rowSel[i] = (pSpill->rowBuf.rowPart[i] == p);
+      partRows += pSpill->rowBuf.rowSel[i];
+    }
+    if (partRows == 0) {
+      continue;
+    }
+
+    SGroupbySpillPart* pPart = getGroupbySpillPart(pSpill, p);
+    if (pPart == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    SSDataBlock* pPartBlock = pBlock;
+    if (partRows < rows) {
+      pPartBlock = createOneDataBlock(pBlock, true);
+      if (pPartBlock == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      trimDataBlock(pPartBlock, rows, pSpill->rowBuf.rowSel);
+      pPartBlock->info.rows = partRows;
+    }
+
+    code = addBlockToSpillBuf(pSpill->pBuf, pPartBlock, pPart->pPageIds);
+    if (pPartBlock != pBlock) {
+      blockDataDestroy(pPartBlock);
+    }
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    while (taosArrayGetSize(pPart->pGroupIds) < taosArrayGetSize(pPart->pPageIds)) {
+      if (taosArrayPush(pPart->pGroupIds, &pBlock->info.id.groupId) == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+  }
+
+  pSpill->spillRows += pSpill->blockSpillRows;
+  return TSDB_CODE_SUCCESS;
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
 
-  SqlFunctionCtx* pCtx = pOperator->exprSupp.pCtx;
-  int32_t         numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
+  int32_t numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
   //  if (type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE) {
   // qError("QInfo:0x%"PRIx64" group by not supported on double/float columns, abort", GET_TASKID(pRuntimeEnv));
   //    return;
   //  }
 
-  int32_t len = 0;
   terrno = TSDB_CODE_SUCCESS;
 
+  int32_t code = ensureGroupbySpillRowBuf(&pInfo->spill, pBlock->info.rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
   int32_t num = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
@@ -315,35 +502,20 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
       continue;
     }
 
-    len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
-    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
-                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
-    if (ret != TSDB_CODE_SUCCESS) {  // null data, too many state code
-      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
-    }
-
-    int32_t rowIndex = j - num;
-    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
-                                    pOperator->exprSupp.numOfExprs);
-
-    // assign the group keys or user input constant values if required
-    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+    doGroupbyAggRows(pOperator, pBlock, j - num, num);
     recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
     num = 1;
   }
 
   if (num > 0) {
-    len = buildGroupKeys(pInfo->keyBuf, pInfo->pGroupColVals);
-    int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf,
-                                          len, pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
-    if (ret != TSDB_CODE_SUCCESS) {
-      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
-    }
+    doGroupbyAggRows(pOperator, pBlock, pBlock->info.rows - num, num);
+  }
 
-    int32_t rowIndex = pBlock->info.rows - num;
-    applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
-                                    pOperator->exprSupp.numOfExprs);
-    doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+  if (pInfo->spill.blockSpillRows > 0) {
+    code = doSpillGroupbyRows(pInfo, pBlock);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
   }
 }
 
@@ -410,6 +582,73 @@ void doBuildResultDatablockByHash(SOperatorInfo* pOperator, SOptrBasicInfo* pbIn
   }
 }
 
+static void resetGroupbyResInfo(SGroupResInfo* pGroupResInfo) {
+  if (pGroupResInfo->pRows != NULL) {
+    taosArrayDestroy(pGroupResInfo->pRows);
+    pGroupResInfo->pRows = NULL;
+  }
+  if (pGroupResInfo->pBuf) {
+    taosMemoryFree(pGroupResInfo->pBuf);
+    pGroupResInfo->pBuf = NULL;
+  }
+  pGroupResInfo->index = 0;
+  pGroupResInfo->iter = 0;
+  pGroupResInfo->dataPos = NULL;
+}
+
+/*
+ * All groups in memory have been returned, drop them and aggregate the rows of the next spilled partition. Groups
+ * that still do not fit are spilled again into finer partitions, split by the next bits of the key hash.
+ */
+static int32_t doGroupbySpillPass(SOperatorInfo* pOperator) {
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupbySpillInfo*    pSpill = &pInfo->spill;
+  SGroupbySpillPart     part = *(SGroupbySpillPart*)taosArrayGet(pSpill->pParts, 0);
+  int32_t               code = TSDB_CODE_SUCCESS;
+
+  taosArrayRemove(pSpill->pParts, 0);
+
+  tSimpleHashClear(pInfo->aggSup.pResultRowHashTable);
+  clearDiskbasedBuf(pInfo->aggSup.pResultBuf);
+  pInfo->aggSup.currentPageId = -1;
+  initResultRowInfo(&pInfo->binfo.resultRowInfo);
+  resetGroupbyResInfo(&pInfo->groupResInfo);
+
+  pSpill->level = part.level;
+  for (int32_t i = 0; i < GROUPBY_SPILL_PARTITION_NUM; ++i) {
+    pSpill->partIdx[i] = -1;
+  }
+
+  qDebug("group by aggregate spilled partition, level:%d, pages:%d, remain partitions:%d, %s", part.level,
+         (int32_t)taosArrayGetSize(part.pPageIds), (int32_t)taosArrayGetSize(pSpill->pParts),
+         GET_TASKID(pOperator->pTaskInfo));
+
+  SSDataBlock* pBlock = pSpill->pBlock;
+  for (int32_t i = 0; i < taosArrayGetSize(part.pPageIds); ++i) {
+    int32_t* pPageId = taosArrayGet(part.pPageIds, i);
+    void*    pPage = getBufPage(pSpill->pBuf, *pPageId);
+    if (pPage == NULL) {
+      code = terrno;
+      break;
+    }
+
+    code = blockDataFromBuf(pBlock, pPage);
+    dBufSetBufPageRecycled(pSpill->pBuf, pPage);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    pBlock->info.id.groupId = *(uint64_t*)taosArrayGet(part.pGroupIds, i);
+    setInputDataBlock(&pOperator->exprSupp, pBlock, pInfo->binfo.inputTsOrder, pBlock->info.scanFlag, true);
+    doHashGroupbyAgg(pOperator, pBlock);
+  }
+
+  taosArrayDestroy(part.pPageIds);
+  taosArrayDestroy(part.pGroupIds);
+  pSpill->passes += 1;
+  return code;
+}
+
 static SSDataBlock* buildGroupResultDataBlockByHash(SOperatorInfo* pOperator) {
   SGroupbyOperatorInfo* pInfo = pOperator->info;
   SSDataBlock* pRes = pInfo->binfo.pRes;
@@ -420,6 +659,17 @@ static SSDataBlock* buildGroupResultDataBlockByHash(SOperatorInfo* pOperator) {
 
     doFilter(pRes, pOperator->exprSupp.pFilterInfo, NULL);
     if (!hasRemainResultByHash(pOperator)) {
+      if (taosArrayGetSize(pInfo->spill.pParts) > 0) {
+        int32_t code = doGroupbySpillPass(pOperator);
+        if (code != TSDB_CODE_SUCCESS) {
+          T_LONG_JMP(pOperator->pTaskInfo->env, code);
+        }
+        if (pRes->info.rows > 0) {
+          break;
+        }
+        continue;
+      }
+
       setOperatorCompleted(pOperator);
       // clean hash after completed
       tSimpleHashCleanup(pInfo->aggSup.pResultRowHashTable);
@@ -478,16 +728,7 @@ static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
   pOperator->status = OP_RES_TO_RETURN;
 
   // initGroupedResultInfo(&pInfo->groupResInfo, pInfo->aggSup.pResultRowHashTable, 0);
-  if (pGroupResInfo->pRows != NULL) {
-    taosArrayDestroy(pGroupResInfo->pRows);
-  }
-  if (pGroupResInfo->pBuf) {
-    taosMemoryFree(pGroupResInfo->pBuf);
-    pGroupResInfo->pBuf = NULL;
-  }
-  pGroupResInfo->index = 0;
-  pGroupResInfo->iter = 0;
-  pGroupResInfo->dataPos = NULL;
+  resetGroupbyResInfo(pGroupResInfo);
 
   pOperator->cost.openCost = (taosGetTimestampUs() - st) / 1000.0;
   return buildGroupResultDataBlockByHash(pOperator);
@@ -538,6 +779,12 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  pInfo->spill.memReserved = reserveQueryBufBytes(GROUPBY_MAX_MEM_SIZE);
+  pInfo->spill.memLimit = TMAX(pInfo->spill.memReserved, GROUPBY_MIN_MEM_SIZE);
+  for (int32_t i = 0; i < GROUPBY_SPILL_PARTITION_NUM; ++i) {
+    pInfo->spill.partIdx[i] = -1;
+  }
+
   initResultRowInfo(&pInfo->binfo.resultRowInfo);
   setOperatorInfo(pOperator, "GroupbyAggOperator", 0, true, OP_NOT_OPENED, pInfo, pTaskInfo);
 
@@ -20,8 +20,10 @@
 #include "os.h"
 #include "querynodes.h"
 #include "querytask.h"
+#include "tbloomfilter.h"
 #include "tcompare.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
@@ -297,13 +299,34 @@ static void destroyHJoinKeyHash(SSHashObj** ppHash) {
   *ppHash = NULL;
 }
 
+static void destroyHJoinSpillCtx(SHJoinSpillCtx* pSpill) {
+  for (int32_t i = 0; i < HASH_JOIN_PARTITION_NUM; ++i) {
+    taosArrayDestroy(pSpill->parts[i].pBuildPages);
+    taosArrayDestroy(pSpill->parts[i].pProbePages);
+  }
+
+  destroyDiskbasedBuf(pSpill->pBuildBuf);
+  destroyDiskbasedBuf(pSpill->pProbeBuf);
+  blockDataDestroy(pSpill->pBuildBlk);
+  blockDataDestroy(pSpill->pProbeBlk);
+  tBloomFilterDestroy(pSpill->pBloom);
+  destroySpillRowBuf(&pSpill->rowBuf);
+}
+
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
   qError("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
          pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+  if (pJoinOperator->spill.spilled) {
+    qDebug("hashJoin spill info, buildRows:%" PRId64 ", probeRows:%" PRId64 ", bloomSkipRows:%" PRId64
+           ", rounds:%" PRId64,
+           pJoinOperator->execInfo.spillBuildRows, pJoinOperator->execInfo.spillProbeRows,
+           pJoinOperator->execInfo.bloomSkipRows, pJoinOperator->execInfo.spillRounds);
+  }
 
   destroyHJoinKeyHash(&pJoinOperator->pKeyHash);
+  destroyHJoinSpillCtx(&pJoinOperator->spill);
 
   freeHJoinTableInfo(&pJoinOperator->tbs[0]);
   freeHJoinTableInfo(&pJoinOperator->tbs[1]);
@@ -311,6 +334,7 @@ static void destroyHashJoinOperator(void* param) {
   taosMemoryFreeClear(pJoinOperator->pResColMap);
   taosArrayDestroyEx(pJoinOperator->pRowBufs, freeHJoinBufPage);
   nodesDestroyNode(pJoinOperator->pCond);
+  releaseQueryBufBytes(pJoinOperator->memReserved);
 
   taosMemoryFreeClear(param);
 }
@@ -651,6 +675,8 @@ static int32_t addRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, S
     pGroup->rows = pRow;
   }
 
+  pJoin->keyHashRows++;
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -691,6 +717,267 @@ static int32_t addBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin
   return code;
 }
 
+static FORCE_INLINE int64_t getHJoinMemSize(SHJoinOperatorInfo* pJoin) {
+  int64_t bloomSize = pJoin->spill.pBloom ? pJoin->spill.pBloom->numUnits * sizeof(uint64_t) : 0;
+  return (int64_t)taosArrayGetSize(pJoin->pRowBufs) * HASH_JOIN_DEFAULT_PAGE_SIZE +
+         tSimpleHashGetMemSize(pJoin->pKeyHash) + pJoin->keyHashRows * sizeof(SBufRowInfo) + bloomSize;
+}
+
+// the bloom filter lives until the last spill partition is joined, keep it within a part of the memory limit
+static int64_t getHJoinBloomEntries(SHJoinOperatorInfo* pJoin) {
+  // m / n = -ln(P) / ln(2)^2 bits per entry, ln(2)^2 = 0.480453013918201
+  double  bitsPerEntry = fabs(log(HASH_JOIN_BLOOM_ERROR_RATE)) / 0.480453013918201;
+  int64_t maxEntries = (int64_t)(pJoin->memLimit / HASH_JOIN_BLOOM_MEM_RATIO * 8 / bitsPerEntry);
+  int64_t entries = TMAX(pJoin->pBuild->inputStat.inputRowNum, HASH_JOIN_BLOOM_MIN_ENTRIES);
+
+  entries = TMIN(entries, HASH_JOIN_BLOOM_MAX_ENTRIES);
+  return TMAX(TMIN(entries, maxEntries), 1);
+}
+
+// use the high bits so that rows of one partition still spread over all the buckets of the key hash
+static FORCE_INLINE int8_t getHJoinKeyPartIdx(SHJoinTableInfo* pTable, size_t keyLen) {
+  return (MurmurHash3_32(pTable->keyData, keyLen) >> 16) % HASH_JOIN_PARTITION_NUM;
+}
+
+static int32_t startHJoinSpill(SHJoinOperatorInfo* pJoin) {
+  SHJoinSpillCtx* pSpill = &pJoin->spill;
+
+  pSpill->pBloom = tBloomFilterInit(getHJoinBloomEntries(pJoin), HASH_JOIN_BLOOM_ERROR_RATE);
+  if (NULL == pSpill->pBloom) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < HASH_JOIN_PARTITION_NUM; ++i) {
+    pSpill->parts[i].pBuildPages = taosArrayInit(4, sizeof(int32_t));
+    pSpill->parts[i].pProbePages = taosArrayInit(4, sizeof(int32_t));
+    if (NULL == pSpill->parts[i].pBuildPages || NULL == pSpill->parts[i].pProbePages) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  pSpill->spilled = true;
+
+  qDebug("hash join build side reaches %" PRId64 " bytes with %" PRId64 " rows, spill the remaining build rows",
+         getHJoinMemSize(pJoin), pJoin->keyHashRows);
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t loadHJoinSpillPage(SDiskbasedBuf* pBuf, SArray* pPageIdList, int32_t idx, SSDataBlock* pBlock) {
+  int32_t* pPageId = taosArrayGet(pPageIdList, idx);
+  void*    pPage = getBufPage(pBuf, *pPageId);
+  if (NULL == pPage) {
+    return terrno;
+  }
+
+  int32_t code = blockDataFromBuf(pBlock, pPage);
+  releaseBufPage(pBuf, pPage);
+  return code;
+}
+
+/*
+ * Write the rows of a block to the spill pages of their key partitions. Build rows are all spilled and put into the
+ * bloom filter, probe rows are only kept when the bloom filter says the partition may hold a matching build row.
+ */
+static int32_t spillHJoinBlockRows(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, bool build) {
+  SHJoinSpillCtx*  pSpill = &pJoin->spill;
+  SHJoinTableInfo* pTable = build ? pJoin->pBuild : pJoin->pProbe;
+  SDiskbasedBuf**  ppBuf = build ? &pSpill->pBuildBuf : &pSpill->pProbeBuf;
+  int32_t          rows = pBlock->info.rows;
+  int32_t          partRows[HASH_JOIN_PARTITION_NUM] = {0};
+  size_t           keyLen = 0;
+
+  int32_t code = setKeyColsData(pBlock, pTable);
+  if (code) {
+    return code;
+  }
+  code = ensureSpillRowBuf(&pSpill->rowBuf, rows);
+  if (code) {
+    return code;
+  }
+
+  for (int32_t i = 0; i < rows; ++i) {
+    copyKeyColsDataToBuf(pTable, i, &keyLen);
+    int8_t part = getHJoinKeyPartIdx(pTable, keyLen);
+    if (build) {
+      tBloomFilterPut(pSpill->pBloom, pTable->keyData, keyLen);
+    } else if (taosArrayGetSize(pSpill->parts[part].pBuildPages) <= 0 ||
+               TSDB_CODE_SUCCESS == tBloomFilterNoContain(pSpill->pBloom,
+                                                          pSpill->pBloom->hashFn1(pTable->keyData, keyLen),
+                                                          pSpill->pBloom->hashFn2(pTable->keyData, keyLen))) {
+      pSpill->rowBuf.rowPart[i] = -1;
+      pJoin->execInfo.bloomSkipRows++;
+      continue;
+    }
+
+    pSpill->rowBuf.rowPart[i] = part;
+    partRows[part]++;
+  }
+
+  for (int32_t p = 0; p < HASH_JOIN_PARTITION_NUM; ++p) {
+    if (partRows[p] <= 0) {
+      continue;
+    }
+
+    if (NULL == *ppBuf) {
+      code = createSpillBuf(ppBuf, build ? &pSpill->pBuildBlk : &pSpill->pProbeBlk, pBlock, HASH_JOIN_SPILL_BUF_PAGES,
+                            build ? "hashJoinBuildBuf" : "hashJoinProbeBuf");
+      if (code) {
+        return code;
+      }
+    }
+
+    SArray*      pPageIdList = build ? pSpill->parts[p].pBuildPages : pSpill->parts[p].pProbePages;
+    SSDataBlock* pPartBlk = pBlock;
+    if (partRows[p] < rows) {
+      pPartBlk = createOneDataBlock(pBlock, true);
+      if (NULL == pPartBlk) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      for (int32_t i = 0; i < rows; ++i) {
+        pSpill->rowBuf.rowSel[i] = (pSpill->rowBuf.rowPart[i] == p);
+      }
+      trimDataBlock(pPartBlk, rows, pSpill->rowBuf.rowSel);
+      pPartBlk->info.rows = partRows[p];
+    }
+
+    code = addBlockToSpillBuf(*ppBuf, pPartBlk, pPageIdList);
+    if (pPartBlk != pBlock) {
+      blockDataDestroy(pPartBlk);
+    }
+    if (code) {
+      return code;
+    }
+
+    if (build) {
+      pJoin->execInfo.spillBuildRows += partRows[p];
+    } else {
+      pJoin->execInfo.spillProbeRows += partRows[p];
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t resetHJoinKeyHash(SHJoinOperatorInfo* pJoin) {
+  destroyHJoinKeyHash(&pJoin->pKeyHash);
+  pJoin->keyHashRows = 0;
+
+  while (taosArrayGetSize(pJoin->pRowBufs) > 1) {
+    freeHJoinBufPage(taosArrayPop(pJoin->pRowBufs));
+  }
+  SBufPageInfo* pPage = taosArrayGet(pJoin->pRowBufs, 0);
+  pPage->offset = 0;
+
+  pJoin->pKeyHash = tSimpleHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (NULL == pJoin->pKeyHash) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * Rebuild the key hash from the spilled build rows of the current partition, as many pages as the memory limit
+ * allows. A partition larger than the limit is joined in several rounds, each replaying all of its probe pages.
+ */
+static int32_t loadHJoinSpillRound(SHJoinOperatorInfo* pJoin) {
+  SHJoinSpillCtx*  pSpill = &pJoin->spill;
+  SHJoinPartition* pPart = &pSpill->parts[pSpill->partIdx];
+  int32_t          pageNum = taosArrayGetSize(pPart->pBuildPages);
+
+  int32_t code = resetHJoinKeyHash(pJoin);
+  if (code) {
+    return code;
+  }
+
+  do {
+    code = loadHJoinSpillPage(pSpill->pBuildBuf, pPart->pBuildPages, pSpill->buildPageIdx++, pSpill->pBuildBlk);
+    if (code) {
+      return code;
+    }
+    code = addBlockRowsToHash(pSpill->pBuildBlk, pJoin);
+    if (code) {
+      return code;
+    }
+  } while (pSpill->buildPageIdx < pageNum && getHJoinMemSize(pJoin) < pJoin->memLimit);
+
+  qDebug("hash join spill partition %d loaded %d/%d build pages, %" PRId64 " rows", pSpill->partIdx,
+         pSpill->buildPageIdx, pageNum, pJoin->keyHashRows);
+
+  pSpill->probePageIdx = 0;
+  pSpill->roundLoaded = true;
+  pJoin->execInfo.spillRounds++;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static SSDataBlock* getNextHJoinProbeBlock(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinSpillCtx*     pSpill = &pJoin->spill;
+  SExecTaskInfo*      pTaskInfo = pOperator->pTaskInfo;
+  int32_t             code = TSDB_CODE_SUCCESS;
+
+  if (!pSpill->probeDone) {
+    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    if (pBlock) {
+      pJoin->execInfo.probeBlkNum++;
+      pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+
+      if (pSpill->spilled) {
+        code = spillHJoinBlockRows(pJoin, pBlock, false);
+        if (code) {
+          goto _error;
+        }
+      }
+      return pBlock;
+    }
+
+    pSpill->probeDone = true;
+    if (!pSpill->spilled) {
+      return NULL;
+    }
+  }
+
+  while (pSpill->partIdx < HASH_JOIN_PARTITION_NUM) {
+    SHJoinPartition* pPart = &pSpill->parts[pSpill->partIdx];
+    if (pSpill->roundLoaded) {
+      if (pSpill->probePageIdx < taosArrayGetSize(pPart->pProbePages)) {
+        code = loadHJoinSpillPage(pSpill->pProbeBuf, pPart->pProbePages, pSpill->probePageIdx++, pSpill->pProbeBlk);
+        if (code) {
+          goto _error;
+        }
+        return pSpill->pProbeBlk;
+      }
+
+      pSpill->roundLoaded = false;
+      if (pSpill->buildPageIdx < taosArrayGetSize(pPart->pBuildPages)) {
+        code = loadHJoinSpillRound(pJoin);
+        if (code) {
+          goto _error;
+        }
+        continue;
+      }
+    } else if (taosArrayGetSize(pPart->pBuildPages) > 0 && taosArrayGetSize(pPart->pProbePages) > 0) {
+      code = loadHJoinSpillRound(pJoin);
+      if (code) {
+        goto _error;
+      }
+      continue;
+    }
+
+    pSpill->partIdx++;
+    pSpill->buildPageIdx = 0;
+  }
+
+  return NULL;
+
+_error:
+  pTaskInfo->code = code;
+  T_LONG_JMP(pTaskInfo->env, code);
+  return NULL;
+}
+
 static int32_t buildHJoinKeyHash(struct SOperatorInfo* pOperator) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
@@ -705,7 +992,14 @@ static int32_t buildHJoinKeyHash(struct SOperatorInfo* pOperator) {
     pJoin->execInfo.buildBlkNum++;
     pJoin->execInfo.buildBlkRows += pBlock->info.rows;
 
-    code = addBlockRowsToHash(pBlock, pJoin);
+    if (pJoin->spill.spilled) {
+      code = spillHJoinBlockRows(pJoin, pBlock, true);
+    } else {
+      code = addBlockRowsToHash(pBlock, pJoin);
+      if (TSDB_CODE_SUCCESS == code && getHJoinMemSize(pJoin) >= pJoin->memLimit) {
+        code = startHJoinSpill(pJoin);
+      }
+    }
     if (code) {
       return code;
     }
@@ -790,15 +1084,12 @@ static SSDataBlock* doHashJoin(struct SOperatorInfo* pOperator) {
   }
 
   while (true) {
-    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    SSDataBlock* pBlock = getNextHJoinProbeBlock(pOperator);
     if (NULL == pBlock) {
       setHJoinDone(pOperator);
       break;
     }
 
-    pJoin->execInfo.probeBlkNum++;
-    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
-    
     code = launchBlockHashJoin(pOperator, pBlock);
     if (code) {
       pTaskInfo->code = code;
@@ -858,6 +1149,9 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
     goto _error;
   }
 
+  pInfo->memReserved = reserveQueryBufBytes(HASH_JOIN_MAX_BUILD_MEM_SIZE);
+  pInfo->memLimit = TMAX(pInfo->memReserved, HASH_JOIN_MIN_BUILD_MEM_SIZE);
+
   size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0 ? (pInfo->pBuild->inputStat.inputRowNum * 1.5) : 1024;
   pInfo->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
   if (pInfo->pKeyHash == NULL) {
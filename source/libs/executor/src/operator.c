@@ -134,6 +134,29 @@ void releaseQueryBuf(size_t numOfTables) {
   atomic_add_fetch_64(&tsQueryBufferSizeBytes, t);
 }
 
+// reserve up to maxSize bytes of the query buffer for an operator, all of it if the buffer is not limited
+int64_t reserveQueryBufBytes(int64_t maxSize) {
+  while (1) {
+    int64_t s = tsQueryBufferSizeBytes;
+    if (s < 0) {
+      return maxSize;
+    }
+
+    int64_t t = TMIN(s, maxSize);
+    if (atomic_val_compare_exchange_64(&tsQueryBufferSizeBytes, s, s - t) == s) {
+      return t;
+    }
+  }
+}
+
+void releaseQueryBufBytes(int64_t size) {
+  if (tsQueryBufferSizeBytes < 0 || size <= 0) {
+    return;
+  }
+
+  atomic_add_fetch_64(&tsQueryBufferSizeBytes, size);
+}
+
 typedef enum {
   OPTR_FN_RET_CONTINUE = 0x1,
   OPTR_FN_RET_ABORT = 0x2,
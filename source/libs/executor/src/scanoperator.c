@@ -292,6 +292,91 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+// Collect the data columns used by the filter. The reader copies them into the result block first, so the other
+// columns are decompressed only for the blocks that have qualified rows.
+static int32_t initFilterColIds(STableScanBase* pBase, SNode* pCondition) {
+  if (pCondition == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SNodeList* pCols = NULL;
+  int32_t    code = nodesCollectColumnsFromNode(pCondition, NULL, COLLECT_COL_TYPE_ALL, &pCols);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  pBase->pFilterColIds = taosArrayInit(TMAX(LIST_LENGTH(pCols), 1), sizeof(col_id_t));
+  if (pBase->pFilterColIds == NULL) {
+    nodesDestroyList(pCols);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  SNode* pNode = NULL;
+  FOREACH(pNode, pCols) {
+    SColumnNode* pCol = (SColumnNode*)pNode;
+    if (pCol->colType == COLUMN_TYPE_COLUMN) {
+      taosArrayPush(pBase->pFilterColIds, &pCol->colId);
+    } else if (pCol->colType != COLUMN_TYPE_TAG && pCol->colType != COLUMN_TYPE_TBNAME) {
+      // not filled by the reader or the tag columns, load all columns before the filter
+      taosArrayDestroy(pBase->pFilterColIds);
+      pBase->pFilterColIds = NULL;
+      break;
+    }
+  }
+
+  nodesDestroyList(pCols);
+
+  if (pBase->pFilterColIds != NULL) {
+    taosArraySort(pBase->pFilterColIds, compareInt16Val);
+    taosArrayRemoveDuplicate(pBase->pFilterColIds, compareInt16Val, NULL);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// If the reader has only copied the filter columns into pBlock, the remain columns are retrieved after the filter, and
+// only when some rows are qualified.
+static int32_t doFilterAndLoadRemainCols(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo,
+                                         SSDataBlock* pBlock) {
+  SStorageAPI* pAPI = &pOperator->pTaskInfo->storageAPI;
+  SFilterInfo* pFilterInfo = pOperator->exprSupp.pFilterInfo;
+
+  if (pTableScanInfo->pFilterColIds == NULL || pBlock->info.dataLoad) {
+    return doFilter(pBlock, pFilterInfo, &pTableScanInfo->matchInfo);
+  }
+
+  if (pBlock->info.rows == 0) {
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* p = NULL;
+  int32_t          status = 0;
+
+  int32_t code = doFilterEvaluate(pBlock, pFilterInfo, &p, &status);
+  if (code != TSDB_CODE_SUCCESS) {
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+    goto _end;
+  }
+
+  if (status == FILTER_RESULT_NONE_QUALIFIED) {
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+  } else {
+    SSDataBlock* pRes = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
+    if (pRes == NULL) {
+      code = terrno;
+      goto _end;
+    }
+  }
+
+  doFilterApply(pBlock, p, status, &pTableScanInfo->matchInfo);
+
+_end:
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
@@ -386,7 +471,8 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalCheckedRows += pBlock->info.rows;
   pCost->loadBlocks += 1;
 
-  SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
+  SSDataBlock* p =
+      pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, pTableScanInfo->pFilterColIds);
   if (p == NULL) {
     return terrno;
   }
@@ -398,7 +484,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalRows -= pBlock->info.rows;
 
   if (pOperator->exprSupp.pFilterInfo != NULL) {
-    int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
+    int32_t code = doFilterAndLoadRemainCols(pOperator, pTableScanInfo, pBlock);
     if (code != TSDB_CODE_SUCCESS) return code;
 
     int64_t st = taosGetTimestampUs();
@@ -1138,6 +1224,8 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
     taosArrayDestroy(pBase->matchInfo.pList);
   }
 
+  taosArrayDestroy(pBase->pFilterColIds);
+
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
   cleanupExprSupp(&pBase->pseudoSup);
@@ -1201,6 +1289,11 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+
+  code = initFilterColIds(&pInfo->base, pTableScanNode->scan.node.pConditions);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
   
   pInfo->currentGroupId = -1;
 
@@ -4321,6 +4414,11 @@ SOperatorInfo* createTableMergeScanOperatorInfo(STableScanPhysiNode* pTableScanN
     goto _error;
   }
 
+  code = initFilterColIds(&pInfo->base, pTableScanNode->scan.node.pConditions);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
   initLimitInfo(pTableScanNode->scan.node.pLimit, pTableScanNode->scan.node.pSlimit, &pInfo->limitInfo);
 
   pInfo->mergeLimit = -1;
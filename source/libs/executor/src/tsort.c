@@ -27,6 +27,13 @@
 #include "tsimplehash.h"
 #include "executil.h"
 
+#define MAX_SORT_THREADS     8
+#define SORT_POOL_QUEUE_SIZE 1024
+
+// the in-memory runs of all sort handles are sorted by one pool, started and stopped with the dnode
+static SSchedQueue sortPool = {0};
+static int8_t      sortPoolReady = 0;
+
 struct STupleHandle {
   SSDataBlock* pBlock;
   int32_t      rowIndex;
@@ -54,6 +61,7 @@ struct SSortHandle {
   int64_t          mergeLimit;
   int64_t          currMergeLimitTs;          
 
+  int32_t           numOfSortThreads;  // threads used to sort one in-memory run block
   int32_t           sourceId;
   SSDataBlock*      pDataBlock;
   SMsortComparParam cmpParam;
@@ -189,6 +197,30 @@ void destroyTuple(void* t) {
   }
 }
 
+int32_t qInitSortPool() {
+  // the calling thread of a sort takes a share of the runs as well
+  int32_t numOfThreads = TMIN((int32_t)(tsNumOfCores / 2), MAX_SORT_THREADS) - 1;
+  if (numOfThreads <= 0 || atomic_load_8(&sortPoolReady)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (taosInitScheduler(SORT_POOL_QUEUE_SIZE, numOfThreads, "sort", &sortPool) == NULL) {
+    qError("failed to start the sort pool, in-memory runs are sorted on the query threads");
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  atomic_store_8(&sortPoolReady, 1);
+  return TSDB_CODE_SUCCESS;
+}
+
+void qCleanupSortPool() {
+  if (atomic_val_compare_exchange_8(&sortPoolReady, 1, 0) == 1) {
+    taosCleanUpScheduler(&sortPool);
+  }
+}
+
+static SSchedQueue* tsortGetSortPool() { return atomic_load_8(&sortPoolReady) ? &sortPool : NULL; }
+
 /**
  *
  * @param type
@@ -204,6 +236,7 @@ SSortHandle* tsortCreateSortHandle(SArray* pSortInfo, int32_t type, int32_t page
   pSortHandle->numOfPages = numOfPages;
   pSortHandle->pSortInfo = pSortInfo;
   pSortHandle->loops = 0;
+  pSortHandle->numOfSortThreads = TMAX(1, TMIN((int32_t)(tsNumOfCores / 2), MAX_SORT_THREADS));
 
   pSortHandle->pqMaxTupleLength = pqMaxTupleLength;
   if (pqMaxRows != 0) {
@@ -1246,7 +1279,8 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     if (size > sortBufSize) {
       // Perform the in-memory sort and then flush data in the buffer into disk.
       int64_t p = taosGetTimestampUs();
-      code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+      code = blockDataSortParallel(pHandle->pDataBlock, pHandle->pSortInfo, tsortGetSortPool(),
+                                   pHandle->numOfSortThreads);
       if (code != 0) {
         if (source->param && !source->onlyRef) {
           taosMemoryFree(source->param);
@@ -1282,7 +1316,8 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
     // Perform the in-memory sort and then flush data in the buffer into disk.
     int64_t p = taosGetTimestampUs();
 
-    code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
+    code = blockDataSortParallel(pHandle->pDataBlock, pHandle->pSortInfo, tsortGetSortPool(),
+                                 pHandle->numOfSortThreads);
     if (code != 0) {
       return code;
     }
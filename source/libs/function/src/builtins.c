@@ -580,7 +580,8 @@ static bool validateApercentileAlgo(const SValueNode* pVal) {
     return false;
   }
   return (0 == strcasecmp(varDataVal(pVal->datum.p), "default") ||
-          0 == strcasecmp(varDataVal(pVal->datum.p), "t-digest"));
+          0 == strcasecmp(varDataVal(pVal->datum.p), "t-digest") ||
+          0 == strcasecmp(varDataVal(pVal->datum.p), "ddsketch"));
 }
 
 static int32_t translateApercentile(SFunctionNode* pFunc, char* pErrBuf, int32_t len) {
@@ -618,7 +619,7 @@ static int32_t translateApercentile(SFunctionNode* pFunc, char* pErrBuf, int32_t
     SNode* pParamNode2 = nodesListGetNode(pFunc->pParameterList, 2);
     if (QUERY_NODE_VALUE != nodeType(pParamNode2) || !validateApercentileAlgo((SValueNode*)pParamNode2)) {
       return buildFuncErrMsg(pErrBuf, len, TSDB_CODE_FUNC_FUNTION_ERROR,
-                             "Third parameter algorithm of apercentile must be 'default' or 't-digest'");
+                             "Third parameter algorithm of apercentile must be 'default', 't-digest' or 'ddsketch'");
     }
 
     pValue = (SValueNode*)pParamNode2;
@@ -665,7 +666,7 @@ static int32_t translateApercentileImpl(SFunctionNode* pFunc, char* pErrBuf, int
       SNode* pParamNode2 = nodesListGetNode(pFunc->pParameterList, 2);
       if (QUERY_NODE_VALUE != nodeType(pParamNode2) || !validateApercentileAlgo((SValueNode*)pParamNode2)) {
         return buildFuncErrMsg(pErrBuf, len, TSDB_CODE_FUNC_FUNTION_ERROR,
-                               "Third parameter algorithm of apercentile must be 'default' or 't-digest'");
+                               "Third parameter algorithm of apercentile must be 'default', 't-digest' or 'ddsketch'");
       }
 
       pValue = (SValueNode*)pParamNode2;
@@ -694,7 +695,7 @@ static int32_t translateApercentileImpl(SFunctionNode* pFunc, char* pErrBuf, int
       SNode* pParamNode2 = nodesListGetNode(pFunc->pParameterList, 2);
       if (QUERY_NODE_VALUE != nodeType(pParamNode2) || !validateApercentileAlgo((SValueNode*)pParamNode2)) {
         return buildFuncErrMsg(pErrBuf, len, TSDB_CODE_FUNC_FUNTION_ERROR,
-                               "Third parameter algorithm of apercentile must be 'default' or 't-digest'");
+                               "Third parameter algorithm of apercentile must be 'default', 't-digest' or 'ddsketch'");
       }
       }
 
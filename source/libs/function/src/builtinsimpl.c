@@ -20,6 +20,7 @@
 #include "querynodes.h"
 #include "tcompare.h"
 #include "tdatablock.h"
+#include "tddsketch.h"
 #include "tdigest.h"
 #include "tfunctionInt.h"
 #include "tglobal.h"
@@ -107,6 +108,7 @@ typedef enum {
   APERCT_ALGO_UNKNOWN = 0,
   APERCT_ALGO_DEFAULT,
   APERCT_ALGO_TDIGEST,
+  APERCT_ALGO_DDSKETCH,
 } EAPerctAlgoType;
 
 typedef struct SDiffInfo {
@@ -321,16 +323,34 @@ typedef struct SGroupKeyInfo {
     }                                                                    \
   } while (0)
 
-#define LIST_ADD_N(_res, _col, _start, _rows, _t, numOfElem)             \
-  do {                                                                   \
-    _t* d = (_t*)(_col->pData);                                          \
-    for (int32_t i = (_start); i < (_rows) + (_start); ++i) {            \
-      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, i)) { \
-        continue;                                                        \
-      };                                                                 \
-      (_res) += (d)[i];                                                  \
-      (numOfElem)++;                                                     \
-    }                                                                    \
+// the loop without null check is left to the compiler to vectorize, and rows are added eight at a time when their
+// byte in the null bitmap is clear
+#define LIST_ADD_N(_res, _col, _start, _rows, _t, numOfElem)                                  \
+  do {                                                                                        \
+    _t*     d = (_t*)(_col->pData);                                                           \
+    int32_t end = (_rows) + (_start);                                                         \
+    if (!(_col)->hasNull) {                                                                   \
+      for (int32_t i = (_start); i < end; ++i) {                                              \
+        (_res) += (d)[i];                                                                     \
+      }                                                                                       \
+      (numOfElem) += (_rows);                                                                 \
+      break;                                                                                  \
+    }                                                                                         \
+    for (int32_t i = (_start); i < end;) {                                                    \
+      if (BitPos(i) == 0 && i + 8 <= end && 0 == (uint8_t)BMCharPos((_col)->nullbitmap, i)) { \
+        for (int32_t j = i; j < i + 8; ++j) {                                                 \
+          (_res) += (d)[j];                                                                   \
+        }                                                                                     \
+        (numOfElem) += 8;                                                                     \
+        i += 8;                                                                               \
+        continue;                                                                             \
+      }                                                                                       \
+      if (!colDataIsNull_f((_col)->nullbitmap, i)) {                                          \
+        (_res) += (d)[i];                                                                     \
+        (numOfElem)++;                                                                        \
+      }                                                                                       \
+      ++i;                                                                                    \
+    }                                                                                         \
   } while (0)
 
 #define LIST_SUB_N(_res, _col, _start, _rows, _t, numOfElem)             \
@@ -489,6 +509,33 @@ bool getCountFuncEnv(SFunctionNode* UNUSED_PARAM(pFunc), SFuncExecEnv* pEnv) {
   return true;
 }
 
+// null rows of a fixed length column in [start, start + numOfRows), counted a 64-bit bitmap word at a time
+static int32_t getNumOfNullInBitmap(const char* bitmap, int32_t start, int32_t numOfRows) {
+  int32_t numOfNull = 0;
+  int32_t end = start + numOfRows;
+  int32_t i = start;
+
+  for (; i < end && BitPos(i) != 0; ++i) {
+    numOfNull += colDataIsNull_f(bitmap, i) ? 1 : 0;
+  }
+
+  for (; i + 64 <= end; i += 64) {
+    uint64_t w = 0;
+    memcpy(&w, &BMCharPos(bitmap, i), sizeof(w));
+    numOfNull += BUILDIN_POPCNTL(w);
+  }
+
+  for (; i + 8 <= end; i += 8) {
+    numOfNull += BUILDIN_POPCNTL((uint8_t)BMCharPos(bitmap, i));
+  }
+
+  for (; i < end; ++i) {
+    numOfNull += colDataIsNull_f(bitmap, i) ? 1 : 0;
+  }
+
+  return numOfNull;
+}
+
 static int64_t getNumOfElems(SqlFunctionCtx* pCtx) {
   int64_t numOfElem = 0;
 
@@ -505,7 +552,10 @@ static int64_t getNumOfElems(SqlFunctionCtx* pCtx) {
   if (pInput->colDataSMAIsSet && pInput->totalRows == pInput->numOfRows) {
     numOfElem = pInput->numOfRows - pInput->pColumnDataAgg[0]->numOfNull;
   } else {
-    if (pInputCol->hasNull) {
+    if (pInputCol->hasNull && !IS_VAR_DATA_TYPE(pInputCol->info.type)) {
+      numOfElem = pInput->numOfRows -
+                  getNumOfNullInBitmap(pInputCol->nullbitmap, pInput->startRowIndex, pInput->numOfRows);
+    } else if (pInputCol->hasNull) {
       for (int32_t i = pInput->startRowIndex; i < pInput->startRowIndex + pInput->numOfRows; ++i) {
         if (colDataIsNull(pInputCol, pInput->totalRows, i, NULL)) {
           continue;
@@ -1797,7 +1847,8 @@ bool getApercentileFuncEnv(SFunctionNode* pFunc, SFuncExecEnv* pEnv) {
   int32_t bytesHist =
       (int32_t)(sizeof(SAPercentileInfo) + sizeof(SHistogramInfo) + sizeof(SHistBin) * (MAX_HISTOGRAM_BIN + 1));
   int32_t bytesDigest = (int32_t)(sizeof(SAPercentileInfo) + TDIGEST_SIZE(COMPRESSION));
-  pEnv->calcMemSize = TMAX(bytesHist, bytesDigest);
+  int32_t bytesSketch = (int32_t)(sizeof(SAPercentileInfo) + sizeof(SDDSketch));
+  pEnv->calcMemSize = TMAX(TMAX(bytesHist, bytesDigest), bytesSketch);
   return true;
 }
 
@@ -1805,7 +1856,8 @@ int32_t getApercentileMaxSize() {
   int32_t bytesHist =
       (int32_t)(sizeof(SAPercentileInfo) + sizeof(SHistogramInfo) + sizeof(SHistBin) * (MAX_HISTOGRAM_BIN + 1));
   int32_t bytesDigest = (int32_t)(sizeof(SAPercentileInfo) + TDIGEST_SIZE(COMPRESSION));
-  return TMAX(bytesHist, bytesDigest);
+  int32_t bytesSketch = (int32_t)(sizeof(SAPercentileInfo) + sizeof(SDDSketch));
+  return TMAX(TMAX(bytesHist, bytesDigest), bytesSketch);
 }
 
 static int8_t getApercentileAlgo(char* algoStr) {
@@ -1814,6 +1866,8 @@ static int8_t getApercentileAlgo(char* algoStr) {
     algoType = APERCT_ALGO_DEFAULT;
   } else if (strcasecmp(algoStr, "t-digest") == 0) {
     algoType = APERCT_ALGO_TDIGEST;
+  } else if (strcasecmp(algoStr, "ddsketch") == 0) {
+    algoType = APERCT_ALGO_DDSKETCH;
   } else {
     algoType = APERCT_ALGO_UNKNOWN;
   }
@@ -1830,6 +1884,11 @@ static void buildTDigestInfo(SAPercentileInfo* pInfo) {
   pInfo->pTDigest = (TDigest*)((char*)pInfo + sizeof(SAPercentileInfo));
 }
 
+// the sketch holds no pointer, so it is located by offset instead of a member of SAPercentileInfo
+static SDDSketch* getDDSketchInfo(SAPercentileInfo* pInfo) {
+  return (SDDSketch*)((char*)pInfo + sizeof(SAPercentileInfo));
+}
+
 bool apercentileFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo) {
   if (!functionSetup(pCtx, pResultInfo)) {
     return false;
@@ -1853,6 +1912,8 @@ bool apercentileFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResult
   char* tmp = (char*)pInfo + sizeof(SAPercentileInfo);
   if (pInfo->algo == APERCT_ALGO_TDIGEST) {
     pInfo->pTDigest = tdigestNewFrom(tmp, COMPRESSION);
+  } else if (pInfo->algo == APERCT_ALGO_DDSKETCH) {
+    (void)tDDSketchNewFrom(tmp);
   } else {
     buildHistogramInfo(pInfo);
     pInfo->pHisto = tHistogramCreateFrom(tmp, MAX_HISTOGRAM_BIN);
@@ -1889,6 +1950,19 @@ int32_t apercentileFunction(SqlFunctionCtx* pCtx) {
       GET_TYPED_DATA(v, double, type, data);
       tdigestAdd(pInfo->pTDigest, v, w);
     }
+  } else if (pInfo->algo == APERCT_ALGO_DDSKETCH) {
+    SDDSketch* pSketch = getDDSketchInfo(pInfo);
+    for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
+      if (colDataIsNull_f(pCol->nullbitmap, i)) {
+        continue;
+      }
+      numOfElems += 1;
+      char* data = colDataGetData(pCol, i);
+
+      double v = 0;
+      GET_TYPED_DATA(v, double, type, data);
+      tDDSketchAdd(pSketch, v, 1);
+    }
   } else {
     // might be a race condition here that pHisto can be overwritten or setup function
     // has not been called, need to relink the buffer pHisto points to.
@@ -1945,6 +2019,22 @@ static void apercentileTransferInfo(SAPercentileInfo* pInput, SAPercentileInfo*
     } else {
       tdigestMerge(pTDigest, pInput->pTDigest);
     }
+  } else if (pOutput->algo == APERCT_ALGO_DDSKETCH) {
+    SDDSketch* pInputSketch = getDDSketchInfo(pInput);
+    if (pInputSketch->count <= 0) {
+      return;
+    }
+
+    if (hasRes) {
+      *hasRes = true;
+    }
+
+    SDDSketch* pSketch = getDDSketchInfo(pOutput);
+    if (pSketch->count <= 0) {
+      memcpy(pSketch, pInputSketch, sizeof(SDDSketch));
+    } else {
+      tDDSketchMerge(pSketch, pInputSketch);
+    }
   } else {
     buildHistogramInfo(pInput);
     if (pInput->pHisto->numOfElems <= 0) {
@@ -2003,7 +2093,7 @@ int32_t apercentileFunctionMerge(SqlFunctionCtx* pCtx) {
     apercentileTransferInfo(pInputInfo, pInfo, &hasRes);
   }
 
-  if (pInfo->algo != APERCT_ALGO_TDIGEST) {
+  if (pInfo->algo == APERCT_ALGO_DEFAULT) {
     buildHistogramInfo(pInfo);
     qDebug("%s after merge, total:%" PRId64 ", numOfEntry:%d, %p", __FUNCTION__, pInfo->pHisto->numOfElems,
            pInfo->pHisto->numOfEntries, pInfo->pHisto);
@@ -2026,6 +2116,11 @@ int32_t apercentileFinalize(SqlFunctionCtx* pCtx, SSDataBlock* pBlock) {
       // setNull(pCtx->pOutput, pCtx->outputType, pCtx->outputBytes);
       return TSDB_CODE_SUCCESS;
     }
+  } else if (pInfo->algo == APERCT_ALGO_DDSKETCH) {
+    SDDSketch* pSketch = getDDSketchInfo(pInfo);
+    if (pSketch->count > 0) {
+      pInfo->result = tDDSketchQuantile(pSketch, pInfo->percent / 100);
+    }
   } else {
     buildHistogramInfo(pInfo);
     if (pInfo->pHisto->numOfElems > 0) {
@@ -3368,68 +3463,158 @@ bool spreadFunctionSetup(SqlFunctionCtx* pCtx, SResultRowEntryInfo* pResultInfo)
   return true;
 }
 
-int32_t spreadFunction(SqlFunctionCtx* pCtx) {
-  int32_t numOfElems = 0;
+// min and max are kept in the input type and converted to double once, which gives the same result as converting
+// every value since the conversion is monotonic. NaN is never taken as min or max, like the row by row comparison.
+#define SPREAD_NO_NAN(_v) false
+
+#define LIST_SPREAD_N(_info, _col, _start, _rows, _t, _isnan, numOfElem)                               \
+  do {                                                                                                 \
+    _t*     d = (_t*)((_col)->pData);                                                                  \
+    int32_t end = (_rows) + (_start);                                                                  \
+    int32_t i = (_start);                                                                              \
+    if ((_col)->hasNull) {                                                                             \
+      (numOfElem) += (_rows) - getNumOfNullInBitmap((_col)->nullbitmap, (_start), (_rows));            \
+    } else {                                                                                           \
+      (numOfElem) += (_rows);                                                                          \
+    }                                                                                                  \
+    while (i < end && (((_col)->hasNull && colDataIsNull_f((_col)->nullbitmap, i)) || _isnan(d[i]))) { \
+      ++i;                                                                                             \
+    }                                                                                                  \
+    if (i >= end) {                                                                                    \
+      break;                                                                                           \
+    }                                                                                                  \
+    _t tmin = d[i], tmax = d[i];                                                                       \
+    if (!(_col)->hasNull) {                                                                            \
+      for (; i < end; ++i) {                                                                           \
+        tmin = (d[i] < tmin) ? d[i] : tmin;                                                            \
+        tmax = (d[i] > tmax) ? d[i] : tmax;                                                            \
+      }                                                                                                \
+    } else {                                                                                           \
+      for (; i < end; ++i) {                                                                           \
+        if (colDataIsNull_f((_col)->nullbitmap, i)) {                                                  \
+          continue;                                                                                    \
+        }                                                                                              \
+        tmin = (d[i] < tmin) ? d[i] : tmin;                                                            \
+        tmax = (d[i] > tmax) ? d[i] : tmax;                                                            \
+      }                                                                                                \
+    }                                                                                                  \
+    if ((double)tmin < GET_DOUBLE_VAL(&(_info)->min)) {                                                \
+      SET_DOUBLE_VAL(&(_info)->min, (double)tmin);                                                     \
+    }                                                                                                  \
+    if ((double)tmax > GET_DOUBLE_VAL(&(_info)->max)) {                                                \
+      SET_DOUBLE_VAL(&(_info)->max, (double)tmax);                                                     \
+    }                                                                                                  \
+  } while (0)
 
-  // Only the pre-computing information loaded and actual data does not loaded
-  SInputColumnInfoData* pInput = &pCtx->input;
-  SColumnDataAgg*       pAgg = pInput->pColumnDataAgg[0];
-  int32_t               type = pInput->pData[0]->info.type;
+static int32_t doSpreadBySma(SSpreadInfo* pInfo, const SInputColumnInfoData* pInput, int32_t type) {
+  SColumnDataAgg* pAgg = pInput->pColumnDataAgg[0];
+  int32_t         numOfElems = pInput->numOfRows - pAgg->numOfNull;
+  if (numOfElems == 0) {
+    return 0;
+  }
 
-  SSpreadInfo* pInfo = GET_ROWCELL_INTERBUF(GET_RES_INFO(pCtx));
+  double tmin = 0.0, tmax = 0.0;
+  if (IS_SIGNED_NUMERIC_TYPE(type) || IS_TIMESTAMP_TYPE(type)) {
+    tmin = (double)GET_INT64_VAL(&pAgg->min);
+    tmax = (double)GET_INT64_VAL(&pAgg->max);
+  } else if (IS_FLOAT_TYPE(type)) {
+    tmin = GET_DOUBLE_VAL(&pAgg->min);
+    tmax = GET_DOUBLE_VAL(&pAgg->max);
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    tmin = (double)GET_UINT64_VAL(&pAgg->min);
+    tmax = (double)GET_UINT64_VAL(&pAgg->max);
+  }
 
-  if (pInput->colDataSMAIsSet) {
-    numOfElems = pInput->numOfRows - pAgg->numOfNull;
-    if (numOfElems == 0) {
-      goto _spread_over;
-    }
-    double tmin = 0.0, tmax = 0.0;
-    if (IS_SIGNED_NUMERIC_TYPE(type) || IS_TIMESTAMP_TYPE(type)) {
-      tmin = (double)GET_INT64_VAL(&pAgg->min);
-      tmax = (double)GET_INT64_VAL(&pAgg->max);
-    } else if (IS_FLOAT_TYPE(type)) {
-      tmin = GET_DOUBLE_VAL(&pAgg->min);
-      tmax = GET_DOUBLE_VAL(&pAgg->max);
-    } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
-      tmin = (double)GET_UINT64_VAL(&pAgg->min);
-      tmax = (double)GET_UINT64_VAL(&pAgg->max);
+  if (GET_DOUBLE_VAL(&pInfo->min) > tmin) {
+    SET_DOUBLE_VAL(&pInfo->min, tmin);
+  }
+
+  if (GET_DOUBLE_VAL(&pInfo->max) < tmax) {
+    SET_DOUBLE_VAL(&pInfo->max, tmax);
+  }
+
+  return numOfElems;
+}
+
+static int32_t doSpreadByRows(SSpreadInfo* pInfo, SColumnInfoData* pCol, int32_t type, int32_t start,
+                              int32_t numOfRows) {
+  int32_t numOfElems = 0;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, int8_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_SMALLINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, int16_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_INT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, int32_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, int64_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_UTINYINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, uint8_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_USMALLINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, uint16_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_UINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, uint32_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_UBIGINT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, uint64_t, SPREAD_NO_NAN, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_FLOAT:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, float, isnan, numOfElems);
+      return numOfElems;
+    case TSDB_DATA_TYPE_DOUBLE:
+      LIST_SPREAD_N(pInfo, pCol, start, numOfRows, double, isnan, numOfElems);
+      return numOfElems;
+    default:
+      break;
+  }
+
+  // check the valid data one by one
+  for (int32_t i = start; i < numOfRows + start; ++i) {
+    if (colDataIsNull_f(pCol->nullbitmap, i)) {
+      continue;
     }
 
-    if (GET_DOUBLE_VAL(&pInfo->min) > tmin) {
-      SET_DOUBLE_VAL(&pInfo->min, tmin);
+    char* data = colDataGetData(pCol, i);
+
+    double v = 0;
+    GET_TYPED_DATA(v, double, type, data);
+    if (v < GET_DOUBLE_VAL(&pInfo->min)) {
+      SET_DOUBLE_VAL(&pInfo->min, v);
     }
 
-    if (GET_DOUBLE_VAL(&pInfo->max) < tmax) {
-      SET_DOUBLE_VAL(&pInfo->max, tmax);
+    if (v > GET_DOUBLE_VAL(&pInfo->max)) {
+      SET_DOUBLE_VAL(&pInfo->max, v);
     }
 
-  } else {  // computing based on the true data block
-    SColumnInfoData* pCol = pInput->pData[0];
+    numOfElems += 1;
+  }
 
-    int32_t start = pInput->startRowIndex;
-    // check the valid data one by one
-    for (int32_t i = start; i < pInput->numOfRows + start; ++i) {
-      if (colDataIsNull_f(pCol->nullbitmap, i)) {
-        continue;
-      }
+  return numOfElems;
+}
 
-      char* data = colDataGetData(pCol, i);
+int32_t spreadFunction(SqlFunctionCtx* pCtx) {
+  int32_t numOfElems = 0;
 
-      double v = 0;
-      GET_TYPED_DATA(v, double, type, data);
-      if (v < GET_DOUBLE_VAL(&pInfo->min)) {
-        SET_DOUBLE_VAL(&pInfo->min, v);
-      }
+  // Only the pre-computing information loaded and actual data does not loaded
+  SInputColumnInfoData* pInput = &pCtx->input;
+  int32_t               type = pInput->pData[0]->info.type;
 
-      if (v > GET_DOUBLE_VAL(&pInfo->max)) {
-        SET_DOUBLE_VAL(&pInfo->max, v);
-      }
+  SSpreadInfo* pInfo = GET_ROWCELL_INTERBUF(GET_RES_INFO(pCtx));
 
-      numOfElems += 1;
-    }
+  if (pInput->colDataSMAIsSet) {
+    numOfElems = doSpreadBySma(pInfo, pInput, type);
+  } else {  // computing based on the true data block
+    numOfElems = doSpreadByRows(pInfo, pInput->pData[0], type, pInput->startRowIndex, pInput->numOfRows);
   }
 
-_spread_over:
   // data in the check operation are all null, not output
   SET_VAL(GET_RES_INFO(pCtx), numOfElems, 1);
   if (numOfElems > 0) {
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <float.h>
+#include <math.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "builtinsimpl.h"
+#include "tdatablock.h"
+
+using namespace std;
+
+#define AGG_ROWS 203
+
+typedef bool (*FNullRow)(int32_t i);
+
+// rows with nulls spread over whole bytes and 64-bit words of the bitmap, and the rows around their edges
+static bool noNull(int32_t i) { return false; }
+static bool allNull(int32_t i) { return true; }
+static bool everyThirdNull(int32_t i) { return i % 3 == 0; }
+static bool edgeNull(int32_t i) { return i == 0 || i == 63 || i == 64 || i == 127 || i == 202; }
+static bool wordHoleNull(int32_t i) { return (i >= 64 && i < 128) ? false : (i * 7) % 5 == 0; }
+static bool oddByteNull(int32_t i) { return (i / 8) % 2 == 1; }
+static bool middleNull(int32_t i) { return i >= 8 && i < 200; }
+
+static FNullRow nullRows[] = {noNull, allNull, everyThirdNull, edgeNull, wordHoleNull, oddByteNull, middleNull};
+
+// [start, start + rows) cover the unaligned heads and tails of the bitmap words and bytes
+static int32_t ranges[][2] = {{0, AGG_ROWS}, {1, AGG_ROWS - 1}, {7, 130}, {8, 64},
+                              {63, 70},    {64, 128},         {5, 3},   {130, 1}};
+
+typedef struct {
+  SqlFunctionCtx   ctx;
+  SExprInfo        expr;
+  SColumnInfoData *pData[1];
+  SColumnDataAgg  *pAgg[1];
+  char            *pResBuf;
+} SAggCtx;
+
+// a block of one column, the result of a function is appended after the rows
+static SSDataBlock *createBlock(int16_t type, int32_t bytes, int32_t rows) {
+  SSDataBlock    *pBlock = createDataBlock();
+  SColumnInfoData col = createColumnInfoData(type, bytes, 1);
+  blockDataAppendColInfo(pBlock, &col);
+  blockDataEnsureCapacity(pBlock, TMAX(rows, 1));
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+static void initCtx(SAggCtx *pCtx, SColumnInfoData *pCol, int32_t start, int32_t rows, int32_t interBufSize) {
+  memset(pCtx, 0, sizeof(SAggCtx));
+  pCtx->pData[0] = pCol;
+  pCtx->pResBuf = (char *)taosMemoryCalloc(1, sizeof(SResultRowEntryInfo) + interBufSize);
+  pCtx->ctx.input.totalRows = AGG_ROWS;
+  pCtx->ctx.input.startRowIndex = start;
+  pCtx->ctx.input.numOfRows = rows;
+  pCtx->ctx.input.numOfInputCols = 1;
+  pCtx->ctx.input.pData = pCtx->pData;
+  pCtx->ctx.input.pColumnDataAgg = pCtx->pAgg;
+  pCtx->ctx.resDataInfo.interBufSize = interBufSize;
+  pCtx->ctx.resultInfo = (SResultRowEntryInfo *)pCtx->pResBuf;
+  pCtx->ctx.pExpr = &pCtx->expr;
+}
+
+static void clearCtx(SAggCtx *pCtx) { taosMemoryFree(pCtx->pResBuf); }
+
+template <typename T>
+static T getValue(int32_t i) {
+  // alternate the signs and keep the extremes off the first and last rows
+  return (T)((i % 2 == 0 ? 1 : -1) * ((i * 37) % 101) + (i == 100 ? 120 : 0));
+}
+
+template <typename T>
+static void fillCol(SColumnInfoData *pCol, FNullRow isNull, bool withNan) {
+  pCol->hasNull = false;
+  memset(pCol->nullbitmap, 0, BitmapLen(AGG_ROWS));
+  for (int32_t i = 0; i < AGG_ROWS; ++i) {
+    T v = getValue<T>(i);
+    if (withNan && i % 11 == 5) {
+      v = (T)NAN;
+    }
+    colDataSetVal(pCol, i, (const char *)&v, false);
+    if (isNull(i)) {
+      colDataSetNULL(pCol, i);
+    }
+  }
+}
+
+static void checkCount(SColumnInfoData *pCol, int32_t start, int32_t rows, int64_t count) {
+  SAggCtx aggCtx;
+  initCtx(&aggCtx, pCol, start, rows, sizeof(int64_t));
+  ASSERT_TRUE(functionSetup(&aggCtx.ctx, aggCtx.ctx.resultInfo));
+  ASSERT_EQ(countFunction(&aggCtx.ctx), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(*(int64_t *)GET_ROWCELL_INTERBUF(aggCtx.ctx.resultInfo), count);
+  clearCtx(&aggCtx);
+}
+
+static void checkSum(SColumnInfoData *pCol, int32_t start, int32_t rows, int64_t count, int64_t isum, uint64_t usum,
+                     double dsum) {
+  int16_t type = pCol->info.type;
+  SAggCtx aggCtx;
+  initCtx(&aggCtx, pCol, start, rows, sizeof(SSumRes));
+  ASSERT_TRUE(functionSetup(&aggCtx.ctx, aggCtx.ctx.resultInfo));
+  ASSERT_EQ(sumFunction(&aggCtx.ctx), TSDB_CODE_SUCCESS);
+
+  SSumRes *pSum = (SSumRes *)GET_ROWCELL_INTERBUF(aggCtx.ctx.resultInfo);
+  if (IS_SIGNED_NUMERIC_TYPE(type)) {
+    ASSERT_EQ(pSum->isum, isum);
+  } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    ASSERT_EQ(pSum->usum, usum);
+  } else if (!isnan(dsum)) {
+    ASSERT_DOUBLE_EQ(pSum->dsum, dsum);
+  }
+  if (!IS_FLOAT_TYPE(type) || !isnan(dsum)) {
+    ASSERT_EQ(aggCtx.ctx.resultInfo->numOfRes, count > 0 ? 1 : 0);
+  }
+  clearCtx(&aggCtx);
+}
+
+// NaN is counted as a value but never taken as the min or max
+static void checkSpread(SColumnInfoData *pCol, int32_t start, int32_t rows, int64_t count, double spread) {
+  SAggCtx aggCtx;
+  initCtx(&aggCtx, pCol, start, rows, getSpreadInfoSize());
+  ASSERT_TRUE(spreadFunctionSetup(&aggCtx.ctx, aggCtx.ctx.resultInfo));
+  ASSERT_EQ(spreadFunction(&aggCtx.ctx), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(aggCtx.ctx.resultInfo->numOfRes, count > 0 ? 1 : 0);
+
+  SSDataBlock *pRes = createBlock(TSDB_DATA_TYPE_DOUBLE, sizeof(double), 0);
+  spreadFinalize(&aggCtx.ctx, pRes);
+  SColumnInfoData *pResCol = (SColumnInfoData *)taosArrayGet(pRes->pDataBlock, 0);
+  bool             isNull = colDataIsNull_f(pResCol->nullbitmap, 0);
+  double           res = *(double *)colDataGetData(pResCol, 0);
+  blockDataDestroy(pRes);
+  clearCtx(&aggCtx);
+
+  if (count == 0) {
+    ASSERT_TRUE(isNull);
+  } else {
+    ASSERT_FALSE(isNull);
+    ASSERT_DOUBLE_EQ(res, spread);
+  }
+}
+
+template <typename T>
+static void checkRange(SColumnInfoData *pCol, int32_t start, int32_t rows) {
+  int64_t  count = 0;
+  int64_t  isum = 0;
+  uint64_t usum = 0;
+  double   dsum = 0;
+  double   dmin = DBL_MAX, dmax = -DBL_MAX;
+  T       *d = (T *)pCol->pData;
+  for (int32_t i = start; i < start + rows; ++i) {
+    if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, i)) {
+      continue;
+    }
+    count++;
+    dsum += d[i];
+    if (!isnan((double)d[i])) {
+      isum += (int64_t)d[i];
+      usum += (uint64_t)d[i];
+      dmin = TMIN(dmin, (double)d[i]);
+      dmax = TMAX(dmax, (double)d[i]);
+    }
+  }
+
+  // the null rows of a fixed length column are counted by the popcount of the bitmap
+  checkCount(pCol, start, rows, count);
+  checkSum(pCol, start, rows, count, isum, usum, dsum);
+  checkSpread(pCol, start, rows, count, dmax - dmin);
+}
+
+template <typename T>
+static void checkType(int16_t type, bool withNan) {
+  SSDataBlock     *pBlock = createBlock(type, sizeof(T), AGG_ROWS);
+  SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t p = 0; p < sizeof(nullRows) / sizeof(nullRows[0]) && !testing::Test::HasFatalFailure(); ++p) {
+    fillCol<T>(pCol, nullRows[p], withNan);
+    for (int32_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]) && !testing::Test::HasFatalFailure(); ++r) {
+      SCOPED_TRACE(testing::Message() << "type:" << type << " pattern:" << p << " start:" << ranges[r][0]
+                                      << " rows:" << ranges[r][1]);
+      checkRange<T>(pCol, ranges[r][0], ranges[r][1]);
+    }
+  }
+  blockDataDestroy(pBlock);
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+// count, sum and spread of the signed integer columns
+TEST(testCase, aggSignedTypesTest) {
+  checkType<int8_t>(TSDB_DATA_TYPE_TINYINT, false);
+  checkType<int16_t>(TSDB_DATA_TYPE_SMALLINT, false);
+  checkType<int32_t>(TSDB_DATA_TYPE_INT, false);
+  checkType<int64_t>(TSDB_DATA_TYPE_BIGINT, false);
+}
+
+// count, sum and spread of the unsigned integer columns
+TEST(testCase, aggUnsignedTypesTest) {
+  checkType<uint8_t>(TSDB_DATA_TYPE_UTINYINT, false);
+  checkType<uint16_t>(TSDB_DATA_TYPE_USMALLINT, false);
+  checkType<uint32_t>(TSDB_DATA_TYPE_UINT, false);
+  checkType<uint64_t>(TSDB_DATA_TYPE_UBIGINT, false);
+}
+
+// count, sum and spread of the float columns
+TEST(testCase, aggFloatTypesTest) {
+  checkType<float>(TSDB_DATA_TYPE_FLOAT, false);
+  checkType<double>(TSDB_DATA_TYPE_DOUBLE, false);
+}
+
+// count, sum and spread of the float columns holding NaN
+TEST(testCase, aggFloatNanTest) {
+  checkType<float>(TSDB_DATA_TYPE_FLOAT, true);
+  checkType<double>(TSDB_DATA_TYPE_DOUBLE, true);
+}
+
+#pragma GCC diagnostic pop
@@ -265,6 +265,8 @@ struct SFilterInfo {
   uint32_t          blkGroupNum;
   uint32_t         *blkUnits;
   int8_t           *blkUnitRes;
+  int8_t           *execBuf;  // group and unit results of the columnar path
+  int32_t           execBufRows;
   void             *pTable;
   SArray           *blkList;
 
@@ -1889,6 +1889,7 @@ void filterFreeInfo(SFilterInfo *info) {
   taosArrayDestroy(info->sclCtx.fltSclRange);
 
   taosMemoryFreeClear(info->cunits);
+  taosMemoryFreeClear(info->execBuf);
   taosMemoryFreeClear(info->blkUnitRes);
   taosMemoryFreeClear(info->blkUnits);
 
@@ -3100,6 +3101,350 @@ _return:
   return TSDB_CODE_SUCCESS;
 }
 
+// Column-at-a-time kernels for range units on fixed-length columns. They evaluate a whole column into the int8 result
+// array without going through gRangeCompare/gDataCompare per row, and leave null handling to filterClearNullRows.
+typedef void (*fltRangeKernel)(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr, int8_t rfunc,
+                               int8_t *p);
+
+// index by rfunc, see gRangeCompare
+#define FLT_RANGE_LOOP(_rfunc, _gt, _ge, _lt, _le)      \
+  do {                                                  \
+    switch (_rfunc) {                                   \
+      case 0:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_gt(v[i], lo)) & (_lt(v[i], hi));     \
+        }                                               \
+        break;                                          \
+      case 1:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_gt(v[i], lo)) & (_le(v[i], hi));     \
+        }                                               \
+        break;                                          \
+      case 2:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_ge(v[i], lo)) & (_lt(v[i], hi));     \
+        }                                               \
+        break;                                          \
+      case 3:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_ge(v[i], lo)) & (_le(v[i], hi));     \
+        }                                               \
+        break;                                          \
+      case 4:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_gt(v[i], lo));                       \
+        }                                               \
+        break;                                          \
+      case 5:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_ge(v[i], lo));                       \
+        }                                               \
+        break;                                          \
+      case 6:                                           \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_lt(v[i], hi));                       \
+        }                                               \
+        break;                                          \
+      default:                                          \
+        for (int32_t i = 0; i < numOfRows; ++i) {       \
+          p[i] = (_le(v[i], hi));                       \
+        }                                               \
+        break;                                          \
+    }                                                   \
+  } while (0)
+
+#define FLT_INT_GT(_v, _r) ((_v) > (_r))
+#define FLT_INT_GE(_v, _r) ((_v) >= (_r))
+#define FLT_INT_LT(_v, _r) ((_v) < (_r))
+#define FLT_INT_LE(_v, _r) ((_v) <= (_r))
+
+// same result as compareFloatVal/compareDoubleVal: values within the tolerance are equal and NaN is the smallest value
+#define FLT_REAL_GT(_v, _r) (FLT_GREATER(_v, _r))
+#define FLT_REAL_GE(_v, _r) (FLT_GREATEREQUAL(_v, _r))
+// isnan only promises a non-zero value, the result array needs 0 or 1
+#define FLT_REAL_LT(_v, _r) (FLT_LESS(_v, _r) | (isnan(_v) != 0))
+#define FLT_REAL_LE(_v, _r) (FLT_LESSEQUAL(_v, _r) | (isnan(_v) != 0))
+
+#define FLT_DEFINE_RANGE_KERNEL(_name, _type, _gt, _ge, _lt, _le)                                                  \
+  static void _name(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr, int8_t rfunc, \
+                    int8_t *p) {                                                                                 \
+    const _type *v = (const _type *)pCol;                                                                        \
+    _type        lo = *(const _type *)minr;                                                                      \
+    _type        hi = *(const _type *)maxr;                                                                      \
+    FLT_RANGE_LOOP(rfunc, _gt, _ge, _lt, _le);                                                                   \
+  }
+
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelI8, int8_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelI16, int16_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelI32, int32_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelI64, int64_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelU8, uint8_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelU16, uint16_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelU32, uint32_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelU64, uint64_t, FLT_INT_GT, FLT_INT_GE, FLT_INT_LT, FLT_INT_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelFloat, float, FLT_REAL_GT, FLT_REAL_GE, FLT_REAL_LT, FLT_REAL_LE)
+FLT_DEFINE_RANGE_KERNEL(filterRangeKernelDouble, double, FLT_REAL_GT, FLT_REAL_GE, FLT_REAL_LT, FLT_REAL_LE)
+
+#if __AVX2__
+// lower bound: 0 none, 1 exclusive, 2 inclusive; upper bound likewise, index by rfunc
+static const int8_t gRangeLowerBound[] = {1, 1, 2, 2, 1, 2, 0, 0};
+static const int8_t gRangeUpperBound[] = {1, 2, 1, 2, 0, 0, 1, 2};
+
+#define FLT_STORE_MASK(_p, _mask, _width)  \
+  do {                                     \
+    for (int32_t k = 0; k < (_width); ++k) { \
+      (_p)[k] = ((_mask) >> k) & 1;        \
+    }                                      \
+  } while (0)
+
+static void filterRangeKernelI64AVX2(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr,
+                                     int8_t rfunc, int8_t *p) {
+  const int64_t *v = (const int64_t *)pCol;
+  int64_t        lo = *(const int64_t *)minr;
+  int64_t        hi = *(const int64_t *)maxr;
+  int8_t         lb = gRangeLowerBound[rfunc];
+  int8_t         ub = gRangeUpperBound[rfunc];
+  __m256i        vlo = _mm256_set1_epi64x(lo);
+  __m256i        vhi = _mm256_set1_epi64x(hi);
+  __m256i        ones = _mm256_set1_epi64x(-1);
+  int32_t        i = 0;
+
+  for (; i + 4 <= numOfRows; i += 4) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i r = ones;
+    if (lb == 1) {
+      r = _mm256_cmpgt_epi64(x, vlo);
+    } else if (lb == 2) {
+      r = _mm256_andnot_si256(_mm256_cmpgt_epi64(vlo, x), ones);
+    }
+    if (ub == 1) {
+      r = _mm256_and_si256(r, _mm256_cmpgt_epi64(vhi, x));
+    } else if (ub == 2) {
+      r = _mm256_andnot_si256(_mm256_cmpgt_epi64(x, vhi), r);
+    }
+
+    int32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(r));
+    FLT_STORE_MASK(p + i, mask, 4);
+  }
+
+  if (i < numOfRows) {
+    filterRangeKernelI64(v + i, numOfRows - i, minr, maxr, rfunc, p + i);
+  }
+}
+
+static void filterRangeKernelI32AVX2(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr,
+                                     int8_t rfunc, int8_t *p) {
+  const int32_t *v = (const int32_t *)pCol;
+  int32_t        lo = *(const int32_t *)minr;
+  int32_t        hi = *(const int32_t *)maxr;
+  int8_t         lb = gRangeLowerBound[rfunc];
+  int8_t         ub = gRangeUpperBound[rfunc];
+  __m256i        vlo = _mm256_set1_epi32(lo);
+  __m256i        vhi = _mm256_set1_epi32(hi);
+  __m256i        ones = _mm256_set1_epi32(-1);
+  int32_t        i = 0;
+
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i r = ones;
+    if (lb == 1) {
+      r = _mm256_cmpgt_epi32(x, vlo);
+    } else if (lb == 2) {
+      r = _mm256_andnot_si256(_mm256_cmpgt_epi32(vlo, x), ones);
+    }
+    if (ub == 1) {
+      r = _mm256_and_si256(r, _mm256_cmpgt_epi32(vhi, x));
+    } else if (ub == 2) {
+      r = _mm256_andnot_si256(_mm256_cmpgt_epi32(x, vhi), r);
+    }
+
+    int32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(r));
+    FLT_STORE_MASK(p + i, mask, 8);
+  }
+
+  if (i < numOfRows) {
+    filterRangeKernelI32(v + i, numOfRows - i, minr, maxr, rfunc, p + i);
+  }
+}
+
+static void filterRangeKernelDoubleAVX2(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr,
+                                        int8_t rfunc, int8_t *p) {
+  const double *v = (const double *)pCol;
+  double        lo = *(const double *)minr;
+  double        hi = *(const double *)maxr;
+  int8_t        lb = gRangeLowerBound[rfunc];
+  int8_t        ub = gRangeUpperBound[rfunc];
+  __m256d       vlo = _mm256_set1_pd(lo);
+  __m256d       vhi = _mm256_set1_pd(hi);
+  __m256d       tol = _mm256_set1_pd(FLT_COMPAR_TOL_FACTOR * FLT_EPSILON);
+  __m256d       absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(INT64_MAX));
+  __m256d       ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  int32_t       i = 0;
+
+  for (; i + 4 <= numOfRows; i += 4) {
+    __m256d x = _mm256_loadu_pd(v + i);
+    __m256d r = ones;
+    if (lb != 0) {
+      __m256d eq = _mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(x, vlo), absMask), tol, _CMP_LE_OQ);
+      __m256d gt = _mm256_cmp_pd(x, vlo, _CMP_GT_OQ);
+      r = (lb == 1) ? _mm256_andnot_pd(eq, gt) : _mm256_or_pd(eq, gt);
+    }
+    if (ub != 0) {
+      __m256d eq = _mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(x, vhi), absMask), tol, _CMP_LE_OQ);
+      __m256d lt = _mm256_cmp_pd(x, vhi, _CMP_LT_OQ);
+      __m256d nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+      __m256d c = (ub == 1) ? _mm256_andnot_pd(eq, lt) : _mm256_or_pd(eq, lt);
+      r = _mm256_and_pd(r, _mm256_or_pd(c, nan));
+    }
+
+    int32_t mask = _mm256_movemask_pd(r);
+    FLT_STORE_MASK(p + i, mask, 4);
+  }
+
+  if (i < numOfRows) {
+    filterRangeKernelDouble(v + i, numOfRows - i, minr, maxr, rfunc, p + i);
+  }
+}
+
+static void filterRangeKernelFloatAVX2(const void *pCol, int32_t numOfRows, const void *minr, const void *maxr,
+                                       int8_t rfunc, int8_t *p) {
+  const float *v = (const float *)pCol;
+  float        lo = *(const float *)minr;
+  float        hi = *(const float *)maxr;
+  int8_t       lb = gRangeLowerBound[rfunc];
+  int8_t       ub = gRangeUpperBound[rfunc];
+  __m256       vlo = _mm256_set1_ps(lo);
+  __m256       vhi = _mm256_set1_ps(hi);
+  __m256       tol = _mm256_set1_ps(FLT_COMPAR_TOL_FACTOR * FLT_EPSILON);
+  __m256       absMask = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MAX));
+  __m256       ones = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  int32_t      i = 0;
+
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256 x = _mm256_loadu_ps(v + i);
+    __m256 r = ones;
+    if (lb != 0) {
+      __m256 eq = _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(x, vlo), absMask), tol, _CMP_LE_OQ);
+      __m256 gt = _mm256_cmp_ps(x, vlo, _CMP_GT_OQ);
+      r = (lb == 1) ? _mm256_andnot_ps(eq, gt) : _mm256_or_ps(eq, gt);
+    }
+    if (ub != 0) {
+      __m256 eq = _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(x, vhi), absMask), tol, _CMP_LE_OQ);
+      __m256 lt = _mm256_cmp_ps(x, vhi, _CMP_LT_OQ);
+      __m256 nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+      __m256 c = (ub == 1) ? _mm256_andnot_ps(eq, lt) : _mm256_or_ps(eq, lt);
+      r = _mm256_and_ps(r, _mm256_or_ps(c, nan));
+    }
+
+    int32_t mask = _mm256_movemask_ps(r);
+    FLT_STORE_MASK(p + i, mask, 8);
+  }
+
+  if (i < numOfRows) {
+    filterRangeKernelFloat(v + i, numOfRows - i, minr, maxr, rfunc, p + i);
+  }
+}
+#endif
+
+static fltRangeKernel filterGetRangeKernel(SFilterComUnit *cunit) {
+  SColumnInfoData *pData = (SColumnInfoData *)cunit->colData;
+  if (cunit->rfunc < 0 || pData == NULL || pData->pData == NULL || pData->info.type != cunit->dataType ||
+      IS_VAR_DATA_TYPE(pData->info.type) || pData->info.bytes != tDataTypes[pData->info.type].bytes) {
+    return NULL;
+  }
+
+  bool simd = false;
+#if __AVX2__
+  simd = tsAVX2Enable && tsSIMDEnable;
+#endif
+
+  switch (pData->info.type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return filterRangeKernelI8;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return filterRangeKernelI16;
+    case TSDB_DATA_TYPE_INT:
+#if __AVX2__
+      if (simd) return filterRangeKernelI32AVX2;
+#endif
+      return filterRangeKernelI32;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+#if __AVX2__
+      if (simd) return filterRangeKernelI64AVX2;
+#endif
+      return filterRangeKernelI64;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return filterRangeKernelU8;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return filterRangeKernelU16;
+    case TSDB_DATA_TYPE_UINT:
+      return filterRangeKernelU32;
+    case TSDB_DATA_TYPE_UBIGINT:
+      return filterRangeKernelU64;
+    case TSDB_DATA_TYPE_FLOAT:
+      // a NaN bound does not order like the column values, leave it to compareFloatVal
+      if (isnan(*(float *)cunit->valData) || isnan(*(float *)cunit->valData2)) return NULL;
+#if __AVX2__
+      if (simd) return filterRangeKernelFloatAVX2;
+#endif
+      return filterRangeKernelFloat;
+    case TSDB_DATA_TYPE_DOUBLE:
+      if (isnan(*(double *)cunit->valData) || isnan(*(double *)cunit->valData2)) return NULL;
+#if __AVX2__
+      if (simd) return filterRangeKernelDoubleAVX2;
+#endif
+      return filterRangeKernelDouble;
+    default:
+      return NULL;
+  }
+}
+
+// clear the result of null rows, skipping 64 rows at a time when the null bitmap word is zero
+static void filterClearNullRows(SColumnInfoData *pData, int32_t numOfRows, int8_t *p) {
+  if (!pData->hasNull || pData->nullbitmap == NULL) {
+    return;
+  }
+
+  const char *bm = pData->nullbitmap;
+  int32_t     len = BitmapLen(numOfRows);
+
+  for (int32_t b = 0; b < len; b += sizeof(uint64_t)) {
+    int32_t n = TMIN(len - b, (int32_t)sizeof(uint64_t));
+    if (n == sizeof(uint64_t)) {
+      uint64_t w = 0;
+      memcpy(&w, bm + b, sizeof(w));
+      if (w == 0) {
+        continue;
+      }
+    }
+
+    for (int32_t j = b; j < b + n; ++j) {
+      if (bm[j] == 0) {
+        continue;
+      }
+
+      int32_t end = TMIN((j + 1) << NBIT, numOfRows);
+      for (int32_t i = j << NBIT; i < end; ++i) {
+        if (colDataIsNull_f(bm, i)) {
+          p[i] = 0;
+        }
+      }
+    }
+  }
+}
+
+static bool filterCountQualified(const int8_t *p, int32_t numOfRows, int32_t *numOfQualified) {
+  int32_t num = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    num += p[i];
+  }
+
+  (*numOfQualified) += num;
+  return num == numOfRows;
+}
+
 static FORCE_INLINE bool filterExecuteImplAll(void *info, int32_t numOfRows, SColumnInfoData *p, SColumnDataAgg *statis,
                                               int16_t numOfCols, int32_t *numOfQualified) {
   return true;
@@ -3174,7 +3519,15 @@ bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRe
     return all;
   }
 
-  int8_t *p = (int8_t *)pRes->pData;
+  int8_t        *p = (int8_t *)pRes->pData;
+  fltRangeKernel kernel = filterGetRangeKernel(&info->cunits[0]);
+
+  if (kernel) {
+    SColumnInfoData *pData = info->cunits[0].colData;
+    (*kernel)(pData->pData, numOfRows, valData, valData2, info->cunits[0].rfunc, p);
+    filterClearNullRows(pData, numOfRows, p);
+    return filterCountQualified(p, numOfRows, numOfQualified);
+  }
 
   for (int32_t i = 0; i < numOfRows; ++i) {
     SColumnInfoData *pData = info->cunits[0].colData;
@@ -3246,67 +3599,54 @@ bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes
   return all;
 }
 
-bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis, int16_t numOfCols,
-                       int32_t *numOfQualified) {
-  SFilterInfo *info = (SFilterInfo *)pinfo;
-  bool         all = true;
+static int8_t filterExecuteUnitRow(SFilterComUnit *cunit, int32_t i) {
+  int8_t  res = 0;
+  void   *colData = NULL;
+  bool    isNull = colDataIsNull((SColumnInfoData *)(cunit->colData), 0, i, NULL);
+  uint8_t optr = cunit->optr;
 
-  if (filterExecuteBasedOnStatis(info, numOfRows, pRes, statis, numOfCols, &all) == 0) {
-    return all;
+  if (!isNull) {
+    colData = colDataGetData((SColumnInfoData *)(cunit->colData), i);
   }
 
-  int8_t *p = (int8_t *)pRes->pData;
+  if (colData == NULL || isNull) {
+    res = optr == OP_TYPE_IS_NULL ? true : false;
+  } else {
+    if (optr == OP_TYPE_IS_NOT_NULL) {
+      res = 1;
+    } else if (optr == OP_TYPE_IS_NULL) {
+      res = 0;
+    } else if (cunit->rfunc >= 0) {
+      res = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2,
+                                           gDataCompare[cunit->func]);
+    } else {
+      if (cunit->dataType == TSDB_DATA_TYPE_NCHAR && (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
+        char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
+        int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
+        if (len < 0) {
+          qError("castConvert1 taosUcs4ToMbs error");
+        } else {
+          varDataSetLen(newColData, len);
+          res = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
+        }
+        taosMemoryFreeClear(newColData);
+      } else {
+        res = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
+      }
+    }
+  }
 
-  for (int32_t i = 0; i < numOfRows; ++i) {
-    // FILTER_UNIT_CLR_F(info);
+  return res;
+}
+
+static bool filterExecuteImplRow(SFilterInfo *info, int32_t numOfRows, int8_t *p, int32_t *numOfQualified) {
+  bool all = true;
 
+  for (int32_t i = 0; i < numOfRows; ++i) {
     for (uint32_t g = 0; g < info->groupNum; ++g) {
       SFilterGroup *group = &info->groups[g];
       for (uint32_t u = 0; u < group->unitNum; ++u) {
-        uint32_t        uidx = group->unitIdxs[u];
-        SFilterComUnit *cunit = &info->cunits[uidx];
-        void           *colData = NULL;
-        bool            isNull = colDataIsNull((SColumnInfoData *)(cunit->colData), 0, i, NULL);
-        // if (FILTER_UNIT_GET_F(info, uidx)) {
-        //   p[i] = FILTER_UNIT_GET_R(info, uidx);
-        // } else {
-        uint8_t optr = cunit->optr;
-
-        if (!isNull) {
-          colData = colDataGetData((SColumnInfoData *)(cunit->colData), i);
-        }
-
-        if (colData == NULL || isNull) {
-          p[i] = optr == OP_TYPE_IS_NULL ? true : false;
-        } else {
-          if (optr == OP_TYPE_IS_NOT_NULL) {
-            p[i] = 1;
-          } else if (optr == OP_TYPE_IS_NULL) {
-            p[i] = 0;
-          } else if (cunit->rfunc >= 0) {
-            p[i] = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2,
-                                                  gDataCompare[cunit->func]);
-          } else {
-            if (cunit->dataType == TSDB_DATA_TYPE_NCHAR &&
-                (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
-              char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
-              int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
-              if (len < 0) {
-                qError("castConvert1 taosUcs4ToMbs error");
-              } else {
-                varDataSetLen(newColData, len);
-                p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
-              }
-              taosMemoryFreeClear(newColData);
-            } else {
-              p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
-            }
-          }
-
-          // FILTER_UNIT_SET_R(info, uidx, p[i]);
-          // FILTER_UNIT_SET_F(info, uidx);
-        }
-
+        p[i] = filterExecuteUnitRow(&info->cunits[group->unitIdxs[u]], i);
         if (p[i] == 0) {
           break;
         }
@@ -3327,6 +3667,73 @@ bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SC
   return all;
 }
 
+// AND one unit into the group result of all rows. Range units on fixed-length columns go through a column kernel,
+// the others are evaluated only on the rows still alive in the group and not yet qualified by an earlier group.
+static void filterExecuteUnitColumn(SFilterComUnit *cunit, int32_t numOfRows, const int8_t *p, int8_t *pGroup,
+                                    int8_t *pUnit) {
+  fltRangeKernel kernel = filterGetRangeKernel(cunit);
+
+  if (kernel) {
+    SColumnInfoData *pData = (SColumnInfoData *)cunit->colData;
+    (*kernel)(pData->pData, numOfRows, cunit->valData, cunit->valData2, cunit->rfunc, pUnit);
+    filterClearNullRows(pData, numOfRows, pUnit);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      pGroup[i] &= pUnit[i];
+    }
+    return;
+  }
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    if (pGroup[i] && !p[i]) {
+      pGroup[i] = filterExecuteUnitRow(cunit, i);
+    }
+  }
+}
+
+bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis, int16_t numOfCols,
+                       int32_t *numOfQualified) {
+  SFilterInfo *info = (SFilterInfo *)pinfo;
+  bool         all = true;
+
+  if (filterExecuteBasedOnStatis(info, numOfRows, pRes, statis, numOfCols, &all) == 0) {
+    return all;
+  }
+
+  int8_t *p = (int8_t *)pRes->pData;
+
+  if (info->execBufRows < numOfRows) {
+    int8_t *buf = taosMemoryRealloc(info->execBuf, (int64_t)numOfRows * 2);
+    if (buf == NULL) {
+      return filterExecuteImplRow(info, numOfRows, p, numOfQualified);
+    }
+    info->execBuf = buf;
+    info->execBufRows = numOfRows;
+  }
+
+  int8_t *pGroup = info->execBuf;
+  int8_t *pUnit = info->execBuf + numOfRows;
+
+  // groups are OR-ed and units in a group are AND-ed, one column at a time
+  memset(p, 0, numOfRows);
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      pGroup[i] = !p[i];
+    }
+
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      filterExecuteUnitColumn(&info->cunits[group->unitIdxs[u]], numOfRows, p, pGroup, pUnit);
+    }
+
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      p[i] |= pGroup[i];
+    }
+  }
+
+  return filterCountQualified(p, numOfRows, numOfQualified);
+}
+
 int32_t filterSetExecFunc(SFilterInfo *info) {
   if (FILTER_ALL_RES(info)) {
     info->func = filterExecuteImplAll;
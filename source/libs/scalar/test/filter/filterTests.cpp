@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -1341,6 +1342,202 @@ TEST(scalarModelogicTest, diff_columns_or_and_or) {
 }
 #endif
 
+// a range condition: groups are OR-ed, the units of a group are AND-ed
+template <class T>
+using RangeCond = std::vector<std::vector<std::pair<EOperatorType, T>>>;
+
+template <class T>
+static bool compareRange(EOperatorType op, T v, T r) {
+  // NaN is the smallest value, as in compareFloatVal and compareDoubleVal
+  if (std::isnan((double)v)) {
+    return op == OP_TYPE_LOWER_THAN || op == OP_TYPE_LOWER_EQUAL;
+  }
+
+  switch (op) {
+    case OP_TYPE_GREATER_THAN:
+      return v > r;
+    case OP_TYPE_GREATER_EQUAL:
+      return v >= r;
+    case OP_TYPE_LOWER_THAN:
+      return v < r;
+    case OP_TYPE_LOWER_EQUAL:
+      return v <= r;
+    default:
+      return false;
+  }
+}
+
+template <class T>
+static SNode *makeRangeCond(int32_t type, const RangeCond<T> &cond) {
+  SNodeList *groups = nodesMakeList();
+  for (auto &group : cond) {
+    SNodeList *units = nodesMakeList();
+    for (auto &unit : group) {
+      SNode *pCol = NULL, *pVal = NULL, *pOp = NULL;
+      T      val = unit.second;
+      flttMakeColumnNode(&pCol, NULL, type, sizeof(T), 0, NULL);
+      flttMakeValueNode(&pVal, type, &val);
+      flttMakeOpNode(&pOp, unit.first, TSDB_DATA_TYPE_BOOL, pCol, pVal);
+      nodesListAppend(units, pOp);
+    }
+    SNode *pGroup = NULL;
+    flttMakeLogicNodeFromList(&pGroup, LOGIC_COND_TYPE_AND, units);
+    nodesListAppend(groups, pGroup);
+  }
+
+  SNode *pCond = NULL;
+  flttMakeLogicNodeFromList(&pCond, LOGIC_COND_TYPE_OR, groups);
+  return pCond;
+}
+
+// evaluate cond on a column of values, with nulls at the rows where isNull is set, with and without SIMD kernels
+template <class T>
+static void checkRangeKernel(int32_t type, const std::vector<T> &values, const std::vector<bool> &isNull,
+                             const RangeCond<T> &cond) {
+  int32_t      rows = (int32_t)values.size();
+  SSDataBlock *src = NULL;
+  SNode       *pCol = NULL;
+  flttMakeColumnNode(&pCol, &src, type, sizeof(T), rows, (void *)values.data());
+  nodesDestroyNode(pCol);
+
+  SColumnInfoData *pData = (SColumnInfoData *)taosArrayGetLast(src->pDataBlock);
+  for (int32_t i = 0; i < rows; ++i) {
+    if (isNull[i]) {
+      colDataSetNULL(pData, i);
+    }
+  }
+
+  std::vector<int8_t> expect(rows, 0);
+  for (int32_t i = 0; i < rows; ++i) {
+    if (isNull[i]) {
+      continue;
+    }
+    for (auto &group : cond) {
+      bool qualified = true;
+      for (auto &unit : group) {
+        qualified = qualified && compareRange(unit.first, values[i], unit.second);
+      }
+      if (qualified) {
+        expect[i] = 1;
+        break;
+      }
+    }
+  }
+
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+  char simdEnable = tsSIMDEnable, avx2Enable = tsAVX2Enable;
+
+  for (int32_t simd = 0; simd < 2; ++simd) {
+    tsSIMDEnable = simd;
+    tsAVX2Enable = simd && avx2;
+
+    SNode       *pCond = makeRangeCond(type, cond);
+    SFilterInfo *filter = NULL;
+    ASSERT_EQ(filterInitFromNode(pCond, &filter, 0), 0);
+    ASSERT_FALSE(filter->scalarMode);
+
+    SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+    ASSERT_EQ(filterSetDataFromSlotId(filter, &param), 0);
+
+    SColumnInfoData *pRes = NULL;
+    int32_t          status = 0;
+    ASSERT_EQ(filterExecute(filter, src, &pRes, NULL, param.numOfCols, &status), 0);
+    for (int32_t i = 0; i < rows; ++i) {
+      ASSERT_EQ(((int8_t *)pRes->pData)[i], expect[i]) << "row " << i << ", simd " << simd;
+    }
+
+    colDataDestroy(pRes);
+    taosMemoryFree(pRes);
+    filterFreeInfo(filter);
+    nodesDestroyNode(pCond);
+  }
+
+  tsSIMDEnable = simdEnable;
+  tsAVX2Enable = avx2Enable;
+  blockDataDestroy(src);
+}
+
+// more rows than one null bitmap word covers, with a tail that is not a multiple of the SIMD width
+#define RANGE_ROWS 203
+
+static std::vector<bool> getRangeNulls() {
+  std::vector<bool> isNull(RANGE_ROWS, false);
+  for (int32_t i = 0; i < RANGE_ROWS; ++i) {
+    // rows 64 ~ 127 have no null, so that their bitmap word is skipped
+    isNull[i] = (i < 64 && i % 11 == 3) || (i >= 128 && i % 5 == 0);
+  }
+  return isNull;
+}
+
+template <class T>
+static std::vector<T> getRangeRealValues() {
+  std::vector<T> values(RANGE_ROWS);
+  for (int32_t i = 0; i < RANGE_ROWS; ++i) {
+    values[i] = (i % 7 == 0) ? (T)NAN : (T)(i % 23 - 5);
+  }
+  return values;
+}
+
+template <class T>
+static std::vector<T> getRangeIntValues(int64_t offset) {
+  std::vector<T> values(RANGE_ROWS);
+  for (int32_t i = 0; i < RANGE_ROWS; ++i) {
+    values[i] = (T)(i * 7 % 150 + offset);
+  }
+  return values;
+}
+
+// double ranges over NaN and null rows
+TEST(testCase, filterRangeDoubleNanTest) {
+  std::vector<double> values = getRangeRealValues<double>();
+  std::vector<bool>   isNull = getRangeNulls();
+
+  checkRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE, values, isNull, {{{OP_TYPE_LOWER_THAN, 10.0}}});
+  checkRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE, values, isNull, {{{OP_TYPE_LOWER_EQUAL, 10.0}}});
+  checkRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE, values, isNull, {{{OP_TYPE_GREATER_THAN, 3.0}}});
+  checkRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE, values, isNull, {{{OP_TYPE_GREATER_EQUAL, 3.0}}});
+  checkRangeKernel<double>(TSDB_DATA_TYPE_DOUBLE, values, isNull,
+                           {{{OP_TYPE_GREATER_THAN, 3.0}, {OP_TYPE_LOWER_EQUAL, 10.0}}});
+}
+
+// float ranges over NaN and null rows
+TEST(testCase, filterRangeFloatNanTest) {
+  std::vector<float> values = getRangeRealValues<float>();
+  std::vector<bool>  isNull = getRangeNulls();
+
+  checkRangeKernel<float>(TSDB_DATA_TYPE_FLOAT, values, isNull, {{{OP_TYPE_LOWER_THAN, 10.0f}}});
+  checkRangeKernel<float>(TSDB_DATA_TYPE_FLOAT, values, isNull, {{{OP_TYPE_LOWER_EQUAL, -2.0f}}});
+  checkRangeKernel<float>(TSDB_DATA_TYPE_FLOAT, values, isNull,
+                          {{{OP_TYPE_GREATER_EQUAL, 3.0f}, {OP_TYPE_LOWER_THAN, 10.0f}}});
+}
+
+// OR-ed groups of integer ranges
+TEST(testCase, filterRangeIntGroupsTest) {
+  std::vector<bool> isNull = getRangeNulls();
+
+  std::vector<int32_t> i32 = getRangeIntValues<int32_t>(-20);
+  checkRangeKernel<int32_t>(TSDB_DATA_TYPE_INT, i32, isNull,
+                            {{{OP_TYPE_GREATER_THAN, 3}, {OP_TYPE_LOWER_THAN, 10}},
+                             {{OP_TYPE_LOWER_EQUAL, -5}},
+                             {{OP_TYPE_GREATER_EQUAL, 100}}});
+
+  std::vector<int64_t> i64 = getRangeIntValues<int64_t>(-20);
+  checkRangeKernel<int64_t>(TSDB_DATA_TYPE_BIGINT, i64, isNull,
+                            {{{OP_TYPE_GREATER_EQUAL, 0}, {OP_TYPE_LOWER_EQUAL, 50}},
+                             {{OP_TYPE_GREATER_THAN, 120}}});
+
+  std::vector<int16_t> i16 = getRangeIntValues<int16_t>(-20);
+  checkRangeKernel<int16_t>(TSDB_DATA_TYPE_SMALLINT, i16, isNull, {{{OP_TYPE_LOWER_THAN, 0}}});
+
+  std::vector<uint8_t> u8 = getRangeIntValues<uint8_t>(0);
+  checkRangeKernel<uint8_t>(TSDB_DATA_TYPE_UTINYINT, u8, isNull,
+                            {{{OP_TYPE_GREATER_THAN, 10}, {OP_TYPE_LOWER_EQUAL, 100}}});
+
+  std::vector<uint64_t> u64 = getRangeIntValues<uint64_t>(0);
+  checkRangeKernel<uint64_t>(TSDB_DATA_TYPE_UBIGINT, u64, isNull, {{{OP_TYPE_GREATER_EQUAL, 140}}});
+}
+
 template <class SignedT, class UnsignedT>
 int32_t compareSignedWithUnsigned(SignedT l, UnsignedT r) {
   if (l < 0) return -1;
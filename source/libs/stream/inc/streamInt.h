@@ -35,6 +35,8 @@ extern "C" {
 #define MAX_BLOCK_NAME_NUM         1024
 #define DISPATCH_RETRY_INTERVAL_MS 300
 #define MAX_CONTINUE_RETRY_COUNT   5
+#define MAX_DISPATCH_BATCH_BLOCKS  500
+#define MAX_DISPATCH_BATCH_SIZE    (4 * 1024 * 1024)
 
 #define META_HB_CHECK_INTERVAL    200
 #define META_HB_SEND_IDLE_COUNTER 25  // send hb every 5 sec
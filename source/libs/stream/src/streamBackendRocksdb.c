@@ -395,8 +395,14 @@ int32_t copyFiles_create(char* src, char* dst, int8_t type) {
   return 0;
 }
 int32_t copyFiles_hardlink(char* src, char* dst, int8_t type) {
-  // same fs and hard link
-  return taosLinkFile(src, dst);
+  // same fs and hard link, copied instead if the file cannot be linked, e.g. across fs or on windows
+  if (taosLinkFile(src, dst) == 0) {
+    return 0;
+  }
+  if (taosCopyFile(src, dst) < 0) {
+    return errno != 0 ? errno : -1;
+  }
+  return 0;
 }
 
 int32_t backendFileCopyFilesImpl(char* src, char* dst) {
@@ -436,7 +442,7 @@ int32_t backendFileCopyFilesImpl(char* src, char* dst) {
     } else {
       code = copyFiles_hardlink(srcName, dstName, 0);
       if (code != 0) {
-        stError("failed to hard line file, detail: %s to %s, reason: %s", srcName, dstName,
+        stError("failed to link or copy file, detail: %s to %s, reason: %s", srcName, dstName,
                 tstrerror(TAOS_SYSTEM_ERROR(code)));
         goto _ERROR;
       }
@@ -2059,6 +2065,11 @@ int32_t taskDbGenChkpUploadData(void* arg, void* mgt, int64_t chkpId, int8_t typ
   return -1;
 }
 
+void taskDbResetChkpUploadData(void* arg, void* mgt) {
+  STaskDbWrapper* pDb = arg;
+  bkdMgtResetDelta(mgt, pDb->idstr);
+}
+
 int32_t taskDbOpenCfByKey(STaskDbWrapper* pDb, const char* key) {
   int32_t code = 0;
   char*   err = NULL;
@@ -3998,7 +4009,8 @@ int32_t dbChkpDumpTo(SDbChkp* p, char* dname, SArray* list) {
     sprintf(srcBuf, "%s%s%s", srcDir, TD_DIRSEP, filename);
     sprintf(dstBuf, "%s%s%s", dstDir, TD_DIRSEP, filename);
 
-    if (taosCopyFile(srcBuf, dstBuf) < 0) {
+    // sst files are never modified once written, so they are linked rather than copied if the fs allows
+    if (copyFiles_hardlink(srcBuf, dstBuf, 0) != 0) {
       stError("failed to copy file from %s to %s", srcBuf, dstBuf);
       goto _ERROR;
     }
@@ -4114,6 +4126,21 @@ int32_t bkdMgtGetDelta(SBkdMgt* bm, char* taskId, int64_t chkpId, SArray* list,
   return code;
 }
 
+// the delta of the next checkpoint is against nothing, so all of its sst files are uploaded again, used when the
+// delta dumped last time fails to be uploaded
+void bkdMgtResetDelta(SBkdMgt* bm, char* taskId) {
+  taosThreadRwlockWrlock(&bm->rwLock);
+  SDbChkp** ppChkp = taosHashGet(bm->pDbChkpTbl, taskId, strlen(taskId));
+  if (ppChkp != NULL) {
+    SDbChkp* pChkp = *ppChkp;
+    taosThreadRwlockWrlock(&pChkp->rwLock);
+    pChkp->init = 0;
+    taosHashClear(pChkp->pSstTbl[pChkp->idx]);
+    taosThreadRwlockUnlock(&pChkp->rwLock);
+  }
+  taosThreadRwlockUnlock(&bm->rwLock);
+}
+
 #ifdef BUILD_NO_CALL
 int32_t bkdMgtAddChkp(SBkdMgt* bm, char* task, char* path) {
   int32_t code = -1;
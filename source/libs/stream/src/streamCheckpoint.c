@@ -411,6 +411,12 @@ int32_t doUploadChkp(void* param) {
     stError("s-task:%s failed to upload checkpoint:%" PRId64, arg->pTask->id.idStr, arg->chkpId);
   }
 
+  // the files of this delta may be missing in the remote, let the next checkpoint upload all of its files. A failure
+  // to delete the removed files leaves only stale files in the remote, the delta is kept then
+  if (code != 0 && arg->type == UPLOAD_S3) {
+    taskDbResetChkpUploadData(arg->pTask->pBackend, arg->pTask->pMeta->bkdChkptMgt);
+  }
+
   if (code == 0) {
     for (int i = 0; i < taosArrayGetSize(toDelFiles); i++) {
       char* p = taosArrayGetP(toDelFiles, i);
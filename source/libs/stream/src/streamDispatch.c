@@ -617,6 +617,43 @@ int32_t streamSearchAndAddBlock(SStreamTask* pTask, SStreamDispatchReq* pReqs, S
   return 0;
 }
 
+// the data blocks waiting in the outputQ are dispatched along with the first one, so the msgs sent to the downstream
+// tasks are fewer and larger when the results are generated faster than they are dispatched
+static void streamMergeOutputBlocks(SStreamTask* pTask, SStreamDataBlock* pBlock) {
+  SStreamQueue* pQueue = pTask->outputq.queue;
+  int64_t       size = streamQueueItemGetSize((SStreamQueueItem*)pBlock);
+  int32_t       numOfItems = 1;
+
+  if (pBlock->type != STREAM_INPUT__DATA_BLOCK) {
+    return;
+  }
+
+  while (taosArrayGetSize(pBlock->blocks) < MAX_DISPATCH_BATCH_BLOCKS && size < MAX_DISPATCH_BATCH_SIZE) {
+    SStreamDataBlock* pNext = streamQueueNextItem(pQueue);
+    if (pNext == NULL) {
+      break;
+    }
+
+    // the checkpoint and trans-state msgs are dispatched in the next round, after the blocks before them
+    if (pNext->type != STREAM_INPUT__DATA_BLOCK || taosArrayAddAll(pBlock->blocks, pNext->blocks) == NULL) {
+      streamQueueProcessFail(pQueue);
+      break;
+    }
+
+    size += streamQueueItemGetSize((SStreamQueueItem*)pNext);
+    numOfItems += 1;
+
+    taosArrayDestroy(pNext->blocks);
+    taosFreeQitem(pNext);
+    streamQueueProcessSuccess(pQueue);
+  }
+
+  if (numOfItems > 1) {
+    stDebug("s-task:%s %d items in outputQ merged into one dispatch msg, blocks:%d, size:%" PRId64, pTask->id.idStr,
+            numOfItems, (int32_t)taosArrayGetSize(pBlock->blocks), size);
+  }
+}
+
 int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
   ASSERT((pTask->outputInfo.type == TASK_OUTPUT__FIXED_DISPATCH ||
           pTask->outputInfo.type == TASK_OUTPUT__SHUFFLE_DISPATCH));
@@ -656,6 +693,8 @@ int32_t streamDispatchStreamBlock(SStreamTask* pTask) {
   ASSERT(pBlock->type == STREAM_INPUT__DATA_BLOCK || pBlock->type == STREAM_INPUT__CHECKPOINT_TRIGGER ||
          pBlock->type == STREAM_INPUT__TRANS_STATE);
 
+  streamMergeOutputBlocks(pTask, pBlock);
+
   pTask->execInfo.dispatch += 1;
   pTask->msgInfo.startTs = taosGetTimestampMs();
 
@@ -739,14 +778,20 @@ int32_t streamTaskSendCheckpointSourceRsp(SStreamTask* pTask) {
 }
 
 int32_t streamAddBlockIntoDispatchMsg(const SSDataBlock* pBlock, SStreamDispatchReq* pReq) {
-  int32_t dataStrLen = sizeof(SRetrieveTableRsp) + blockGetEncodeSize(pBlock);
+  int32_t encodeSize = blockGetEncodeSize(pBlock);
+  int8_t  compressed = tsCompressColData >= 0 && encodeSize > tsCompressColData;
+  if (compressed) {
+    encodeSize = blockGetCompressEncodeSize(pBlock);
+  }
+
+  int32_t dataStrLen = sizeof(SRetrieveTableRsp) + encodeSize;
   void*   buf = taosMemoryCalloc(1, dataStrLen);
   if (buf == NULL) return -1;
 
   SRetrieveTableRsp* pRetrieve = (SRetrieveTableRsp*)buf;
   pRetrieve->useconds = 0;
   pRetrieve->precision = TSDB_DEFAULT_PRECISION;
-  pRetrieve->compressed = 0;
+  pRetrieve->compressed = compressed;
   pRetrieve->completed = 1;
   pRetrieve->streamBlockType = pBlock->info.type;
   pRetrieve->numOfRows = htobe64((int64_t)pBlock->info.rows);
@@ -759,7 +804,9 @@ int32_t streamAddBlockIntoDispatchMsg(const SSDataBlock* pBlock, SStreamDispatch
   int32_t numOfCols = (int32_t)taosArrayGetSize(pBlock->pDataBlock);
   pRetrieve->numOfCols = htonl(numOfCols);
 
-  int32_t actualLen = blockEncode(pBlock, pRetrieve->data, numOfCols);
+  // the downstream tasks decode the compressed columns by blockDecode as well
+  int32_t actualLen = compressed ? blockCompressEncode(pBlock, pRetrieve->data, numOfCols)
+                                 : blockEncode(pBlock, pRetrieve->data, numOfCols);
   actualLen += sizeof(SRetrieveTableRsp);
   ASSERT(actualLen <= dataStrLen);
   taosArrayPush(pReq->dataLen, &actualLen);
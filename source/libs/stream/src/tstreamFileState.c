@@ -27,13 +27,18 @@
 #define DEFAULT_MAX_STREAM_BUFFER_SIZE (128 * 1024 * 1024)
 #define MIN_NUM_OF_ROW_BUFF            10240
 #define MIN_NUM_OF_RECOVER_ROW_BUFF    128
+#define ROW_BUFF_SLAB_SIZE             (1024 * 1024)
 
 #define TASK_KEY                       "streamFileState"
 #define STREAM_STATE_INFO_NAME         "StreamStateCheckPoint"
 
 struct SStreamFileState {
   SList*   usedBuffs;
-  SList*   freeBuffs;
+  SArray*  freeBuffs;
+  SArray*  pRowBuffSlabs;  // row buffers are carved from these, and are never freed one by one
+  char*    pSlabCur;
+  int64_t  slabRowsLeft;
+  int32_t  rowSlotSize;
   void*    rowStateBuff;
   void*    pFileStore;
   int32_t  rowSize;
@@ -54,6 +59,7 @@ struct SStreamFileState {
   _state_buff_remove_fn          stateBuffRemoveFn;
   _state_buff_remove_by_pos_fn   stateBuffRemoveByPosFn;
   _state_buff_create_statekey_fn stateBuffCreateStateKeyFn;
+  __compar_fn_t                  stateBuffCmprPosFn;
 
   _state_file_remove_fn stateFileRemoveFn;
   _state_file_get_fn    stateFileGetFn;
@@ -93,6 +99,12 @@ int32_t intervalFileGetFn(SStreamFileState* pFileState, void* pKey, void* data,
   return streamStateGet_rocksdb(pFileState->pFileStore, pKey, data, pDataLen);
 }
 
+static int32_t intervalCmprPos(const void* p1, const void* p2) {
+  SRowBuffPos* pPos1 = *(SRowBuffPos**)p1;
+  SRowBuffPos* pPos2 = *(SRowBuffPos**)p2;
+  return winKeyCmprImpl(pPos1->pKey, pPos2->pKey);
+}
+
 void* intervalCreateStateKey(SRowBuffPos* pPos, int64_t num) {
   SStateKey* pStateKey = taosMemoryCalloc(1, sizeof(SStateKey));
   SWinKey*   pWinKey = pPos->pKey;
@@ -109,6 +121,12 @@ int32_t sessionFileGetFn(SStreamFileState* pFileState, void* pKey, void* data, i
   return streamStateSessionGet_rocksdb(pFileState->pFileStore, pKey, data, pDataLen);
 }
 
+static int32_t sessionCmprPos(const void* p1, const void* p2) {
+  SRowBuffPos* pPos1 = *(SRowBuffPos**)p1;
+  SRowBuffPos* pPos2 = *(SRowBuffPos**)p2;
+  return sessionWinKeyCmpr(pPos1->pKey, pPos2->pKey);
+}
+
 void* sessionCreateStateKey(SRowBuffPos* pPos, int64_t num) {
   SStateSessionKey* pStateKey = taosMemoryCalloc(1, sizeof(SStateSessionKey));
   SSessionKey*      pWinKey = pPos->pKey;
@@ -141,9 +159,13 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     goto _error;
   }
   rowSize += selectRowSize;
-  pFileState->maxRowCount = TMAX((uint64_t)memSize / rowSize, FLUSH_NUM * 2);
+  pFileState->rowSlotSize = ALIGN8(rowSize);
+  // the key and the position of a row are counted too
+  pFileState->maxRowCount = TMAX((uint64_t)memSize / (pFileState->rowSlotSize + keySize + sizeof(SRowBuffPos)),
+                                 FLUSH_NUM * 2);
   pFileState->usedBuffs = tdListNew(POINTER_BYTES);
-  pFileState->freeBuffs = tdListNew(POINTER_BYTES);
+  pFileState->freeBuffs = taosArrayInit(1024, POINTER_BYTES);
+  pFileState->pRowBuffSlabs = taosArrayInit(16, POINTER_BYTES);
   _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
   int32_t    cap = TMIN(MIN_NUM_OF_ROW_BUFF, pFileState->maxRowCount);
   if (type == STREAM_STATE_BUFF_HASH) {
@@ -152,6 +174,7 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     pFileState->stateBuffRemoveFn = stateHashBuffRemoveFn;
     pFileState->stateBuffRemoveByPosFn = stateHashBuffRemoveByPosFn;
     pFileState->stateBuffCreateStateKeyFn = intervalCreateStateKey;
+    pFileState->stateBuffCmprPosFn = intervalCmprPos;
 
     pFileState->stateFileRemoveFn = intervalFileRemoveFn;
     pFileState->stateFileGetFn = intervalFileGetFn;
@@ -163,6 +186,7 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     pFileState->stateBuffRemoveFn = deleteSessionWinStateBuffFn;
     pFileState->stateBuffRemoveByPosFn = deleteSessionWinStateBuffByPosFn;
     pFileState->stateBuffCreateStateKeyFn = sessionCreateStateKey;
+    pFileState->stateBuffCmprPosFn = sessionCmprPos;
 
     pFileState->stateFileRemoveFn = sessionFileRemoveFn;
     pFileState->stateFileGetFn = sessionFileGetFn;
@@ -170,7 +194,7 @@ SStreamFileState* streamFileStateInit(int64_t memSize, uint32_t keySize, uint32_
     pFileState->cfName = taosStrdup("sess");
   }
 
-  if (!pFileState->usedBuffs || !pFileState->freeBuffs || !pFileState->rowStateBuff) {
+  if (!pFileState->usedBuffs || !pFileState->freeBuffs || !pFileState->pRowBuffSlabs || !pFileState->rowStateBuff) {
     goto _error;
   }
 
@@ -212,7 +236,6 @@ _error:
 
 void destroyRowBuffPos(SRowBuffPos* pPos) {
   taosMemoryFreeClear(pPos->pKey);
-  taosMemoryFreeClear(pPos->pRowBuff);
   taosMemoryFree(pPos);
 }
 
@@ -234,13 +257,6 @@ void destroyRowBuffAllPosPtr(void* ptr) {
   destroyRowBuffPos(pPos);
 }
 
-void destroyRowBuff(void* ptr) {
-  if (!ptr) {
-    return;
-  }
-  taosMemoryFree(*(void**)ptr);
-}
-
 void streamFileStateDestroy(SStreamFileState* pFileState) {
   if (!pFileState) {
     return;
@@ -249,14 +265,17 @@ void streamFileStateDestroy(SStreamFileState* pFileState) {
   taosMemoryFree(pFileState->id);
   taosMemoryFree(pFileState->cfName);
   tdListFreeP(pFileState->usedBuffs, destroyRowBuffAllPosPtr);
-  tdListFreeP(pFileState->freeBuffs, destroyRowBuff);
-  pFileState->stateBuffCleanupFn(pFileState->rowStateBuff);
+  taosArrayDestroy(pFileState->freeBuffs);
+  taosArrayDestroyP(pFileState->pRowBuffSlabs, taosMemoryFree);
+  if (pFileState->stateBuffCleanupFn) {
+    pFileState->stateBuffCleanupFn(pFileState->rowStateBuff);
+  }
   taosMemoryFree(pFileState);
 }
 
 void putFreeBuff(SStreamFileState* pFileState, SRowBuffPos* pPos) {
   if (pPos->pRowBuff) {
-    tdListAppend(pFileState->freeBuffs, &(pPos->pRowBuff));
+    taosArrayPush(pFileState->freeBuffs, &(pPos->pRowBuff));
     pPos->pRowBuff = NULL;
   }
 }
@@ -373,25 +392,46 @@ int32_t flushRowBuff(SStreamFileState* pFileState) {
 
 int32_t clearRowBuff(SStreamFileState* pFileState) {
   clearExpiredRowBuff(pFileState, pFileState->maxTs - pFileState->deleteMark, false);
-  if (isListEmpty(pFileState->freeBuffs)) {
+  if (taosArrayGetSize(pFileState->freeBuffs) == 0) {
     return flushRowBuff(pFileState);
   }
   return TSDB_CODE_SUCCESS;
 }
 
 void* getFreeBuff(SStreamFileState* pFileState) {
-  SList*     lists = pFileState->freeBuffs;
-  int32_t    buffSize = pFileState->rowSize;
-  SListNode* pNode = tdListPopHead(lists);
-  if (!pNode) {
+  void** ppBuff = taosArrayPop(pFileState->freeBuffs);
+  if (!ppBuff) {
     return NULL;
   }
-  void* ptr = *(void**)pNode->data;
-  memset(ptr, 0, buffSize);
-  taosMemoryFree(pNode);
+  void* ptr = *ppBuff;
+  memset(ptr, 0, pFileState->rowSize);
   return ptr;
 }
 
+// a new row buffer, which is zeroed, while there are less than maxRowCount ones
+static void* allocRowBuff(SStreamFileState* pFileState) {
+  if (pFileState->slabRowsLeft == 0) {
+    int64_t rows = TMAX(ROW_BUFF_SLAB_SIZE / pFileState->rowSlotSize, 1);
+    rows = TMIN(rows, pFileState->maxRowCount - pFileState->curRowCount);
+    char* pSlab = taosMemoryCalloc(rows, pFileState->rowSlotSize);
+    if (!pSlab) {
+      return NULL;
+    }
+    if (!taosArrayPush(pFileState->pRowBuffSlabs, &pSlab)) {
+      taosMemoryFree(pSlab);
+      return NULL;
+    }
+    pFileState->pSlabCur = pSlab;
+    pFileState->slabRowsLeft = rows;
+  }
+
+  void* pBuff = pFileState->pSlabCur;
+  pFileState->pSlabCur += pFileState->rowSlotSize;
+  pFileState->slabRowsLeft--;
+  pFileState->curRowCount++;
+  return pBuff;
+}
+
 int32_t streamFileStateClearBuff(SStreamFileState* pFileState, SRowBuffPos* pPos) {
   if (pPos->pRowBuff) {
     memset(pPos->pRowBuff, 0, pFileState->rowSize);
@@ -410,10 +450,9 @@ SRowBuffPos* getNewRowPos(SStreamFileState* pFileState) {
   }
 
   if (pFileState->curRowCount < pFileState->maxRowCount) {
-    pBuff = taosMemoryCalloc(1, pFileState->rowSize);
+    pBuff = allocRowBuff(pFileState);
     if (pBuff) {
       pPos->pRowBuff = pBuff;
-      pFileState->curRowCount++;
       goto _end;
     }
   }
@@ -509,9 +548,9 @@ int32_t getRowBuffByPos(SStreamFileState* pFileState, SRowBuffPos* pPos, void**
   pPos->pRowBuff = getFreeBuff(pFileState);
   if (!pPos->pRowBuff) {
     if (pFileState->curRowCount < pFileState->maxRowCount) {
-      pPos->pRowBuff = taosMemoryCalloc(1, pFileState->rowSize);
-      pFileState->curRowCount++;
-    } else {
+      pPos->pRowBuff = allocRowBuff(pFileState);
+    }
+    if (!pPos->pRowBuff) {
       int32_t code = clearRowBuff(pFileState);
       ASSERT(code == 0);
       pPos->pRowBuff = getFreeBuff(pFileState);
@@ -541,16 +580,39 @@ SStreamSnapshot* getSnapshot(SStreamFileState* pFileState) {
   return pFileState->usedBuffs;
 }
 
-int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
-  int32_t   code = TSDB_CODE_SUCCESS;
+// the rows of the snapshot to be flushed, in the key order, which rocksdb inserts into the memtable at lower cost
+SArray* getFlushRowPos(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot) {
+  SArray* pFlushPos = taosArrayInit(listNEles(pSnapshot), POINTER_BYTES);
+  if (!pFlushPos) {
+    return NULL;
+  }
+
   SListIter iter = {0};
   tdListInitIter(pSnapshot, &iter, TD_LIST_FORWARD);
+  SListNode* pNode = NULL;
+  while ((pNode = tdListNext(&iter)) != NULL) {
+    SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
+    if (pPos->beFlushed || !pPos->pRowBuff) {
+      continue;
+    }
+    taosArrayPush(pFlushPos, &pPos);
+  }
+  taosArrayMSort(pFlushPos, pFileState->stateBuffCmprPosFn);
+  return pFlushPos;
+}
+
+int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot, bool flushState) {
+  int32_t code = TSDB_CODE_SUCCESS;
 
   const int32_t BATCH_LIMIT = 256;
 
-  int64_t    st = taosGetTimestampMs();
-  int32_t    numOfElems = listNEles(pSnapshot);
-  SListNode* pNode = NULL;
+  int64_t st = taosGetTimestampMs();
+  int32_t numOfElems = listNEles(pSnapshot);
+
+  SArray* pFlushPos = getFlushRowPos(pFileState, pSnapshot);
+  if (!pFlushPos) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
 
   int idx = streamStateGetCfIdx(pFileState->pFileStore, pFileState->cfName);
 
@@ -558,11 +620,8 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
   char*   buf = taosMemoryCalloc(1, len);
 
   void* batch = streamStateCreateBatch();
-  while ((pNode = tdListNext(&iter)) != NULL && code == TSDB_CODE_SUCCESS) {
-    SRowBuffPos* pPos = *(SRowBuffPos**)pNode->data;
-    if (pPos->beFlushed || !pPos->pRowBuff) {
-      continue;
-    }
+  for (int32_t i = 0; i < taosArrayGetSize(pFlushPos) && code == TSDB_CODE_SUCCESS; ++i) {
+    SRowBuffPos* pPos = taosArrayGetP(pFlushPos, i);
     pPos->beFlushed = true;
     pFileState->flushMark = TMAX(pFileState->flushMark, pFileState->getTs(pPos->pKey));
 
@@ -580,6 +639,7 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
     memset(buf, 0, len);
   }
   taosMemoryFree(buf);
+  taosArrayDestroy(pFlushPos);
 
   if (streamStateGetBatchSize(batch) > 0) {
     streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
@@ -714,6 +774,8 @@ int32_t recoverSnapshot(SStreamFileState* pFileState, int64_t ckId) {
     SRowBuffPos* pNewPos = getNewRowPosForWrite(pFileState);
     code = streamStateGetKVByCur_rocksdb(pCur, pNewPos->pKey, (const void**)&pVal, &vlen);
     if (code != TSDB_CODE_SUCCESS || pFileState->getTs(pNewPos->pKey) < pFileState->flushMark) {
+      // the row buffer lives in a slab, it goes back to the free buffs before its position is destroyed
+      putFreeBuff(pFileState, pNewPos);
       destroyRowBuffPos(pNewPos);
       SListNode* pNode = tdListPopTail(pFileState->usedBuffs);
       taosMemoryFreeClear(pNode);
@@ -726,7 +788,10 @@ int32_t recoverSnapshot(SStreamFileState* pFileState, int64_t ckId) {
     pNewPos->beFlushed = true;
     code = tSimpleHashPut(pFileState->rowStateBuff, pNewPos->pKey, pFileState->keyLen, &pNewPos, POINTER_BYTES);
     if (code != TSDB_CODE_SUCCESS) {
+      putFreeBuff(pFileState, pNewPos);
       destroyRowBuffPos(pNewPos);
+      SListNode* pNode = tdListPopTail(pFileState->usedBuffs);
+      taosMemoryFreeClear(pNode);
       break;
     }
     code = streamStateCurPrev_rocksdb(pCur);
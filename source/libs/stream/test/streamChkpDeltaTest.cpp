@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "streamBackendRocksdb.h"
+
+using namespace std;
+
+#define CHKP_TASK_ID "0x1-0x2"
+
+static string joinPath(const string &dir, const string &name) { return dir + TD_DIRSEP + name; }
+
+static void writeFile(const string &path, const string &content) {
+  TdFilePtr pFile = taosOpenFile(path.c_str(), TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  ASSERT_EQ(taosWriteFile(pFile, content.c_str(), content.size()), (int64_t)content.size());
+  taosCloseFile(&pFile);
+}
+
+// the local checkpoint dir of the task as created by rocksdb, each sst file holds its own name
+static void createLocalChkp(const string &base, int64_t chkpId, const vector<string> &ssts) {
+  char dir[PATH_MAX] = {0};
+  snprintf(dir, sizeof(dir), "%s%s%s%scheckpoints%scheckpoint%" PRId64, base.c_str(), TD_DIRSEP, CHKP_TASK_ID,
+           TD_DIRSEP, TD_DIRSEP, chkpId);
+  ASSERT_EQ(taosMulMkDir(dir), 0);
+
+  writeFile(joinPath(dir, "CURRENT"), "MANIFEST-00000" + to_string(chkpId) + "\n");
+  writeFile(joinPath(dir, "MANIFEST-00000" + to_string(chkpId)), "manifest");
+  writeFile(joinPath(dir, "OPTIONS-000007"), "options");
+  for (auto &sst : ssts) {
+    writeFile(joinPath(dir, sst), sst);
+  }
+}
+
+// the sst files dumped for the upload, each one is checked to be the file of the local checkpoint
+static vector<string> getDumpedSsts(const string &dname) {
+  vector<string> ssts;
+  TdDirPtr       pDir = taosOpenDir(dname.c_str());
+  TdDirEntryPtr  de = NULL;
+  while ((de = taosReadDir(pDir)) != NULL) {
+    string name = taosGetDirEntryName(de);
+    if (name.size() <= 4 || name.compare(name.size() - 4, 4, ".sst") != 0) {
+      continue;
+    }
+
+    char      buf[64] = {0};
+    TdFilePtr pFile = taosOpenFile(joinPath(dname, name).c_str(), TD_FILE_READ);
+    EXPECT_NE(pFile, nullptr);
+    EXPECT_EQ(taosReadFile(pFile, buf, sizeof(buf)), (int64_t)name.size());
+    EXPECT_EQ(name, string(buf));
+    taosCloseFile(&pFile);
+    ssts.push_back(name);
+  }
+  taosCloseDir(&pDir);
+
+  sort(ssts.begin(), ssts.end());
+  return ssts;
+}
+
+// the delta of a checkpoint dumped into an empty dir, returns the sst files dumped and the files to delete
+static vector<string> getDelta(SBkdMgt *pMgt, const string &base, int64_t chkpId, vector<string> *pDel) {
+  string dname = joinPath(base, "upload" + to_string(chkpId));
+  taosRemoveDir(dname.c_str());
+  EXPECT_EQ(taosMulMkDir(dname.c_str()), 0);
+
+  SArray *pList = taosArrayInit(4, sizeof(void *));
+  EXPECT_EQ(bkdMgtGetDelta(pMgt, CHKP_TASK_ID, chkpId, pList, (char *)dname.c_str()), 0);
+
+  pDel->clear();
+  for (int32_t i = 0; i < taosArrayGetSize(pList); ++i) {
+    pDel->push_back((char *)taosArrayGetP(pList, i));
+  }
+  sort(pDel->begin(), pDel->end());
+  taosArrayDestroyP(pList, taosMemoryFree);
+
+  EXPECT_TRUE(taosCheckExistFile(joinPath(dname, "CURRENT_" + to_string(chkpId)).c_str()));
+  EXPECT_TRUE(
+      taosCheckExistFile(joinPath(dname, "MANIFEST-00000" + to_string(chkpId) + "_" + to_string(chkpId)).c_str()));
+  EXPECT_TRUE(taosCheckExistFile(joinPath(dname, "META").c_str()));
+  return getDumpedSsts(dname);
+}
+
+// only the sst files added since the last dump are uploaded, all of them after the delta is reset by a failed upload
+TEST(testCase, chkpDumpDeltaTest) {
+  string base = string(TD_TMP_DIR_PATH) + "streamChkpDeltaTest";
+  taosRemoveDir(base.c_str());
+
+  createLocalChkp(base, 1, {"000001.sst", "000002.sst"});
+  createLocalChkp(base, 2, {"000002.sst", "000003.sst"});
+  createLocalChkp(base, 3, {"000002.sst", "000003.sst", "000004.sst"});
+  createLocalChkp(base, 4, {"000003.sst", "000004.sst", "000005.sst"});
+
+  SBkdMgt       *pMgt = bkdMgtCreate((char *)base.c_str());
+  vector<string> del;
+
+  ASSERT_EQ(getDelta(pMgt, base, 1, &del), vector<string>({"000001.sst", "000002.sst"}));
+  ASSERT_TRUE(del.empty());
+
+  ASSERT_EQ(getDelta(pMgt, base, 2, &del), vector<string>({"000003.sst"}));
+  ASSERT_EQ(del, vector<string>({"000001.sst"}));
+
+  // the upload of checkpoint 2 fails, checkpoint 3 is uploaded as a whole
+  bkdMgtResetDelta(pMgt, CHKP_TASK_ID);
+  ASSERT_EQ(getDelta(pMgt, base, 3, &del), vector<string>({"000002.sst", "000003.sst", "000004.sst"}));
+  ASSERT_TRUE(del.empty());
+
+  ASSERT_EQ(getDelta(pMgt, base, 4, &del), vector<string>({"000005.sst"}));
+  ASSERT_EQ(del, vector<string>({"000002.sst"}));
+
+  // a task without any dump yet is left as it is
+  bkdMgtResetDelta(pMgt, "0x1-0x3");
+
+  bkdMgtDestroy(pMgt);
+  taosRemoveDir(base.c_str());
+}
+
+// a file is linked where the fs allows it, the caller copies it otherwise
+TEST(testCase, chkpLinkFileTest) {
+  string base = string(TD_TMP_DIR_PATH) + "streamChkpLinkTest";
+  taosRemoveDir(base.c_str());
+  ASSERT_EQ(taosMulMkDir(base.c_str()), 0);
+
+  string src = joinPath(base, "000001.sst");
+  string dst = joinPath(base, "000001.sst.link");
+  writeFile(src, "000001.sst");
+
+  int32_t code = taosLinkFile((char *)src.c_str(), (char *)dst.c_str());
+#ifdef WINDOWS
+  ASSERT_EQ(code, -1);
+  ASSERT_FALSE(taosCheckExistFile(dst.c_str()));
+#else
+  ASSERT_EQ(code, 0);
+  ASSERT_TRUE(taosCheckExistFile(dst.c_str()));
+  ASSERT_NE(taosLinkFile((char *)src.c_str(), (char *)dst.c_str()), 0);
+#endif
+
+  taosRemoveDir(base.c_str());
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <taoserror.h>
+#include <tglobal.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "streamInt.h"
+
+using namespace std;
+
+#define DISPATCH_ROWS 1000
+
+static vector<SStreamDispatchReq> sentReqs;
+
+// the dispatch msgs are decoded as the downstream task receives them
+static int32_t sendReq(const SEpSet *pEpSet, SRpcMsg *pMsg) {
+  SStreamDispatchReq req = {0};
+  SDecoder           decoder;
+
+  tDecoderInit(&decoder, (uint8_t *)POINTER_SHIFT(pMsg->pCont, sizeof(SMsgHead)), pMsg->contLen - sizeof(SMsgHead));
+  int32_t code = tDecodeStreamDispatchReq(&decoder, &req);
+  tDecoderClear(&decoder);
+  rpcFreeCont(pMsg->pCont);
+
+  if (code == 0) {
+    sentReqs.push_back(req);
+  }
+  return code;
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+
+  SMsgCb msgCb = {0};
+  msgCb.sendReqFp = sendReq;
+  tmsgSetDefault(&msgCb);
+  return RUN_ALL_TESTS();
+}
+
+// a block of one int column and one varchar column, the int column holds the id of the block in its first row
+static SSDataBlock *createBlock(int32_t id, int32_t rows) {
+  SSDataBlock    *pBlock = createDataBlock();
+  SColumnInfoData col1 = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 1);
+  SColumnInfoData col2 = createColumnInfoData(TSDB_DATA_TYPE_VARCHAR, 32 + VARSTR_HEADER_SIZE, 2);
+  blockDataAppendColInfo(pBlock, &col1);
+  blockDataAppendColInfo(pBlock, &col2);
+  blockDataEnsureCapacity(pBlock, rows);
+
+  SColumnInfoData *pCol1 = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData *pCol2 = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 1);
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t v = (i == 0) ? id : i % 10;
+    colDataSetVal(pCol1, i, (const char *)&v, false);
+
+    char    str[32 + VARSTR_HEADER_SIZE];
+    int32_t len = snprintf(varDataVal(str), 32, "r%d", i % 50);
+    varDataSetLen(str, len);
+    colDataSetVal(pCol2, i, str, i % 7 == 3);
+  }
+
+  pBlock->info.rows = rows;
+  pBlock->info.type = STREAM_NORMAL;
+  pBlock->info.window.skey = id;
+  pBlock->info.window.ekey = id + rows;
+  pBlock->info.version = id * 10;
+  return pBlock;
+}
+
+// an item of the outputQ holding copies of the blocks
+static void putBlocks(SStreamTask *pTask, int32_t type, const vector<SSDataBlock *> &blocks) {
+  SStreamDataBlock *pItem = (SStreamDataBlock *)taosAllocateQitem(sizeof(SStreamDataBlock), DEF_QITEM, 100);
+  pItem->type = type;
+  pItem->blocks = taosArrayInit(blocks.size(), sizeof(SSDataBlock));
+  for (SSDataBlock *pBlock : blocks) {
+    SSDataBlock *pCopy = createOneDataBlock(pBlock, true);
+    taosArrayPush(pItem->blocks, pCopy);
+    taosMemoryFree(pCopy);
+  }
+  taosWriteQitem(pTask->outputq.queue->pQueue, pItem);
+}
+
+static void putIds(SStreamTask *pTask, int32_t type, const vector<int32_t> &ids) {
+  vector<SSDataBlock *> blocks;
+  for (int32_t id : ids) {
+    blocks.push_back(createBlock(id, 2));
+  }
+  putBlocks(pTask, type, blocks);
+  for (SSDataBlock *pBlock : blocks) {
+    blockDataDestroy(pBlock);
+  }
+}
+
+static void initTask(SStreamTask *pTask, SStreamMeta *pMeta) {
+  memset(pTask, 0, sizeof(SStreamTask));
+  memset(pMeta, 0, sizeof(SStreamMeta));
+  pTask->id.idStr = "dispatchTest";
+  pTask->pMeta = pMeta;
+  pTask->outputInfo.type = TASK_OUTPUT__FIXED_DISPATCH;
+  pTask->outputq.queue = streamQueueOpen(512 << 10);
+  pTask->outputq.status = TASK_OUTPUT_STATUS__NORMAL;
+}
+
+// dispatch the head of the outputQ, along with the items merged into it, and take the rsp of the downstream task
+static bool dispatchOnce(SStreamTask *pTask, SStreamDispatchReq *pReq) {
+  sentReqs.clear();
+  if (streamDispatchStreamBlock(pTask) != 0 || sentReqs.size() != 1) {
+    return false;
+  }
+
+  *pReq = sentReqs[0];
+  destroyDispatchMsg(pTask->msgInfo.pData, 1);
+  pTask->msgInfo.pData = NULL;
+  pTask->outputq.status = TASK_OUTPUT_STATUS__NORMAL;
+  return true;
+}
+
+static vector<int32_t> getIds(SStreamDispatchReq *pReq) {
+  vector<int32_t>   ids;
+  SStreamDataBlock *pData = createStreamBlockFromDispatchMsg(pReq, pReq->type, 1);
+  for (int32_t i = 0; i < taosArrayGetSize(pData->blocks); ++i) {
+    SSDataBlock     *pBlock = (SSDataBlock *)taosArrayGet(pData->blocks, i);
+    SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+    ids.push_back(*(int32_t *)colDataGetData(pCol, 0));
+  }
+  destroyStreamDataBlock(pData);
+  return ids;
+}
+
+static void checkBlock(const SSDataBlock *pExpect, const SSDataBlock *pBlock) {
+  ASSERT_EQ(pBlock->info.rows, pExpect->info.rows);
+  ASSERT_EQ(pBlock->info.window.skey, pExpect->info.window.skey);
+  ASSERT_EQ(pBlock->info.window.ekey, pExpect->info.window.ekey);
+  ASSERT_EQ(pBlock->info.version, pExpect->info.version);
+  ASSERT_EQ(taosArrayGetSize(pBlock->pDataBlock), taosArrayGetSize(pExpect->pDataBlock));
+
+  for (int32_t c = 0; c < taosArrayGetSize(pExpect->pDataBlock); ++c) {
+    SColumnInfoData *pExpectCol = (SColumnInfoData *)taosArrayGet(pExpect->pDataBlock, c);
+    SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, c);
+    for (int32_t i = 0; i < pExpect->info.rows; ++i) {
+      bool isNull = colDataIsNull(pExpectCol, pExpect->info.rows, i, NULL);
+      ASSERT_EQ(colDataIsNull(pCol, pBlock->info.rows, i, NULL), isNull) << "col:" << c << " row:" << i;
+      if (isNull) {
+        continue;
+      }
+
+      const char *pExpectVal = colDataGetData(pExpectCol, i);
+      const char *pVal = colDataGetData(pCol, i);
+      if (IS_VAR_DATA_TYPE(pExpectCol->info.type)) {
+        ASSERT_EQ(varDataLen(pVal), varDataLen(pExpectVal)) << "col:" << c << " row:" << i;
+        ASSERT_EQ(memcmp(varDataVal(pVal), varDataVal(pExpectVal), varDataLen(pVal)), 0) << "col:" << c << " row:" << i;
+      } else {
+        ASSERT_EQ(memcmp(pVal, pExpectVal, pExpectCol->info.bytes), 0) << "col:" << c << " row:" << i;
+      }
+    }
+  }
+}
+
+// the blocks of one item are dispatched, and decoded as the downstream task does
+static void checkCompress(int32_t compressColData, const vector<int8_t> &expectCompressed) {
+  SStreamTask        task;
+  SStreamMeta        meta;
+  SStreamDispatchReq req;
+  int32_t            old = tsCompressColData;
+
+  tsCompressColData = compressColData;
+  initTask(&task, &meta);
+
+  vector<SSDataBlock *> blocks = {createBlock(1, DISPATCH_ROWS), createBlock(2, 1), createBlock(3, DISPATCH_ROWS / 3)};
+  putBlocks(&task, STREAM_INPUT__DATA_BLOCK, blocks);
+  ASSERT_TRUE(dispatchOnce(&task, &req));
+
+  for (int32_t i = 0; i < blocks.size(); ++i) {
+    SRetrieveTableRsp *pRetrieve = (SRetrieveTableRsp *)taosArrayGetP(req.data, i);
+    ASSERT_EQ(pRetrieve->compressed, expectCompressed[i]) << "block:" << i;
+  }
+
+  SStreamDataBlock *pData = createStreamBlockFromDispatchMsg(&req, STREAM_INPUT__DATA_BLOCK, 1);
+  ASSERT_NE(pData, nullptr);
+  ASSERT_EQ(taosArrayGetSize(pData->blocks), blocks.size());
+  for (int32_t i = 0; i < blocks.size(); ++i) {
+    SCOPED_TRACE(testing::Message() << "block:" << i);
+    checkBlock(blocks[i], (SSDataBlock *)taosArrayGet(pData->blocks, i));
+  }
+
+  destroyStreamDataBlock(pData);
+  tDeleteStreamDispatchReq(&req);
+  for (SSDataBlock *pBlock : blocks) {
+    blockDataDestroy(pBlock);
+  }
+  streamQueueClose(task.outputq.queue, 0);
+  tsCompressColData = old;
+}
+
+// the blocks of the merged items keep the order they are put into the outputQ
+TEST(testCase, dispatchMergeInOrderTest) {
+  SStreamTask        task;
+  SStreamMeta        meta;
+  SStreamDispatchReq req;
+  initTask(&task, &meta);
+
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {1, 2});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {3});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {4, 5, 6});
+
+  ASSERT_TRUE(dispatchOnce(&task, &req));
+  ASSERT_EQ(req.blockNum, 6);
+  ASSERT_EQ(getIds(&req), vector<int32_t>({1, 2, 3, 4, 5, 6}));
+  tDeleteStreamDispatchReq(&req);
+
+  ASSERT_EQ(streamQueueGetNumOfItems(task.outputq.queue), 0);
+  ASSERT_FALSE(dispatchOnce(&task, &req));
+  streamQueueClose(task.outputq.queue, 0);
+}
+
+// a checkpoint or trans-state item ends the batch, it is dispatched alone after the blocks before it
+TEST(testCase, dispatchStopAtCheckpointTest) {
+  SStreamTask        task;
+  SStreamMeta        meta;
+  SStreamDispatchReq req;
+  initTask(&task, &meta);
+
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {1});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {2});
+  putIds(&task, STREAM_INPUT__CHECKPOINT_TRIGGER, {100});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {3});
+  putIds(&task, STREAM_INPUT__TRANS_STATE, {200});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {4});
+  putIds(&task, STREAM_INPUT__DATA_BLOCK, {5});
+
+  vector<pair<int32_t, vector<int32_t>>> expect = {
+      {STREAM_INPUT__DATA_BLOCK, {1, 2}},  {STREAM_INPUT__CHECKPOINT_TRIGGER, {100}},
+      {STREAM_INPUT__DATA_BLOCK, {3}},     {STREAM_INPUT__TRANS_STATE, {200}},
+      {STREAM_INPUT__DATA_BLOCK, {4, 5}},
+  };
+  for (auto &e : expect) {
+    ASSERT_TRUE(dispatchOnce(&task, &req));
+    ASSERT_EQ(req.type, e.first);
+    ASSERT_EQ(getIds(&req), e.second);
+    tDeleteStreamDispatchReq(&req);
+  }
+  ASSERT_FALSE(dispatchOnce(&task, &req));
+  streamQueueClose(task.outputq.queue, 0);
+}
+
+// the batch is bounded by the number of blocks, the rest are dispatched in the next round
+TEST(testCase, dispatchMergeLimitTest) {
+  SStreamTask        task;
+  SStreamMeta        meta;
+  SStreamDispatchReq req;
+  vector<int32_t>    all;
+  initTask(&task, &meta);
+
+  for (int32_t i = 0; i < MAX_DISPATCH_BATCH_BLOCKS + 10; ++i) {
+    putIds(&task, STREAM_INPUT__DATA_BLOCK, {i});
+    all.push_back(i);
+  }
+
+  ASSERT_TRUE(dispatchOnce(&task, &req));
+  ASSERT_EQ(getIds(&req), vector<int32_t>(all.begin(), all.begin() + MAX_DISPATCH_BATCH_BLOCKS));
+  tDeleteStreamDispatchReq(&req);
+
+  ASSERT_TRUE(dispatchOnce(&task, &req));
+  ASSERT_EQ(getIds(&req), vector<int32_t>(all.begin() + MAX_DISPATCH_BATCH_BLOCKS, all.end()));
+  tDeleteStreamDispatchReq(&req);
+  ASSERT_FALSE(dispatchOnce(&task, &req));
+  streamQueueClose(task.outputq.queue, 0);
+}
+
+// the blocks larger than compressColData are compressed, the others are not, and all of them are decoded the same way
+TEST(testCase, dispatchCompressTest) {
+  checkCompress(0, {1, 1, 1});
+  checkCompress(1000, {1, 0, 1});
+  checkCompress(-1, {0, 0, 0});
+}
+
+#pragma GCC diagnostic pop
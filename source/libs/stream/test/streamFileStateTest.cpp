@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "streamInt.h"
+#include "tstreamFileState.h"
+
+using namespace std;
+
+#define FILE_STATE_TASK_ID  "0x1-0x1"
+#define FILE_STATE_ROW_SIZE 20  // the slot of a row is 8-byte aligned, so it takes 24 bytes
+#define FILE_STATE_ROWS     64
+
+// the rocksdb of a task in a temporary dir, kept across the file states opened on it
+typedef struct {
+  char         path[PATH_MAX];
+  SStreamTask  task;
+  STdbState    tdbState;
+  SStreamState state;
+} SFileStateDb;
+
+static TSKEY getWinTs(void *pKey) { return ((SWinKey *)pKey)->ts; }
+static TSKEY getSessionTs(void *pKey) { return ((SSessionKey *)pKey)->win.ekey; }
+
+static char getRowByte(const SWinKey &key) { return (char)(key.groupId * 31 + key.ts); }
+
+static SWinKey makeWinKey(uint64_t groupId, TSKEY ts) {
+  SWinKey key;
+  key.groupId = groupId;
+  key.ts = ts;
+  return key;
+}
+
+static void openFileStateDb(SFileStateDb *pDb) {
+  memset(pDb, 0, sizeof(SFileStateDb));
+  snprintf(pDb->path, sizeof(pDb->path), "%sstreamFileStateTest", TD_TMP_DIR_PATH);
+  taosRemoveDir(pDb->path);
+  taosMulMkDir(pDb->path);
+
+  pDb->task.pBackend = taskDbOpen(pDb->path, (char *)FILE_STATE_TASK_ID, 0);
+  pDb->tdbState.pOwner = &pDb->task;
+  pDb->state.pTdbState = &pDb->tdbState;
+}
+
+static void closeFileStateDb(SFileStateDb *pDb) {
+  taskDbDestroy(pDb->task.pBackend, false);
+  taosRemoveDir(pDb->path);
+}
+
+// a file state whose memory holds FILE_STATE_ROWS rows
+static SStreamFileState *openFileState(SFileStateDb *pDb, int8_t type) {
+  uint32_t keySize = (type == STREAM_STATE_BUFF_HASH) ? sizeof(SWinKey) : sizeof(SSessionKey);
+  int64_t  memSize = FILE_STATE_ROWS * (ALIGN8(FILE_STATE_ROW_SIZE) + keySize + sizeof(SRowBuffPos));
+  GetTsFun fp = (type == STREAM_STATE_BUFF_HASH) ? getWinTs : getSessionTs;
+  return streamFileStateInit(memSize, keySize, FILE_STATE_ROW_SIZE, 0, fp, &pDb->state, INT64_MAX, "fileStateTest", 0,
+                             type);
+}
+
+// the row of a window, filled with a byte of its key and released
+static SRowBuffPos *putRow(SStreamFileState *pFileState, SWinKey key) {
+  SRowBuffPos *pPos = NULL;
+  int32_t      len = 0;
+  EXPECT_EQ(getRowBuff(pFileState, &key, sizeof(SWinKey), (void **)&pPos, &len), 0);
+  EXPECT_EQ(len, FILE_STATE_ROW_SIZE);
+  memset(pPos->pRowBuff, getRowByte(key), FILE_STATE_ROW_SIZE);
+  streamFileStateReleaseBuff(pFileState, pPos, false);
+  return pPos;
+}
+
+static void checkFlushed(SStreamState *pState, SWinKey key) {
+  void   *pVal = NULL;
+  int32_t len = 0;
+  ASSERT_EQ(streamStateGet_rocksdb(pState, &key, &pVal, &len), 0) << "group:" << key.groupId << " ts:" << key.ts;
+  ASSERT_EQ(len, FILE_STATE_ROW_SIZE);
+  for (int32_t i = 0; i < len; ++i) {
+    ASSERT_EQ(((char *)pVal)[i], getRowByte(key));
+  }
+  taosMemoryFree(pVal);
+}
+
+static bool isZeroRow(const SRowBuffPos *pPos) {
+  for (int32_t i = 0; i < FILE_STATE_ROW_SIZE; ++i) {
+    if (((char *)pPos->pRowBuff)[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the rows are carved one after another from a slab, the buffers of the flushed rows are taken by the new ones
+TEST(testCase, fileStateSlabRowsTest) {
+  SFileStateDb db;
+  openFileStateDb(&db);
+  SStreamFileState *pFileState = openFileState(&db, STREAM_STATE_BUFF_HASH);
+  ASSERT_NE(pFileState, nullptr);
+
+  vector<char *> buffs;
+  for (int32_t i = 0; i < FILE_STATE_ROWS; ++i) {
+    SRowBuffPos *pPos = putRow(pFileState, makeWinKey(i % 4, 1000 + i));
+    buffs.push_back((char *)pPos->pRowBuff);
+    ASSERT_EQ((uintptr_t)pPos->pRowBuff % 8, 0);
+    if (i > 0) {
+      ASSERT_EQ(buffs[i] - buffs[i - 1], ALIGN8(FILE_STATE_ROW_SIZE));
+    }
+  }
+
+  // the memory is full, the released rows are flushed to make room for the new ones
+  set<char *> slab(buffs.begin(), buffs.end());
+  for (int32_t i = 0; i < FILE_STATE_ROWS; ++i) {
+    SWinKey      key = makeWinKey(i % 4, 2000 + i);
+    SRowBuffPos *pPos = NULL;
+    int32_t      len = 0;
+    ASSERT_EQ(getRowBuff(pFileState, &key, sizeof(SWinKey), (void **)&pPos, &len), 0);
+    ASSERT_EQ(slab.count((char *)pPos->pRowBuff), 1);
+    ASSERT_TRUE(isZeroRow(pPos));
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+
+  for (int32_t i = 0; i < FILE_STATE_ROWS; ++i) {
+    checkFlushed(&db.state, makeWinKey(i % 4, 1000 + i));
+  }
+  streamFileStateDestroy(pFileState);
+  closeFileStateDb(&db);
+}
+
+// the rows are flushed in the order of their keys, whatever the order they are written in
+TEST(testCase, fileStateFlushOrderTest) {
+  SFileStateDb db;
+  openFileStateDb(&db);
+  SStreamFileState *pFileState = openFileState(&db, STREAM_STATE_BUFF_HASH);
+  ASSERT_NE(pFileState, nullptr);
+
+  for (int32_t i = 0; i < 40; ++i) {
+    putRow(pFileState, makeWinKey((i * 7) % 4, 1000 + (i * 13) % 40));
+  }
+
+  SStreamSnapshot *pSnapshot = getSnapshot(pFileState);
+  SArray          *pFlushPos = getFlushRowPos(pFileState, pSnapshot);
+  ASSERT_EQ(taosArrayGetSize(pFlushPos), 40);
+  for (int32_t i = 1; i < taosArrayGetSize(pFlushPos); ++i) {
+    SRowBuffPos *pPrev = (SRowBuffPos *)taosArrayGetP(pFlushPos, i - 1);
+    SRowBuffPos *pPos = (SRowBuffPos *)taosArrayGetP(pFlushPos, i);
+    ASSERT_LT(winKeyCmprImpl(pPrev->pKey, pPos->pKey), 0);
+  }
+  taosArrayDestroy(pFlushPos);
+
+  ASSERT_EQ(flushSnapshot(pFileState, pSnapshot, true), 0);
+  pFlushPos = getFlushRowPos(pFileState, pSnapshot);
+  ASSERT_EQ(taosArrayGetSize(pFlushPos), 0);
+  taosArrayDestroy(pFlushPos);
+
+  for (int32_t i = 0; i < 40; ++i) {
+    checkFlushed(&db.state, makeWinKey((i * 7) % 4, 1000 + (i * 13) % 40));
+  }
+  streamFileStateDestroy(pFileState);
+  closeFileStateDb(&db);
+}
+
+TEST(testCase, fileStateFlushSessionOrderTest) {
+  SFileStateDb db;
+  openFileStateDb(&db);
+  SStreamFileState *pFileState = openFileState(&db, STREAM_STATE_BUFF_SORT);
+  ASSERT_NE(pFileState, nullptr);
+
+  for (int32_t i = 0; i < 40; ++i) {
+    SSessionKey key;
+    key.groupId = (i * 7) % 4;
+    key.win.skey = key.win.ekey = 1000 + (i * 13) % 40 * 10;
+    SRowBuffPos *pPos = NULL;
+    int32_t      len = 0;
+    getSessionWinResultBuff(pFileState, &key, 0, (void **)&pPos, &len);
+    ASSERT_NE(pPos, nullptr);
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+
+  SStreamSnapshot *pSnapshot = getSnapshot(pFileState);
+  SArray          *pFlushPos = getFlushRowPos(pFileState, pSnapshot);
+  ASSERT_EQ(taosArrayGetSize(pFlushPos), 40);
+  for (int32_t i = 1; i < taosArrayGetSize(pFlushPos); ++i) {
+    SRowBuffPos *pPrev = (SRowBuffPos *)taosArrayGetP(pFlushPos, i - 1);
+    SRowBuffPos *pPos = (SRowBuffPos *)taosArrayGetP(pFlushPos, i);
+    ASSERT_LT(sessionWinKeyCmpr((SSessionKey *)pPrev->pKey, (SSessionKey *)pPos->pKey), 0);
+  }
+  taosArrayDestroy(pFlushPos);
+
+  ASSERT_EQ(flushSnapshot(pFileState, pSnapshot, false), 0);
+  streamFileStateDestroy(pFileState);
+  closeFileStateDb(&db);
+}
+
+// the rows recovered from the rocksdb are followed by the buffer taken for the end of the cursor, which goes back
+// to the free buffers and is the first one taken by a new row
+TEST(testCase, fileStateRecoverRowsTest) {
+  SFileStateDb db;
+  openFileStateDb(&db);
+  SStreamFileState *pFileState = openFileState(&db, STREAM_STATE_BUFF_HASH);
+  ASSERT_NE(pFileState, nullptr);
+  for (int32_t i = 0; i < 10; ++i) {
+    putRow(pFileState, makeWinKey(0, 1000 + i));
+  }
+  SStreamSnapshot *pSnapshot = getSnapshot(pFileState);
+  ASSERT_EQ(flushSnapshot(pFileState, pSnapshot, true), 0);
+  streamFileStateDestroy(pFileState);
+
+  pFileState = openFileState(&db, STREAM_STATE_BUFF_HASH);
+  ASSERT_NE(pFileState, nullptr);
+
+  char *pFirst = NULL;
+  for (int32_t i = 0; i < 10; ++i) {
+    SWinKey      key = makeWinKey(0, 1000 + i);
+    SRowBuffPos *pPos = NULL;
+    int32_t      len = 0;
+    ASSERT_EQ(getRowBuff(pFileState, &key, sizeof(SWinKey), (void **)&pPos, &len), 0);
+    ASSERT_EQ(((char *)pPos->pRowBuff)[0], getRowByte(key));
+    pFirst = (pFirst == NULL) ? (char *)pPos->pRowBuff : TMIN(pFirst, (char *)pPos->pRowBuff);
+    streamFileStateReleaseBuff(pFileState, pPos, false);
+  }
+
+  SRowBuffPos *pPos = putRow(pFileState, makeWinKey(0, 2000));
+  ASSERT_EQ((char *)pPos->pRowBuff, pFirst + 10 * ALIGN8(FILE_STATE_ROW_SIZE));
+  streamFileStateDestroy(pFileState);
+  closeFileStateDb(&db);
+}
+
+#pragma GCC diagnostic pop
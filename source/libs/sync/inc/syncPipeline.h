@@ -39,6 +39,11 @@ typedef struct SSyncLogReplMgr {
   int64_t       peerStartTime;
   int32_t       retryBackoff;
   int32_t       peerId;
+  int64_t       window;        // max number of entries in flight, adapted to the acks of the peer
+  int64_t       srttMs;        // smoothed round trip time of acked entries
+  int64_t       minRttMs;      // min round trip time observed in the last SYNC_LOG_REPL_MIN_RTT_WIN_MS, -1 if none
+  int64_t       minRttTimeMs;  // when minRttMs was observed
+  int64_t       shrinkTimeMs;  // when the window was shrunk last time
 } SSyncLogReplMgr;
 
 typedef struct SSyncLogBufEntry {
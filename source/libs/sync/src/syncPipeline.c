@@ -436,6 +436,10 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
+  int64_t        startMatchIndex = matchIndex;
+
+  // the entries persisted below share one fsync, done before my match index is advanced
+  walBeginGroupCommit(pNode->pWal);
 
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
@@ -495,6 +499,9 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
               pEntry->index, pEntry->term, 
               pNode->restoreFinish, pNode->commitIndex,
               pEntry->index - 1, pNode->pLogBuf->commitIndex);
+        // flush the group persisted so far, so that the new config is applied only after its entry is durable
+        walEndGroupCommit(pNode->pWal);
+        walBeginGroupCommit(pNode->pWal);
         if(syncNodeChangeConfig(pNode, pEntry, str) != 0){
           sError("vgId:%d, failed to change config from Append since %s. index:%" PRId64, pNode->vgId, terrstr(),
              pEntry->index);
@@ -519,13 +526,17 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
     ASSERT(pEntry->index == pBuf->matchIndex);
 
-    // update my match index
     matchIndex = pBuf->matchIndex;
-    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
   }  // end of while
 
 _out:
+  walEndGroupCommit(pNode->pWal);
+
+  // update my match index
   pBuf->matchIndex = matchIndex;
+  if (matchIndex != startMatchIndex) {
+    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+  }
   if (pMatchTerm) {
     *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
   }
@@ -739,6 +750,12 @@ void syncLogReplReset(SSyncLogReplMgr* pMgr) {
   pMgr->endIndex = 0;
   pMgr->restored = false;
   pMgr->retryBackoff = 0;
+  // the peer may come back on another path, adapt the window to it from scratch
+  pMgr->window = pMgr->size >> 1;
+  pMgr->srttMs = 0;
+  pMgr->minRttMs = -1;
+  pMgr->minRttTimeMs = 0;
+  pMgr->shrinkTimeMs = 0;
 }
 
 int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
@@ -804,6 +821,7 @@ int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
 _out:
   if (retried) {
     pMgr->retryBackoff = syncLogReplGetNextRetryBackoff(pMgr);
+    pMgr->window = TMAX(SYNC_LOG_REPL_MIN_WINDOW, pMgr->window >> 1);
     SSyncLogBuffer* pBuf = pNode->pLogBuf;
     sInfo("vgId:%d, resend %d sync log entries. dest:%" PRIx64 ", indexes:%" PRId64 " ..., terms: ... %" PRId64
           ", retryWaitMs:%" PRId64 ", repl-mgr:[%" PRId64 " %" PRId64 ", %" PRId64 "), buffer: [%" PRId64 " %" PRId64
@@ -981,7 +999,7 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   int32_t   batchSize = TMAX(1, pMgr->size >> (4 + pMgr->retryBackoff));
   int32_t   count = 0;
   int64_t   nowMs = taosGetMonoTimestampMs();
-  int64_t   limit = pMgr->size >> 1;
+  int64_t   limit = pMgr->window;
   SyncTerm  term = -1;
   SyncIndex firstIndex = -1;
 
@@ -1022,16 +1040,47 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
 
   SSyncLogBuffer* pBuf = pNode->pLogBuf;
   sTrace("vgId:%d, replicated %d msgs to peer:%" PRIx64 ". indexes:%" PRId64 "..., terms: ...%" PRId64
-         ", repl-mgr:[%" PRId64 " %" PRId64 ", %" PRId64 "), buffer: [%" PRId64 " %" PRId64 " %" PRId64 ", %" PRId64
-         ")",
+         ", repl-mgr:[%" PRId64 " %" PRId64 ", %" PRId64 "), window:%" PRId64 ", srtt:%" PRId64 "ms, buffer: [%" PRId64
+         " %" PRId64 " %" PRId64 ", %" PRId64 ")",
          pNode->vgId, count, pDestId->addr, firstIndex, term, pMgr->startIndex, pMgr->matchIndex, pMgr->endIndex,
-         pBuf->startIndex, pBuf->commitIndex, pBuf->matchIndex, pBuf->endIndex);
+         pMgr->window, pMgr->srttMs, pBuf->startIndex, pBuf->commitIndex, pBuf->matchIndex, pBuf->endIndex);
   return 0;
 }
 
+/*
+ * Adapt the replication window to the peer: grow it by one entry per timely ack, and shrink it when the smoothed
+ * round trip time rises well above the lowest one observed, i.e. the entries start to queue up on the way to the peer.
+ * The window is shrunk at most once per round trip, since the acks of that round trip all report the same queue.
+ * The lowest round trip time expires after SYNC_LOG_REPL_MIN_RTT_WIN_MS, so that it follows a slower path to the peer.
+ */
+static void syncLogReplUpdateWindow(SSyncLogReplMgr* pMgr, int64_t rttMs, int64_t nowMs) {
+  int64_t maxWindow = pMgr->size >> 1;
+
+  if (pMgr->minRttMs < 0 || rttMs <= pMgr->minRttMs || nowMs - pMgr->minRttTimeMs > SYNC_LOG_REPL_MIN_RTT_WIN_MS) {
+    pMgr->minRttMs = rttMs;
+    pMgr->minRttTimeMs = nowMs;
+  }
+  pMgr->srttMs = (pMgr->srttMs <= 0) ? rttMs : ((pMgr->srttMs * 7 + rttMs) >> 3);
+
+  if (pMgr->srttMs > (pMgr->minRttMs << 1) + SYNC_LOG_REPL_RTT_SLACK_MS) {
+    if (nowMs - pMgr->shrinkTimeMs >= pMgr->srttMs) {
+      pMgr->window = TMAX(SYNC_LOG_REPL_MIN_WINDOW, pMgr->window - (pMgr->window >> 3));
+      pMgr->shrinkTimeMs = nowMs;
+    }
+  } else {
+    pMgr->window = TMIN(maxWindow, pMgr->window + 1);
+  }
+}
+
 int32_t syncLogReplContinue(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg) {
   ASSERT(pMgr->restored == true);
   if (pMgr->startIndex <= pMsg->lastSendIndex && pMsg->lastSendIndex < pMgr->endIndex) {
+    SSyncReplInfo* pState = &pMgr->states[pMsg->lastSendIndex % pMgr->size];
+    if (!pState->acked && pState->timeMs > 0) {
+      int64_t nowMs = taosGetMonoTimestampMs();
+      syncLogReplUpdateWindow(pMgr, nowMs - pState->timeMs, nowMs);
+    }
+
     if (pMgr->startIndex < pMgr->matchIndex && pMgr->retryBackoff > 0) {
       int64_t firstMs = pMgr->states[pMgr->startIndex % pMgr->size].timeMs;
       int64_t lastMs = pMgr->states[(pMgr->endIndex - 1) % pMgr->size].timeMs;
@@ -1062,6 +1111,9 @@ SSyncLogReplMgr* syncLogReplCreate() {
 
   ASSERT(pMgr->size == TSDB_SYNC_LOG_BUFFER_SIZE);
 
+  pMgr->window = pMgr->size >> 1;
+  pMgr->minRttMs = -1;
+
   return pMgr;
 }
 
@@ -230,6 +230,7 @@ void   tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn);
 void   tdbPCacheMarkFree(SPCache *pCache, SPage *pPage);
 void   tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno);
 int    tdbPCacheGetPageSize(SPCache *pCache);
+void   tdbPCacheGetStat(SPCache *pCache, i64 *nHit, i64 *nMiss, i64 *nEvict);
 
 // tdbPage.c ====================================
 typedef u8 SCell;
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdbInt.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define PCACHE_PAGE_SIZE 4096
+
+typedef struct {
+  int32_t owner;
+  SPgno   pgno;
+} SPageStamp;
+
+static void initPgid(SPgid *pPgid, SPgno pgno) {
+  memset(pPgid->fileid, 0, TDB_FILE_ID_LEN);
+  memcpy(pPgid->fileid, "pcache", 6);
+  pPgid->pgno = pgno;
+}
+
+static SPage *fetchPage(SPCache *pCache, TXN *pTxn, int32_t owner, SPgno pgno) {
+  SPgid pgid;
+  initPgid(&pgid, pgno);
+
+  SPage *pPage = tdbPCacheFetch(pCache, &pgid, pTxn);
+  if (pPage == NULL) {
+    return NULL;
+  }
+
+  // a page cached for the pgno keeps the stamp of its owner, any other page gets it now
+  SPageStamp *pStamp = (SPageStamp *)pPage->pData;
+  if (pStamp->owner != owner || pStamp->pgno != pgno) {
+    pStamp->owner = owner;
+    pStamp->pgno = pgno;
+  }
+  return pPage;
+}
+
+// the page still holds the pgno and the stamp it was fetched with, i.e. no other fetch took it meanwhile
+static bool checkPage(SPage *pPage, int32_t owner, SPgno pgno) {
+  SPageStamp *pStamp = (SPageStamp *)pPage->pData;
+  return pPage->pgid.pgno == pgno && pStamp->owner == owner && pStamp->pgno == pgno && tdbGetPageRef(pPage) == 1;
+}
+
+/*
+ * Fetch nFetch pages of the owner and release them in fetch order, holding up to nHold of them at a time. The pgnos of
+ * different owners never meet, so a page held by one owner must not change while it is held.
+ */
+static void fetchPages(SPCache *pCache, int32_t owner, int32_t nPgno, int32_t nFetch, int32_t nHold,
+                       std::atomic<bool> *pStart, std::atomic<int32_t> *pErrors) {
+  TXN                  txn = {0};
+  uint32_t             seed = owner + 1;
+  std::vector<SPage *> held;
+  std::vector<SPgno>   heldPgno;
+
+  while (!*pStart) {
+  }
+
+  for (int32_t i = 0; i < nFetch; i++) {
+    SPgno pgno = owner * nPgno + taosRandR(&seed) % nPgno + 1;
+    bool  isHeld = false;
+    for (SPgno p : heldPgno) {
+      isHeld = isHeld || (p == pgno);
+    }
+    if (isHeld) {
+      continue;
+    }
+
+    SPage *pPage = fetchPage(pCache, &txn, owner, pgno);
+    if (pPage == NULL || !checkPage(pPage, owner, pgno)) {
+      (*pErrors)++;
+      break;
+    }
+    held.push_back(pPage);
+    heldPgno.push_back(pgno);
+
+    if (held.size() >= nHold) {
+      if (!checkPage(held[0], owner, heldPgno[0])) {
+        (*pErrors)++;
+      }
+      tdbPCacheRelease(pCache, held[0], &txn);
+      held.erase(held.begin());
+      heldPgno.erase(heldPgno.begin());
+    }
+  }
+
+  for (int32_t i = 0; i < held.size(); i++) {
+    if (!checkPage(held[i], owner, heldPgno[i])) {
+      (*pErrors)++;
+    }
+    tdbPCacheRelease(pCache, held[i], &txn);
+  }
+}
+
+// threads fetch and release pages of all shards at once, more pages than the cache holds
+TEST(TdbPCacheTest, ConcurrentFetchTest) {
+  const int32_t nThread = 8;
+  const int32_t nFetch = 20000;
+
+  SPCache                 *pCache = NULL;
+  std::vector<std::thread> threads;
+  std::atomic<bool>        start(false);
+  std::atomic<int32_t>     errors(0);
+  i64                      nHit = 0, nMiss = 0, nEvict = 0;
+
+  ASSERT_EQ(tdbPCacheOpen(PCACHE_PAGE_SIZE, 2048, &pCache), 0);
+
+  for (int32_t i = 0; i < nThread; i++) {
+    threads.push_back(std::thread(fetchPages, pCache, i, 1024, nFetch, 16, &start, &errors));
+  }
+  start = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(errors, 0);
+
+  tdbPCacheGetStat(pCache, &nHit, &nMiss, &nEvict);
+  ASSERT_GT(nHit, 0);
+  ASSERT_GT(nEvict, 0);
+  ASSERT_LE(nHit + nMiss, nThread * nFetch);
+
+  // the pages of all the owners are released, they can be fetched again
+  TXN txn = {0};
+  for (SPgno pgno = 1; pgno <= 2048; pgno++) {
+    SPage *pPage = fetchPage(pCache, &txn, nThread, pgno);
+    ASSERT_NE(pPage, nullptr);
+    ASSERT_TRUE(checkPage(pPage, nThread, pgno));
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+
+  ASSERT_EQ(tdbPCacheClose(pCache), 0);
+}
+
+// all the pages are fetched for one shard, which takes them from the others
+TEST(TdbPCacheTest, StealPageTest) {
+  SPCache             *pCache = NULL;
+  TXN                  txn = {0};
+  SPgid                pgid;
+  std::vector<SPage *> held;
+
+  ASSERT_EQ(tdbPCacheOpen(PCACHE_PAGE_SIZE, 2048, &pCache), 0);
+
+  // the pgnos a multiple of the max number of shards apart hash to the same shard
+  for (SPgno pgno = 1; pgno <= 2048; pgno++) {
+    SPage *pPage = fetchPage(pCache, &txn, 0, pgno * 16);
+    ASSERT_NE(pPage, nullptr) << "pgno:" << pgno * 16;
+    held.push_back(pPage);
+  }
+
+  // no page is left, and no page may be created by the txn
+  initPgid(&pgid, 1);
+  ASSERT_EQ(tdbPCacheFetch(pCache, &pgid, &txn), nullptr);
+
+  for (SPage *pPage : held) {
+    ASSERT_TRUE(checkPage(pPage, 0, pPage->pgid.pgno));
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+
+  ASSERT_EQ(tdbPCacheClose(pCache), 0);
+}
+
+static void openFetchClose(int32_t owner, int32_t nPage, std::atomic<bool> *pStart, std::atomic<int32_t> *pErrors) {
+  SPCache          *pCache = NULL;
+  std::atomic<bool> start(true);
+
+  while (!*pStart) {
+  }
+
+  for (int32_t round = 0; round < 20; round++) {
+    if (tdbPCacheOpen(PCACHE_PAGE_SIZE, nPage, &pCache) != 0) {
+      (*pErrors)++;
+      return;
+    }
+    fetchPages(pCache, owner, nPage * 2, 2000, 8, &start, pErrors);
+    tdbPCacheClose(pCache);
+  }
+}
+
+// caches of one shard and of many are opened, used and closed by threads at once
+TEST(TdbPCacheTest, ConcurrentOpenTest) {
+  std::vector<std::thread> threads;
+  std::atomic<bool>        start(false);
+  std::atomic<int32_t>     errors(0);
+
+  for (int32_t i = 0; i < 8; i++) {
+    threads.push_back(std::thread(openFetchClose, i, 64 << (i % 6), &start, &errors));
+  }
+  start = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(errors, 0);
+}
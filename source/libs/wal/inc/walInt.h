@@ -166,6 +166,15 @@ int64_t walGetSeq();
 int     walSeekWriteVer(SWal* pWal, int64_t ver);
 int32_t walRollImpl(SWal* pWal);
 
+// read cache section
+int32_t walReadCacheOpen(SWal* pWal);
+void    walReadCacheClose(SWal* pWal);
+void    walReadCacheClear(SWal* pWal);
+void    walReadCacheRemoveReader(SWalReader* pReader);
+bool    walReadCacheGet(SWalReader* pReader, int64_t ver);
+void    walReadCachePut(SWalReader* pReader);
+// read cache section end
+
 #ifdef __cplusplus
 }
 #endif
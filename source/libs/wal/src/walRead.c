@@ -16,7 +16,7 @@
 #include "taoserror.h"
 #include "walInt.h"
 
-SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id) {
+SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id, bool shareCache) {
   SWalReader *pReader = taosMemoryCalloc(1, sizeof(SWalReader));
   if (pReader == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -30,6 +30,7 @@ SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id) {
   pReader->curVersion = -1;
   pReader->curFileFirstVer = -1;
   pReader->capacity = 0;
+  pReader->shareCache = shareCache;
   if (cond) {
     pReader->cond = *cond;
   } else {
@@ -58,6 +59,7 @@ SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id) {
 void walCloseReader(SWalReader *pReader) {
   if(pReader == NULL) return;
 
+  walReadCacheRemoveReader(pReader);
   taosCloseFile(&pReader->pIdxFile);
   taosCloseFile(&pReader->pLogFile);
   taosMemoryFreeClear(pReader->pHead);
@@ -226,12 +228,13 @@ int32_t walReadSeekVerImpl(SWalReader *pReader, int64_t ver) {
          pReader->curVersion, ver);
 
   pReader->curVersion = ver;
+  pReader->cached = 0;
   return 0;
 }
 
 int32_t walReaderSeekVer(SWalReader *pReader, int64_t ver) {
   SWal *pWal = pReader->pWal;
-  if (ver == pReader->curVersion) {
+  if (ver == pReader->curVersion && !pReader->cached) {
     wDebug("vgId:%d, wal index:%" PRId64 " match, no need to reset", pReader->pWal->cfg.vgId, ver);
     return 0;
   }
@@ -261,7 +264,14 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
     return -1;
   }
 
-  if (pRead->curVersion != ver) {
+  // the body is copied from the cache along with the head
+  if (walReadCacheGet(pRead, ver)) {
+    pRead->curVersion = ver;
+    pRead->cached = 1;
+    return 0;
+  }
+
+  if (pRead->curVersion != ver || pRead->cached) {
     code = walReaderSeekVer(pRead, ver);
     if (code < 0) {
       return -1;
@@ -307,6 +317,11 @@ int32_t walSkipFetchBody(SWalReader *pRead) {
          pRead->pWal->cfg.vgId, pRead->pHead->head.version, pRead->pWal->vers.firstVer, pRead->pWal->vers.commitVer,
          pRead->pWal->vers.lastVer, pRead->pWal->vers.appliedVer, pRead->readerId);
 
+  if (pRead->cached) {
+    pRead->curVersion++;
+    return 0;
+  }
+
   int64_t code = taosLSeekFile(pRead->pLogFile, pRead->pHead->head.bodyLen, SEEK_CUR);
   if (code < 0) {
     terrno = TAOS_SYSTEM_ERROR(errno);
@@ -328,6 +343,11 @@ int32_t walFetchBody(SWalReader *pRead) {
          ", 0x%" PRIx64,
          vgId, ver, pVer->firstVer, pVer->commitVer, pVer->lastVer, pVer->appliedVer, id);
 
+  if (pRead->cached) {
+    pRead->curVersion++;
+    return 0;
+  }
+
   if (pRead->capacity < pReadHead->bodyLen) {
     SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(pRead->pHead, sizeof(SWalCkHead) + pReadHead->bodyLen);
     if (ptr == NULL) {
@@ -365,6 +385,7 @@ int32_t walFetchBody(SWalReader *pRead) {
     return -1;
   }
 
+  walReadCachePut(pRead);
   pRead->curVersion++;
   return 0;
 }
@@ -389,7 +410,14 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
 
   taosThreadMutexLock(&pReader->mutex);
 
-  if (pReader->curVersion != ver) {
+  if (walReadCacheGet(pReader, ver)) {
+    pReader->curVersion = ver + 1;
+    pReader->cached = 1;
+    taosThreadMutexUnlock(&pReader->mutex);
+    return 0;
+  }
+
+  if (pReader->curVersion != ver || pReader->cached) {
     if (walReaderSeekVer(pReader, ver) < 0) {
       wError("vgId:%d, unexpected wal log, index:%" PRId64 ", since %s", pReader->pWal->cfg.vgId, ver, terrstr());
       taosThreadMutexUnlock(&pReader->mutex);
@@ -477,6 +505,7 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     taosThreadMutexUnlock(&pReader->mutex);
     return -1;
   }
+  walReadCachePut(pReader);
   pReader->curVersion++;
 
   taosThreadMutexUnlock(&pReader->mutex);
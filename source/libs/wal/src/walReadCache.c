@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "taoserror.h"
+#include "tlrucache.h"
+#include "walInt.h"
+
+/*
+ * Verified entries behind the commit version, keyed by version. Only the tq and stream readers opened with shareCache
+ * put and take entries, and only once more than one of them has read the log.
+ */
+#define WAL_READ_CACHE_SIZE      (8 * 1024 * 1024)
+#define WAL_READ_CACHE_MAX_ENTRY (1024 * 1024)
+#define WAL_READ_CACHE_VERSIONS  128
+
+struct SWalReadCache {
+  SLRUCache *pCache;
+  int32_t    numOfReaders;
+};
+
+static void walReadCacheDeleter(const void *key, size_t keyLen, void *value, void *ud) { taosMemoryFree(value); }
+
+int32_t walReadCacheOpen(SWal *pWal) {
+  pWal->pReadCache = taosMemoryCalloc(1, sizeof(SWalReadCache));
+  if (pWal->pReadCache == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  pWal->pReadCache->pCache = taosLRUCacheInit(WAL_READ_CACHE_SIZE, 0, .5);
+  if (pWal->pReadCache->pCache == NULL) {
+    taosMemoryFreeClear(pWal->pReadCache);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+  return 0;
+}
+
+void walReadCacheClose(SWal *pWal) {
+  if (pWal->pReadCache == NULL) {
+    return;
+  }
+
+  taosLRUCacheEraseUnrefEntries(pWal->pReadCache->pCache);
+  taosLRUCacheCleanup(pWal->pReadCache->pCache);
+  taosMemoryFreeClear(pWal->pReadCache);
+}
+
+void walReadCacheClear(SWal *pWal) {
+  if (pWal->pReadCache != NULL) {
+    taosLRUCacheEraseUnrefEntries(pWal->pReadCache->pCache);
+  }
+}
+
+// a reader is counted once it reads the log, the ones opened but never read do not turn the cache on
+static void walReadCacheAddReader(SWalReader *pReader) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  if (pCache != NULL && pReader->shareCache && !pReader->cacheReader) {
+    pReader->cacheReader = 1;
+    atomic_add_fetch_32(&pCache->numOfReaders, 1);
+  }
+}
+
+void walReadCacheRemoveReader(SWalReader *pReader) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  if (pCache == NULL || !pReader->cacheReader) {
+    return;
+  }
+
+  pReader->cacheReader = 0;
+  if (atomic_sub_fetch_32(&pCache->numOfReaders, 1) < 2) {
+    walReadCacheClear(pReader->pWal);
+  }
+}
+
+static bool walReadCacheActive(SWalReader *pReader) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  return pCache != NULL && pReader->shareCache && atomic_load_32(&pCache->numOfReaders) >= 2;
+}
+
+bool walReadCacheGet(SWalReader *pReader, int64_t ver) {
+  walReadCacheAddReader(pReader);
+  if (!walReadCacheActive(pReader) || ver < 0) {
+    return false;
+  }
+
+  SLRUCache *pCache = pReader->pWal->pReadCache->pCache;
+  LRUHandle *h = taosLRUCacheLookup(pCache, &ver, sizeof(ver));
+  if (h == NULL) {
+    return false;
+  }
+
+  bool        found = false;
+  SWalCkHead *pEntry = taosLRUCacheValue(pCache, h);
+  if (pReader->capacity < pEntry->head.bodyLen) {
+    SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(pReader->pHead, sizeof(SWalCkHead) + pEntry->head.bodyLen);
+    if (ptr == NULL) {
+      goto _end;
+    }
+    pReader->pHead = ptr;
+    pReader->capacity = pEntry->head.bodyLen;
+  }
+
+  memcpy(pReader->pHead, pEntry, sizeof(SWalCkHead) + pEntry->head.bodyLen);
+  found = true;
+
+_end:
+  taosLRUCacheRelease(pCache, h, false);
+  return found;
+}
+
+// put the entry in pReader->pHead, which is read from the log file and verified
+void walReadCachePut(SWalReader *pReader) {
+  SWalCkHead *pHead = pReader->pHead;
+  int64_t     ver = pHead->head.version;
+  int64_t     size = sizeof(SWalCkHead) + pHead->head.bodyLen;
+  int64_t     commitVer = pReader->pWal->vers.commitVer;
+
+  if (!walReadCacheActive(pReader) || size > WAL_READ_CACHE_MAX_ENTRY) {
+    return;
+  }
+
+  // uncommitted entries may be rolled back, and the ones far behind are rarely read again
+  if (ver > commitVer || ver <= commitVer - WAL_READ_CACHE_VERSIONS) {
+    return;
+  }
+
+  SWalCkHead *pEntry = taosMemoryMalloc(size);
+  if (pEntry == NULL) {
+    return;
+  }
+
+  memcpy(pEntry, pHead, size);
+  (void)taosLRUCacheInsert(pReader->pWal->pReadCache->pCache, &ver, sizeof(ver), pEntry, size, walReadCacheDeleter,
+                           NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+}
@@ -75,6 +75,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
   pWal->vers.commitVer = ver;
   pWal->vers.snapshotVer = ver;
   pWal->vers.verInSnapshotting = -1;
+  walReadCacheClear(pWal);
 
   taosThreadMutexUnlock(&pWal->mutex);
   return 0;
@@ -513,15 +514,9 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     goto END;
   }
 
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
-
-  if (taosWriteFile(pWal->pLogFile, (char *)body, bodyLen) != bodyLen) {
+  // write head and body with one system call
+  TdFileIoVec vec[2] = {{.buf = &pWal->writeHead, .len = sizeof(SWalCkHead)}, {.buf = body, .len = bodyLen}};
+  if (taosWritevFile(pWal->pLogFile, vec, 2) != sizeof(SWalCkHead) + bodyLen) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
            strerror(errno));
@@ -637,8 +632,7 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
   return walWriteWithSyncInfo(pWal, index, msgType, syncMeta, body, bodyLen);
 }
 
-void walFsync(SWal *pWal, bool forceFsync) {
-  taosThreadMutexLock(&pWal->mutex);
+static void walDoFsync(SWal *pWal, bool forceFsync) {
   if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
     wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
     if (taosFsyncFile(pWal->pLogFile) < 0) {
@@ -646,5 +640,34 @@ void walFsync(SWal *pWal, bool forceFsync) {
              strerror(errno));
     }
   }
+}
+
+void walFsync(SWal *pWal, bool forceFsync) {
+  taosThreadMutexLock(&pWal->mutex);
+  if (pWal->inGroupCommit) {
+    pWal->groupNeedFsync = true;
+    pWal->groupForceFsync |= forceFsync;
+  } else {
+    walDoFsync(pWal, forceFsync);
+  }
+  taosThreadMutexUnlock(&pWal->mutex);
+}
+
+void walBeginGroupCommit(SWal *pWal) {
+  taosThreadMutexLock(&pWal->mutex);
+  pWal->inGroupCommit = true;
+  pWal->groupNeedFsync = false;
+  pWal->groupForceFsync = false;
+  taosThreadMutexUnlock(&pWal->mutex);
+}
+
+void walEndGroupCommit(SWal *pWal) {
+  taosThreadMutexLock(&pWal->mutex);
+  if (pWal->groupNeedFsync) {
+    walDoFsync(pWal, pWal->groupForceFsync);
+  }
+  pWal->inGroupCommit = false;
+  pWal->groupNeedFsync = false;
+  pWal->groupForceFsync = false;
   taosThreadMutexUnlock(&pWal->mutex);
 }
@@ -234,6 +234,25 @@ TEST_F(WalCleanEnv, write) {
   ASSERT_EQ(code, 0);
 }
 
+TEST_F(WalCleanEnv, groupCommit) {
+  int code;
+  walBeginGroupCommit(pWal);
+  for (int i = 0; i < 10; i++) {
+    code = walWrite(pWal, i, i + 1, (void*)ranStr, ranStrLen);
+    ASSERT_EQ(code, 0);
+    walFsync(pWal, false);
+    ASSERT_EQ(pWal->groupNeedFsync, true);
+  }
+  walFsync(pWal, true);
+  ASSERT_EQ(pWal->groupForceFsync, true);
+  walEndGroupCommit(pWal);
+  ASSERT_EQ(pWal->inGroupCommit, false);
+  ASSERT_EQ(pWal->groupNeedFsync, false);
+  ASSERT_EQ(pWal->vers.lastVer, 9);
+  code = walSaveMeta(pWal);
+  ASSERT_EQ(code, 0);
+}
+
 TEST_F(WalCleanEnv, rollback) {
   int code;
   for (int i = 0; i < 10; i++) {
@@ -326,7 +345,7 @@ TEST_F(WalCleanDeleteEnv, roll) {
 TEST_F(WalKeepEnv, readHandleRead) {
   walResetEnv();
   int         code;
-  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0, false);
   ASSERT(pRead != NULL);
 
   int i;
@@ -361,6 +380,70 @@ TEST_F(WalKeepEnv, readHandleRead) {
   walCloseReader(pRead);
 }
 
+TEST_F(WalKeepEnv, readCacheShared) {
+  walResetEnv();
+  int         code;
+  SWalReader* pRead1 = walOpenReader(pWal, NULL, 0, true);
+  SWalReader* pRead2 = walOpenReader(pWal, NULL, 0, true);
+  ASSERT(pRead1 != NULL && pRead2 != NULL);
+
+  for (int i = 0; i <= 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    code = walWrite(pWal, i, 0, newStr, strlen(newStr));
+    ASSERT_EQ(code, 0);
+  }
+  code = walCommit(pWal, 100);
+  ASSERT_EQ(code, 0);
+
+  // the readers are counted once they read the log
+  code = walReadVer(pRead1, 100);
+  ASSERT_EQ(code, 0);
+  code = walReadVer(pRead2, 100);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pRead2->cached, 0);
+
+  // the second reader is served by the entries the first one read
+  for (int ver = 0; ver < 100; ver++) {
+    code = walReadVer(pRead1, ver);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead1->cached, 0);
+
+    code = walFetchHead(pRead2, ver);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead2->cached, 1);
+    code = walFetchBody(pRead2);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead2->curVersion, ver + 1);
+
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, ver);
+    int len = strlen(newStr);
+    ASSERT_EQ(pRead2->pHead->head.version, ver);
+    ASSERT_EQ(pRead2->pHead->head.bodyLen, len);
+    ASSERT_EQ(memcmp(newStr, pRead2->pHead->head.body, len), 0);
+  }
+
+  // the log file is read again after a miss
+  walReadCacheClear(pWal);
+  code = walReadVer(pRead2, 50);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pRead2->cached, 0);
+  ASSERT_EQ(pRead2->pHead->head.version, 50);
+  code = walFetchHead(pRead2, 51);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pRead2->pHead->head.version, 51);
+
+  // nothing is cached with a single reader
+  walCloseReader(pRead1);
+  code = walReadVer(pRead2, 60);
+  ASSERT_EQ(code, 0);
+  code = walReadVer(pRead2, 60);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(pRead2->cached, 0);
+  walCloseReader(pRead2);
+}
+
 TEST_F(WalRetentionEnv, repairMeta1) {
   walResetEnv();
   int code;
@@ -387,7 +470,7 @@ TEST_F(WalRetentionEnv, repairMeta1) {
 
   ASSERT_EQ(pWal->vers.lastVer, 99);
 
-  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0, false);
   ASSERT(pRead != NULL);
 
   for (int i = 0; i < 1000; i++) {
@@ -92,7 +92,7 @@ void osUpdate() {
   }
 }
 
-void osCleanup() {}
+void osCleanup() { taosAIOCleanup(); }
 
 bool osLogSpaceAvailable() { return tsLogSpace.size.avail > 0; }
 
@@ -36,11 +36,24 @@
 #include <sys/sendfile.h>
 #endif
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define LINUX_FILE_NO_TEXT_OPTION 0
 #define O_TEXT                    LINUX_FILE_NO_TEXT_OPTION
 
 #define _SEND_FILE_STEP_ 1000
+
+#if defined(LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// IORING_OP_READ and IORING_OP_WRITE are enum values, the feature flag of the same kernel version tells older headers
+#ifdef IORING_FEAT_RW_CUR_POS
+#define USE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+#endif
 #endif
 
 typedef int32_t FileFd;
@@ -400,6 +413,37 @@ int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count) {
   return bytesWritten;
 }
 
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIoVec *pVec, int32_t count) {
+  if (pFile == NULL || pFile->hFile == NULL) {
+    return 0;
+  }
+#if FILE_WITH_LOCK
+  taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+
+  int64_t total = 0;
+  SetLastError(0);
+  for (int32_t i = 0; i < count; ++i) {
+    DWORD bytesWritten;
+    if (!WriteFile(pFile->hFile, pVec[i].buf, pVec[i].len, &bytesWritten, NULL)) {
+      errno = GetLastError();
+      total = -1;
+      break;
+    }
+    if (bytesWritten != pVec[i].len) {
+      errno = EIO;
+      total = -1;
+      break;
+    }
+    total += bytesWritten;
+  }
+
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+  return total;
+}
+
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
   if (pFile == NULL) {
     return 0;
@@ -744,6 +788,63 @@ int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count) {
   return count;
 }
 
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIoVec *pVec, int32_t count) {
+  if (pFile == NULL || count <= 0) {
+    return 0;
+  }
+#if FILE_WITH_LOCK
+  taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    return 0;
+  }
+
+  // a vector longer than TD_FILE_MAX_IOV is written in chunks of TD_FILE_MAX_IOV entries under the same lock
+  struct iovec iov[TD_FILE_MAX_IOV];
+  int64_t      total = 0;
+  for (int32_t start = 0; start < count; start += TD_FILE_MAX_IOV) {
+    int32_t nIov = TMIN(count - start, TD_FILE_MAX_IOV);
+    for (int32_t i = 0; i < nIov; ++i) {
+      iov[i].iov_base = (void *)pVec[start + i].buf;
+      iov[i].iov_len = pVec[start + i].len;
+      total += pVec[start + i].len;
+    }
+
+    // on a short write, skip what has been written and continue with the rest of the chunk
+    struct iovec *pIov = iov;
+    while (nIov > 0) {
+      int64_t nwritten = writev(pFile->fd, pIov, nIov);
+      if (nwritten < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+#if FILE_WITH_LOCK
+        taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        return -1;
+      }
+
+      while (nIov > 0 && nwritten >= pIov->iov_len) {
+        nwritten -= pIov->iov_len;
+        pIov++;
+        nIov--;
+      }
+      if (nIov > 0) {
+        pIov->iov_base = (char *)pIov->iov_base + nwritten;
+        pIov->iov_len -= nwritten;
+      }
+    }
+  }
+
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+  return total;
+}
+
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
   if (pFile == NULL) {
     return 0;
@@ -1394,13 +1495,426 @@ int32_t taosSetFileHandlesLimit() {
 }
 
 int32_t taosLinkFile(char *src, char *dst) {
-#ifndef WINDOWS
+#ifdef WINDOWS
+  return -1;
+#else
   if (link(src, dst) != 0) {
     if (errno == EXDEV || errno == ENOTSUP) {
       return -1;
     }
     return errno;
   }
+  return 0;
 #endif
+}
+
+#define AIO_NUM_OF_THREADS 4
+
+typedef struct SAIOTask {
+  TdAIOPtr         pAio;
+  STaosAIOReq     *pReq;
+  struct SAIOTask *next;
+} SAIOTask;
+
+typedef struct SAIOThreadPool {
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+  SAIOTask     *head;
+  SAIOTask     *tail;
+  int8_t        stop;
+  int32_t       numOfThreads;
+  TdThread      threads[AIO_NUM_OF_THREADS];
+} SAIOThreadPool;
+
+typedef struct STaosAIO {
+  int32_t       depth;
+  int32_t       inflight;
+  int32_t       numOfDone;
+  STaosAIOReq **pDone;  // completed requests not yet returned to the caller
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+#ifdef USE_IO_URING
+  int32_t                ringFd;  // -1 if io_uring is not used
+  void                  *sqPtr;
+  size_t                 sqLen;
+  void                  *cqPtr;
+  size_t                 cqLen;
+  struct io_uring_sqe   *sqes;
+  size_t                 sqesLen;
+  uint32_t              *sqHead;
+  uint32_t              *sqTail;
+  uint32_t              *sqMask;
+  uint32_t              *sqArray;
+  uint32_t              *cqHead;
+  uint32_t              *cqTail;
+  uint32_t              *cqMask;
+  struct io_uring_cqe   *cqes;
+#endif
+} STaosAIO;
+
+static SAIOThreadPool aioPool;
+static TdThreadOnce   aioPoolInit = PTHREAD_ONCE_INIT;
+static int8_t         aioPoolInited = 0;
+
+// the result and the error of the request come from the call itself, not from errno after the file wrappers
+static void taosAIODoReq(STaosAIOReq *pReq) {
+#ifdef WINDOWS
+  if (pReq->write) {
+    pReq->res = taosPWriteFile(pReq->pFile, pReq->buf, pReq->count, pReq->offset);
+  } else {
+    pReq->res = taosPReadFile(pReq->pFile, pReq->buf, pReq->count, pReq->offset);
+  }
+  pReq->code = pReq->res < 0 ? EIO : 0;
+#else
+  int64_t res = pReq->write ? pwrite(pReq->pFile->fd, pReq->buf, pReq->count, pReq->offset)
+                            : pread(pReq->pFile->fd, pReq->buf, pReq->count, pReq->offset);
+  pReq->code = res < 0 ? errno : 0;
+  pReq->res = res < 0 ? -1 : res;
+#endif
+}
+
+static void *taosAIOThreadFp(void *param) {
+  setThreadName("aio");
+  while (1) {
+    taosThreadMutexLock(&aioPool.mutex);
+    while (aioPool.head == NULL && !aioPool.stop) {
+      taosThreadCondWait(&aioPool.cond, &aioPool.mutex);
+    }
+    // the queued requests are still done when stopping, their buffers are waited for by the callers
+    SAIOTask *pTask = aioPool.head;
+    if (pTask == NULL) {
+      taosThreadMutexUnlock(&aioPool.mutex);
+      break;
+    }
+    aioPool.head = pTask->next;
+    if (aioPool.head == NULL) {
+      aioPool.tail = NULL;
+    }
+    taosThreadMutexUnlock(&aioPool.mutex);
+
+    STaosAIOReq *pReq = pTask->pReq;
+    taosAIODoReq(pReq);
+
+    TdAIOPtr pAio = pTask->pAio;
+    taosThreadMutexLock(&pAio->mutex);
+    pAio->pDone[pAio->numOfDone++] = pReq;
+    taosThreadCondSignal(&pAio->cond);
+    taosThreadMutexUnlock(&pAio->mutex);
+    taosMemoryFree(pTask);
+  }
+  return NULL;
+}
+
+static void taosAIOInitThreadPool() {
+  taosThreadMutexInit(&aioPool.mutex, NULL);
+  taosThreadCondInit(&aioPool.cond, NULL);
+  aioPoolInited = 1;
+}
+
+static int32_t taosAIOStartThreadPool() {
+  taosThreadOnce(&aioPoolInit, taosAIOInitThreadPool);
+
+  taosThreadMutexLock(&aioPool.mutex);
+  aioPool.stop = 0;
+  while (aioPool.numOfThreads < AIO_NUM_OF_THREADS) {
+    if (taosThreadCreate(&aioPool.threads[aioPool.numOfThreads], NULL, taosAIOThreadFp, NULL) != 0) {
+      break;
+    }
+    aioPool.numOfThreads++;
+  }
+  int32_t code = aioPool.numOfThreads > 0 ? 0 : -1;
+  taosThreadMutexUnlock(&aioPool.mutex);
+  return code;
+}
+
+void taosAIOCleanup() {
+  if (!aioPoolInited) {
+    return;
+  }
+
+  taosThreadMutexLock(&aioPool.mutex);
+  aioPool.stop = 1;
+  taosThreadCondBroadcast(&aioPool.cond);
+  int32_t numOfThreads = aioPool.numOfThreads;
+  taosThreadMutexUnlock(&aioPool.mutex);
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    taosThreadJoin(aioPool.threads[i], NULL);
+  }
+
+  taosThreadMutexLock(&aioPool.mutex);
+  aioPool.numOfThreads = 0;
+  taosThreadMutexUnlock(&aioPool.mutex);
+}
+
+#ifdef USE_IO_URING
+static int32_t taosAIOInitRing(TdAIOPtr pAio) {
+  struct io_uring_params params = {0};
+  pAio->ringFd = syscall(__NR_io_uring_setup, pAio->depth, &params);
+  if (pAio->ringFd < 0) {
+    return -1;
+  }
+
+  // IORING_OP_READ and IORING_OP_WRITE come with the same kernel version
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+    goto _error;
+  }
+
+  pAio->sqLen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  pAio->cqLen = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  pAio->sqesLen = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  pAio->sqPtr = mmap(NULL, pAio->sqLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd,
+                     IORING_OFF_SQ_RING);
+  if (pAio->sqPtr == MAP_FAILED) {
+    pAio->sqPtr = NULL;
+    goto _error;
+  }
+  pAio->cqPtr = mmap(NULL, pAio->cqLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd,
+                     IORING_OFF_CQ_RING);
+  if (pAio->cqPtr == MAP_FAILED) {
+    pAio->cqPtr = NULL;
+    goto _error;
+  }
+  pAio->sqes = mmap(NULL, pAio->sqesLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd,
+                    IORING_OFF_SQES);
+  if (pAio->sqes == MAP_FAILED) {
+    pAio->sqes = NULL;
+    goto _error;
+  }
+
+  pAio->sqHead = (uint32_t *)((char *)pAio->sqPtr + params.sq_off.head);
+  pAio->sqTail = (uint32_t *)((char *)pAio->sqPtr + params.sq_off.tail);
+  pAio->sqMask = (uint32_t *)((char *)pAio->sqPtr + params.sq_off.ring_mask);
+  pAio->sqArray = (uint32_t *)((char *)pAio->sqPtr + params.sq_off.array);
+  pAio->cqHead = (uint32_t *)((char *)pAio->cqPtr + params.cq_off.head);
+  pAio->cqTail = (uint32_t *)((char *)pAio->cqPtr + params.cq_off.tail);
+  pAio->cqMask = (uint32_t *)((char *)pAio->cqPtr + params.cq_off.ring_mask);
+  pAio->cqes = (struct io_uring_cqe *)((char *)pAio->cqPtr + params.cq_off.cqes);
   return 0;
+
+_error:
+  if (pAio->sqPtr) munmap(pAio->sqPtr, pAio->sqLen);
+  if (pAio->cqPtr) munmap(pAio->cqPtr, pAio->cqLen);
+  close(pAio->ringFd);
+  pAio->ringFd = -1;
+  return -1;
 }
+
+// move the completions in the ring to pDone, returns the number moved
+static int32_t taosAIOReapRing(TdAIOPtr pAio) {
+  int32_t  n = 0;
+  uint32_t head = *pAio->cqHead;
+  uint32_t tail = (uint32_t)atomic_load_32((int32_t *)pAio->cqTail);
+  for (; head != tail && pAio->numOfDone < pAio->depth; ++head, ++n) {
+    struct io_uring_cqe *pCqe = &pAio->cqes[head & *pAio->cqMask];
+    STaosAIOReq         *pReq = (STaosAIOReq *)(uintptr_t)pCqe->user_data;
+    pReq->res = pCqe->res < 0 ? -1 : pCqe->res;
+    pReq->code = pCqe->res < 0 ? -pCqe->res : 0;
+    pAio->pDone[pAio->numOfDone++] = pReq;
+  }
+  atomic_store_32((int32_t *)pAio->cqHead, (int32_t)head);
+  return n;
+}
+
+static int32_t taosAIOSubmitRing(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num) {
+  // all entries published before are taken by the kernel, so the ring is empty here
+  uint32_t start = *pAio->sqTail;
+  uint32_t tail = start;
+  for (int32_t i = 0; i < num; ++i) {
+    STaosAIOReq *pReq = pReqs[i];
+    uint32_t     idx = tail & *pAio->sqMask;
+
+    struct io_uring_sqe *pSqe = &pAio->sqes[idx];
+    memset(pSqe, 0, sizeof(*pSqe));
+    pSqe->opcode = pReq->write ? IORING_OP_WRITE : IORING_OP_READ;
+    pSqe->fd = pReq->pFile->fd;
+    pSqe->addr = (uint64_t)(uintptr_t)pReq->buf;
+    pSqe->len = (uint32_t)pReq->count;
+    pSqe->off = (uint64_t)pReq->offset;
+    pSqe->user_data = (uint64_t)(uintptr_t)pReq;
+
+    pAio->sqArray[idx] = idx;
+    tail += 1;
+  }
+  atomic_store_32((int32_t *)pAio->sqTail, (int32_t)tail);
+
+  uint32_t head = start;
+  while ((head = (uint32_t)atomic_load_32((int32_t *)pAio->sqHead)) != tail) {
+    if (syscall(__NR_io_uring_enter, pAio->ringFd, tail - head, 0, 0, NULL, 0) >= 0 || errno == EINTR) {
+      continue;
+    }
+
+    // the completion queue is full, make room and try again
+    if (errno == EBUSY || errno == EAGAIN) {
+      if (taosAIOReapRing(pAio) > 0) {
+        continue;
+      }
+      if (syscall(__NR_io_uring_enter, pAio->ringFd, 0, 0, IORING_ENTER_GETEVENTS, NULL, 0) >= 0 &&
+          taosAIOReapRing(pAio) > 0) {
+        continue;
+      }
+    }
+
+    // the entries not taken by the kernel are withdrawn, so that none of them is left in the ring unaccounted
+    atomic_store_32((int32_t *)pAio->sqTail, (int32_t)head);
+    break;
+  }
+
+  int32_t submitted = (int32_t)(head - start);
+  return submitted > 0 ? submitted : -1;
+}
+
+static int32_t taosAIOGetCompletedRing(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num, bool block) {
+  while (taosAIOReapRing(pAio) == 0 && pAio->numOfDone == 0 && block) {
+    if (syscall(__NR_io_uring_enter, pAio->ringFd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR) {
+      return -1;
+    }
+  }
+
+  int32_t n = TMIN(num, pAio->numOfDone);
+  pAio->numOfDone -= n;
+  memcpy(pReqs, pAio->pDone + pAio->numOfDone, n * sizeof(STaosAIOReq *));
+  return n;
+}
+#endif
+
+TdAIOPtr taosAIOOpen(int32_t depth, int32_t flags) {
+  TdAIOPtr pAio = taosMemoryCalloc(1, sizeof(STaosAIO));
+  if (pAio == NULL) {
+    return NULL;
+  }
+
+  pAio->depth = depth;
+  pAio->pDone = taosMemoryCalloc(depth, sizeof(STaosAIOReq *));
+  if (pAio->pDone == NULL) {
+    taosMemoryFree(pAio);
+    return NULL;
+  }
+  taosThreadMutexInit(&pAio->mutex, NULL);
+  taosThreadCondInit(&pAio->cond, NULL);
+
+#ifdef USE_IO_URING
+  pAio->ringFd = -1;
+  if (!(flags & TD_AIO_THREAD_POOL) && taosAIOInitRing(pAio) == 0) {
+    return pAio;
+  }
+#endif
+
+  if ((flags & TD_AIO_RING) || taosAIOStartThreadPool() != 0) {
+    taosAIOClose(pAio);
+    return NULL;
+  }
+  return pAio;
+}
+
+void taosAIOClose(TdAIOPtr pAio) {
+  if (pAio == NULL) {
+    return;
+  }
+
+  // the buffers of the requests in flight are still in use by the kernel or the threads
+  STaosAIOReq *pReqs[16];
+  while (pAio->inflight > 0) {
+    int32_t n = taosAIOGetCompleted(pAio, pReqs, tListLen(pReqs), true);
+    if (n < 0) {
+      break;
+    }
+  }
+
+#ifdef USE_IO_URING
+  if (pAio->ringFd >= 0) {
+    munmap(pAio->sqes, pAio->sqesLen);
+    munmap(pAio->sqPtr, pAio->sqLen);
+    munmap(pAio->cqPtr, pAio->cqLen);
+    close(pAio->ringFd);
+  }
+#endif
+
+  taosThreadMutexDestroy(&pAio->mutex);
+  taosThreadCondDestroy(&pAio->cond);
+  taosMemoryFree(pAio->pDone);
+  taosMemoryFree(pAio);
+}
+
+int32_t taosAIOSubmit(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num) {
+  num = TMIN(num, pAio->depth - pAio->inflight);
+  if (num <= 0) {
+    return 0;
+  }
+
+#ifdef USE_IO_URING
+  if (pAio->ringFd >= 0) {
+    int32_t n = taosAIOSubmitRing(pAio, pReqs, num);
+    if (n > 0) {
+      pAio->inflight += n;
+    }
+    return n;
+  }
+#endif
+
+  SAIOTask *pHead = NULL;
+  SAIOTask *pTail = NULL;
+  for (int32_t i = 0; i < num; ++i) {
+    SAIOTask *pTask = taosMemoryMalloc(sizeof(SAIOTask));
+    if (pTask == NULL) {
+      num = i;
+      break;
+    }
+    pTask->pAio = pAio;
+    pTask->pReq = pReqs[i];
+    pTask->next = NULL;
+    if (pTail == NULL) {
+      pHead = pTask;
+    } else {
+      pTail->next = pTask;
+    }
+    pTail = pTask;
+  }
+
+  if (num == 0) {
+    return -1;
+  }
+
+  pAio->inflight += num;
+  taosThreadMutexLock(&aioPool.mutex);
+  if (aioPool.tail == NULL) {
+    aioPool.head = pHead;
+  } else {
+    aioPool.tail->next = pHead;
+  }
+  aioPool.tail = pTail;
+  taosThreadCondBroadcast(&aioPool.cond);
+  taosThreadMutexUnlock(&aioPool.mutex);
+  return num;
+}
+
+int32_t taosAIOGetCompleted(TdAIOPtr pAio, STaosAIOReq **pReqs, int32_t num, bool block) {
+  if (pAio->inflight == 0) {
+    return 0;
+  }
+
+#ifdef USE_IO_URING
+  if (pAio->ringFd >= 0) {
+    int32_t n = taosAIOGetCompletedRing(pAio, pReqs, num, block);
+    if (n > 0) {
+      pAio->inflight -= n;
+    }
+    return n;
+  }
+#endif
+
+  taosThreadMutexLock(&pAio->mutex);
+  while (block && pAio->numOfDone == 0) {
+    taosThreadCondWait(&pAio->cond, &pAio->mutex);
+  }
+  int32_t n = TMIN(num, pAio->numOfDone);
+  pAio->numOfDone -= n;
+  memcpy(pReqs, pAio->pDone + pAio->numOfDone, n * sizeof(STaosAIOReq *));
+  taosThreadMutexUnlock(&pAio->mutex);
+
+  pAio->inflight -= n;
+  return n;
+}
+
+int32_t taosAIOGetInflight(TdAIOPtr pAio) { return pAio->inflight; }
@@ -70,4 +70,11 @@ int32_t BUILDIN_CTZ(uint32_t val) {
   return (int)(r);
 }
 
+int32_t BUILDIN_POPCNTL(uint64_t val) {
+  val = val - ((val >> 1) & 0x5555555555555555ULL);
+  val = (val & 0x3333333333333333ULL) + ((val >> 2) & 0x3333333333333333ULL);
+  val = (val + (val >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((val * 0x0101010101010101ULL) >> 56);
+}
+
 #endif
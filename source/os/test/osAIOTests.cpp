@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#define AIO_TEST_BLOCK_SIZE 4096
+#define AIO_TEST_BLOCKS     64
+#define AIO_TEST_DEPTH      8
+
+static void aioTestFillBlock(char *buf, int32_t block) {
+  for (int32_t i = 0; i < AIO_TEST_BLOCK_SIZE; ++i) {
+    buf[i] = (char)(block * 31 + i);
+  }
+}
+
+static void aioTestCreateFile(const char *path) {
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+
+  char buf[AIO_TEST_BLOCK_SIZE];
+  for (int32_t i = 0; i < AIO_TEST_BLOCKS; ++i) {
+    aioTestFillBlock(buf, i);
+    ASSERT_EQ(taosWriteFile(pFile, buf, AIO_TEST_BLOCK_SIZE), AIO_TEST_BLOCK_SIZE);
+  }
+  taosCloseFile(&pFile);
+}
+
+// reads all blocks in the reverse order with at most AIO_TEST_DEPTH requests in flight
+static void aioTestRead(TdAIOPtr pAio, const char *path) {
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_READ);
+  ASSERT_NE(pFile, nullptr);
+
+  STaosAIOReq  reqs[AIO_TEST_BLOCKS] = {0};
+  STaosAIOReq *pReqs[AIO_TEST_BLOCKS];
+  char        *bufs = (char *)taosMemoryCalloc(AIO_TEST_BLOCKS, AIO_TEST_BLOCK_SIZE);
+  for (int32_t i = 0; i < AIO_TEST_BLOCKS; ++i) {
+    int32_t block = AIO_TEST_BLOCKS - 1 - i;
+    reqs[i].pFile = pFile;
+    reqs[i].buf = bufs + block * AIO_TEST_BLOCK_SIZE;
+    reqs[i].count = AIO_TEST_BLOCK_SIZE;
+    reqs[i].offset = (int64_t)block * AIO_TEST_BLOCK_SIZE;
+    reqs[i].param = (void *)(intptr_t)block;
+    pReqs[i] = &reqs[i];
+  }
+
+  int32_t submitted = 0;
+  int32_t completed = 0;
+  while (completed < AIO_TEST_BLOCKS) {
+    if (submitted < AIO_TEST_BLOCKS) {
+      int32_t n = taosAIOSubmit(pAio, pReqs + submitted, AIO_TEST_BLOCKS - submitted);
+      ASSERT_GE(n, 0);
+      ASSERT_LE(taosAIOGetInflight(pAio), AIO_TEST_DEPTH);
+      submitted += n;
+    }
+
+    STaosAIOReq *pDone[AIO_TEST_DEPTH];
+    int32_t      n = taosAIOGetCompleted(pAio, pDone, AIO_TEST_DEPTH, true);
+    ASSERT_GT(n, 0);
+    for (int32_t i = 0; i < n; ++i) {
+      ASSERT_EQ(pDone[i]->code, 0);
+      ASSERT_EQ(pDone[i]->res, AIO_TEST_BLOCK_SIZE);
+    }
+    completed += n;
+  }
+  ASSERT_EQ(taosAIOGetInflight(pAio), 0);
+
+  char expect[AIO_TEST_BLOCK_SIZE];
+  for (int32_t i = 0; i < AIO_TEST_BLOCKS; ++i) {
+    aioTestFillBlock(expect, i);
+    ASSERT_EQ(memcmp(bufs + i * AIO_TEST_BLOCK_SIZE, expect, AIO_TEST_BLOCK_SIZE), 0);
+  }
+
+  taosMemoryFree(bufs);
+  taosCloseFile(&pFile);
+}
+
+static void aioTestWrite(TdAIOPtr pAio, const char *path) {
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+
+  STaosAIOReq reqs[AIO_TEST_DEPTH] = {0};
+  char        bufs[AIO_TEST_DEPTH][AIO_TEST_BLOCK_SIZE];
+  for (int32_t i = 0; i < AIO_TEST_DEPTH; ++i) {
+    aioTestFillBlock(bufs[i], i);
+    reqs[i].pFile = pFile;
+    reqs[i].buf = bufs[i];
+    reqs[i].count = AIO_TEST_BLOCK_SIZE;
+    reqs[i].offset = (int64_t)i * AIO_TEST_BLOCK_SIZE;
+    reqs[i].write = 1;
+    STaosAIOReq *pReq = &reqs[i];
+    ASSERT_EQ(taosAIOSubmit(pAio, &pReq, 1), 1);
+  }
+
+  // the queue is full
+  STaosAIOReq  extra = reqs[0];
+  STaosAIOReq *pExtra = &extra;
+  ASSERT_EQ(taosAIOSubmit(pAio, &pExtra, 1), 0);
+
+  int32_t completed = 0;
+  while (completed < AIO_TEST_DEPTH) {
+    STaosAIOReq *pDone[AIO_TEST_DEPTH];
+    int32_t      n = taosAIOGetCompleted(pAio, pDone, AIO_TEST_DEPTH, true);
+    ASSERT_GT(n, 0);
+    for (int32_t i = 0; i < n; ++i) {
+      ASSERT_EQ(pDone[i]->res, AIO_TEST_BLOCK_SIZE);
+    }
+    completed += n;
+  }
+
+  char buf[AIO_TEST_BLOCK_SIZE];
+  for (int32_t i = 0; i < AIO_TEST_DEPTH; ++i) {
+    ASSERT_EQ(taosPReadFile(pFile, buf, AIO_TEST_BLOCK_SIZE, (int64_t)i * AIO_TEST_BLOCK_SIZE), AIO_TEST_BLOCK_SIZE);
+    ASSERT_EQ(memcmp(buf, bufs[i], AIO_TEST_BLOCK_SIZE), 0);
+  }
+  taosCloseFile(&pFile);
+}
+
+// a read beyond the end of file returns 0, and a read of a file not opened for read fails with its own error
+static void aioTestReadError(TdAIOPtr pAio, const char *path) {
+  TdFilePtr pReadFile = taosOpenFile(path, TD_FILE_READ);
+  TdFilePtr pWriteFile = taosOpenFile(path, TD_FILE_WRITE);
+  ASSERT_NE(pReadFile, nullptr);
+  ASSERT_NE(pWriteFile, nullptr);
+
+  char        buf[2][AIO_TEST_BLOCK_SIZE];
+  STaosAIOReq reqs[2] = {0};
+  reqs[0].pFile = pReadFile;
+  reqs[0].buf = buf[0];
+  reqs[0].count = AIO_TEST_BLOCK_SIZE;
+  reqs[0].offset = (int64_t)AIO_TEST_BLOCKS * AIO_TEST_BLOCK_SIZE;
+  reqs[1].pFile = pWriteFile;
+  reqs[1].buf = buf[1];
+  reqs[1].count = AIO_TEST_BLOCK_SIZE;
+  reqs[1].offset = 0;
+
+  STaosAIOReq *pReqs[2] = {&reqs[0], &reqs[1]};
+  ASSERT_EQ(taosAIOSubmit(pAio, pReqs, 2), 2);
+
+  int32_t completed = 0;
+  while (completed < 2) {
+    STaosAIOReq *pDone[2];
+    int32_t      n = taosAIOGetCompleted(pAio, pDone, 2, true);
+    ASSERT_GT(n, 0);
+    completed += n;
+  }
+
+  ASSERT_EQ(reqs[0].res, 0);
+  ASSERT_EQ(reqs[0].code, 0);
+  ASSERT_EQ(reqs[1].res, -1);
+  ASSERT_EQ(reqs[1].code, EBADF);
+
+  taosCloseFile(&pReadFile);
+  taosCloseFile(&pWriteFile);
+}
+
+static void aioTestAll(int32_t flags) {
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/osAIOTest%d.data", TD_TMP_DIR_PATH, flags);
+  aioTestCreateFile(path);
+
+  TdAIOPtr pAio = taosAIOOpen(AIO_TEST_DEPTH, flags);
+  ASSERT_NE(pAio, nullptr);
+  ASSERT_EQ(taosAIOGetInflight(pAio), 0);
+
+  STaosAIOReq *pDone[1];
+  ASSERT_EQ(taosAIOGetCompleted(pAio, pDone, 1, true), 0);
+
+  aioTestRead(pAio, path);
+  aioTestReadError(pAio, path);
+  aioTestWrite(pAio, path);
+  taosAIOClose(pAio);
+
+  taosRemoveFile(path);
+}
+
+TEST(osAIOTest, threadPool) { aioTestAll(TD_AIO_THREAD_POOL); }
+
+TEST(osAIOTest, ring) {
+  TdAIOPtr pAio = taosAIOOpen(AIO_TEST_DEPTH, TD_AIO_RING);
+  if (pAio == NULL) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  taosAIOClose(pAio);
+
+  aioTestAll(TD_AIO_RING);
+}
+
+TEST(osAIOTest, closeWithInflight) {
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/osAIOTestClose.data", TD_TMP_DIR_PATH);
+  aioTestCreateFile(path);
+
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_READ);
+  ASSERT_NE(pFile, nullptr);
+
+  int32_t flags[] = {TD_AIO_THREAD_POOL, 0};
+  for (int32_t f = 0; f < tListLen(flags); ++f) {
+    TdAIOPtr pAio = taosAIOOpen(AIO_TEST_DEPTH, flags[f]);
+    ASSERT_NE(pAio, nullptr);
+
+    char        bufs[AIO_TEST_DEPTH][AIO_TEST_BLOCK_SIZE];
+    STaosAIOReq reqs[AIO_TEST_DEPTH] = {0};
+    for (int32_t i = 0; i < AIO_TEST_DEPTH; ++i) {
+      reqs[i].pFile = pFile;
+      reqs[i].buf = bufs[i];
+      reqs[i].count = AIO_TEST_BLOCK_SIZE;
+      reqs[i].offset = (int64_t)i * AIO_TEST_BLOCK_SIZE;
+      STaosAIOReq *pReq = &reqs[i];
+      ASSERT_EQ(taosAIOSubmit(pAio, &pReq, 1), 1);
+    }
+
+    // waits for the requests in flight, whose buffers are on the stack
+    taosAIOClose(pAio);
+    for (int32_t i = 0; i < AIO_TEST_DEPTH; ++i) {
+      ASSERT_EQ(reqs[i].res, AIO_TEST_BLOCK_SIZE);
+    }
+  }
+
+  taosCloseFile(&pFile);
+  taosRemoveFile(path);
+}
+
+TEST(osAIOTest, cleanupAndRestart) {
+  taosAIOCleanup();
+  aioTestAll(TD_AIO_THREAD_POOL);
+  taosAIOCleanup();
+  taosAIOCleanup();
+  aioTestAll(TD_AIO_THREAD_POOL);
+}
+
+#pragma GCC diagnostic pop
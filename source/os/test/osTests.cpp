@@ -168,6 +168,40 @@ TEST(osTest, osFile) {
   //printf("remove file success");
 }
 
+TEST(osTest, osWritevFile) {
+  char *fname = "./osfiletestwritev.txt";
+
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+
+  // more entries than one writev takes, of different lengths
+  const int32_t count = TD_FILE_MAX_IOV * 2 + 3;
+  char          bufs[count][64];
+  TdFileIoVec   vec[count];
+  int64_t       total = 0;
+  for (int32_t i = 0; i < count; ++i) {
+    memset(bufs[i], 'a' + i % 26, sizeof(bufs[i]));
+    vec[i].buf = bufs[i];
+    vec[i].len = i % 64 + 1;
+    total += vec[i].len;
+  }
+
+  ASSERT_EQ(taosWritevFile(pFile, vec, count), total);
+  ASSERT_EQ(taosWritevFile(pFile, vec, 0), 0);
+
+  char   *pRead = (char *)taosMemoryMalloc(total);
+  int64_t offset = 0;
+  ASSERT_EQ(taosPReadFile(pFile, pRead, total, 0), total);
+  for (int32_t i = 0; i < count; ++i) {
+    ASSERT_EQ(memcmp(pRead + offset, bufs[i], vec[i].len), 0);
+    offset += vec[i].len;
+  }
+
+  taosMemoryFree(pRead);
+  taosCloseFile(&pFile);
+  taosRemoveFile(fname);
+}
+
 #ifndef OSFILE_PERFORMANCE_TEST
 
 #define MAX_WORDS          100
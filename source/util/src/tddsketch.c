@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "tddsketch.h"
+
+// keys of infinite values, beyond the key of any finite double
+#define DDSKETCH_MAX_KEY (1 << 20)
+
+static FORCE_INLINE int32_t ddsKey(const SDDSketch *pSketch, double v) {
+  double k = ceil(log(v) * pSketch->multiplier);
+  if (k >= DDSKETCH_MAX_KEY) {
+    return DDSKETCH_MAX_KEY;
+  } else if (k <= -DDSKETCH_MAX_KEY) {
+    return -DDSKETCH_MAX_KEY;
+  }
+  return (int32_t)k;
+}
+
+// the value with the same relative distance to both bounds of the bin, (gamma^(key-1), gamma^key]
+static FORCE_INLINE double ddsValue(const SDDSketch *pSketch, int32_t key) {
+  double gamma = exp(1 / pSketch->multiplier);
+  return exp(key / pSketch->multiplier) * 2 / (1 + gamma);
+}
+
+static void ddsStoreAdd(SDDSketchStore *pStore, int64_t *bins, int32_t numOfBins, int32_t key, int64_t n) {
+  if (pStore->count == 0) {
+    memset(bins, 0, numOfBins * sizeof(int64_t));
+    pStore->minKey = key - numOfBins / 2;
+    pStore->maxKey = key;
+  }
+
+  if (key >= pStore->minKey + numOfBins) {
+    // move the bins down, the lowest ones are collapsed into the first bin
+    int32_t shift = key - numOfBins + 1 - pStore->minKey;
+    int64_t collapsed = 0;
+    if (shift >= numOfBins) {
+      for (int32_t i = 0; i < numOfBins; ++i) {
+        collapsed += bins[i];
+      }
+      memset(bins, 0, numOfBins * sizeof(int64_t));
+    } else {
+      for (int32_t i = 0; i <= shift; ++i) {
+        collapsed += bins[i];
+      }
+      memmove(bins, bins + shift, (numOfBins - shift) * sizeof(int64_t));
+      memset(bins + numOfBins - shift, 0, shift * sizeof(int64_t));
+    }
+    bins[0] = collapsed;
+    pStore->minKey += shift;
+  } else if (key < pStore->minKey) {
+    // move the bins up as far as the largest key allows, the rest goes into the first bin
+    int32_t newMinKey = TMAX(key, pStore->maxKey - numOfBins + 1);
+    if (newMinKey < pStore->minKey) {
+      int32_t shift = pStore->minKey - newMinKey;
+      memmove(bins + shift, bins, (numOfBins - shift) * sizeof(int64_t));
+      memset(bins, 0, shift * sizeof(int64_t));
+      pStore->minKey = newMinKey;
+    }
+  }
+
+  int32_t idx = TMAX(key - pStore->minKey, 0);
+  bins[idx] += n;
+  pStore->count += n;
+  if (key > pStore->maxKey) {
+    pStore->maxKey = key;
+  }
+}
+
+SDDSketch *tDDSketchNewFrom(void *pBuf) {
+  SDDSketch *pSketch = (SDDSketch *)pBuf;
+  memset(pSketch, 0, sizeof(SDDSketch));
+
+  double gamma = (1 + DDSKETCH_RELATIVE_ACCURACY) / (1 - DDSKETCH_RELATIVE_ACCURACY);
+  pSketch->multiplier = 1 / log(gamma);
+  pSketch->min = DBL_MAX;
+  pSketch->max = -DBL_MAX;
+  return pSketch;
+}
+
+void tDDSketchAdd(SDDSketch *pSketch, double v, int64_t n) {
+  if (isnan(v) || n <= 0) {
+    return;
+  }
+
+  if (v >= DBL_MIN) {
+    ddsStoreAdd(&pSketch->pos, pSketch->posBins, DDSKETCH_POSITIVE_BINS, ddsKey(pSketch, v), n);
+  } else if (v <= -DBL_MIN) {
+    ddsStoreAdd(&pSketch->neg, pSketch->negBins, DDSKETCH_NEGATIVE_BINS, ddsKey(pSketch, -v), n);
+  } else {
+    pSketch->zeroCount += n;
+  }
+
+  pSketch->count += n;
+  if (v < pSketch->min) {
+    pSketch->min = v;
+  }
+  if (v > pSketch->max) {
+    pSketch->max = v;
+  }
+}
+
+void tDDSketchMerge(SDDSketch *pDst, const SDDSketch *pSrc) {
+  if (pSrc->count <= 0) {
+    return;
+  }
+
+  for (int32_t i = 0; pSrc->pos.count > 0 && i < DDSKETCH_POSITIVE_BINS; ++i) {
+    if (pSrc->posBins[i] > 0) {
+      ddsStoreAdd(&pDst->pos, pDst->posBins, DDSKETCH_POSITIVE_BINS, pSrc->pos.minKey + i, pSrc->posBins[i]);
+    }
+  }
+
+  for (int32_t i = 0; pSrc->neg.count > 0 && i < DDSKETCH_NEGATIVE_BINS; ++i) {
+    if (pSrc->negBins[i] > 0) {
+      ddsStoreAdd(&pDst->neg, pDst->negBins, DDSKETCH_NEGATIVE_BINS, pSrc->neg.minKey + i, pSrc->negBins[i]);
+    }
+  }
+
+  pDst->zeroCount += pSrc->zeroCount;
+  pDst->count += pSrc->count;
+  pDst->min = TMIN(pDst->min, pSrc->min);
+  pDst->max = TMAX(pDst->max, pSrc->max);
+}
+
+double tDDSketchQuantile(const SDDSketch *pSketch, double q) {
+  if (pSketch->count <= 0) {
+    return 0;
+  }
+
+  // the extremes are tracked exactly
+  if (q <= 0) {
+    return pSketch->min;
+  } else if (q >= 1) {
+    return pSketch->max;
+  }
+
+  double  rank = q * (pSketch->count - 1);
+  int64_t n = 0;
+  double  v = pSketch->max;
+
+  // negative values first, from the largest magnitude
+  for (int32_t i = DDSKETCH_NEGATIVE_BINS - 1; pSketch->neg.count > 0 && i >= 0; --i) {
+    n += pSketch->negBins[i];
+    if (n > rank) {
+      v = -ddsValue(pSketch, pSketch->neg.minKey + i);
+      goto _end;
+    }
+  }
+
+  n += pSketch->zeroCount;
+  if (n > rank) {
+    v = 0;
+    goto _end;
+  }
+
+  for (int32_t i = 0; pSketch->pos.count > 0 && i < DDSKETCH_POSITIVE_BINS; ++i) {
+    n += pSketch->posBins[i];
+    if (n > rank) {
+      v = ddsValue(pSketch, pSketch->pos.minKey + i);
+      goto _end;
+    }
+  }
+
+_end:
+  return TMIN(TMAX(v, pSketch->min), pSketch->max);
+}
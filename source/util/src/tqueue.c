@@ -24,6 +24,7 @@ int64_t tsRpcQueueMemoryUsed = 0;
 struct STaosQueue {
   STaosQnode   *head;
   STaosQnode   *tail;
+  STaosQnode   *highTail;  // last item of the high priority lane at the front of the queue
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
@@ -191,6 +192,10 @@ void taosFreeQitem(void *pItem) {
 }
 
 int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
+  return taosWriteQitemWithPriority(queue, pItem, QITEM_PRI_NORMAL);
+}
+
+int32_t taosWriteQitemWithPriority(STaosQueue *queue, void *pItem, EQItemPri priority) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
   pNode->timestamp = taosGetTimestampUs();
@@ -212,7 +217,18 @@ int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
     return code;
   }
 
-  if (queue->tail) {
+  if (priority == QITEM_PRI_HIGH) {
+    // high priority items overtake normal ones but keep FIFO order among themselves
+    if (queue->highTail) {
+      pNode->next = queue->highTail->next;
+      queue->highTail->next = pNode;
+    } else {
+      pNode->next = queue->head;
+      queue->head = pNode;
+    }
+    queue->highTail = pNode;
+    if (pNode->next == NULL) queue->tail = pNode;
+  } else if (queue->tail) {
     queue->tail->next = pNode;
     queue->tail = pNode;
   } else {
@@ -242,6 +258,7 @@ int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
     *ppItem = pNode->item;
     queue->head = pNode->next;
     if (queue->head == NULL) queue->tail = NULL;
+    if (queue->highTail == pNode) queue->highTail = NULL;
     queue->numOfItems--;
     queue->memOfItems -= (pNode->size + pNode->dataSize);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, 1);
@@ -286,6 +303,7 @@ int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
 
     queue->head = NULL;
     queue->tail = NULL;
+    queue->highTail = NULL;
     queue->numOfItems = 0;
     queue->memOfItems = 0;
     uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
@@ -456,6 +474,7 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
 
       queue->head = pNode->next;
       if (queue->head == NULL) queue->tail = NULL;
+      if (queue->highTail == pNode) queue->highTail = NULL;
       // queue->numOfItems--;
       queue->memOfItems -= (pNode->size + pNode->dataSize);
       atomic_sub_fetch_32(&qset->numOfItems, 1);
@@ -503,6 +522,7 @@ int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *
 
       queue->head = NULL;
       queue->tail = NULL;
+      queue->highTail = NULL;
       // queue->numOfItems = 0;
       queue->memOfItems = 0;
       uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "tddsketch.h"
+
+using namespace std;
+
+namespace {
+
+void checkQuantiles(const SDDSketch *pSketch, vector<double> &vals) {
+  sort(vals.begin(), vals.end());
+  for (int32_t p = 0; p <= 100; p += 5) {
+    double q = p / 100.0;
+    double expect = vals[(size_t)(q * (vals.size() - 1))];
+    double res = tDDSketchQuantile(pSketch, q);
+    ASSERT_LE(fabs(res - expect), fabs(expect) * DDSKETCH_RELATIVE_ACCURACY * 1.01 + 1e-9) << "p:" << p;
+  }
+}
+
+}  // namespace
+
+TEST(TD_UTIL_DDSKETCH_TEST, add_quantile) {
+  SDDSketch sketch;
+  tDDSketchNewFrom(&sketch);
+  GTEST_ASSERT_EQ(tDDSketchQuantile(&sketch, 0.5), 0);
+
+  vector<double> vals;
+  srand(0);
+  for (int32_t i = 0; i < 100000; ++i) {
+    double v = (rand() / (double)RAND_MAX - 0.3) * 1e6;
+    if (i % 11 == 0) {
+      v = 0;
+    }
+    vals.push_back(v);
+    tDDSketchAdd(&sketch, v, 1);
+  }
+
+  GTEST_ASSERT_EQ(sketch.count, 100000);
+  GTEST_ASSERT_EQ(tDDSketchQuantile(&sketch, 0), *min_element(vals.begin(), vals.end()));
+  GTEST_ASSERT_EQ(tDDSketchQuantile(&sketch, 1), *max_element(vals.begin(), vals.end()));
+  checkQuantiles(&sketch, vals);
+}
+
+TEST(TD_UTIL_DDSKETCH_TEST, merge) {
+  SDDSketch s1, s2;
+  tDDSketchNewFrom(&s1);
+  tDDSketchNewFrom(&s2);
+
+  vector<double> vals;
+  srand(1);
+  for (int32_t i = 0; i < 100000; ++i) {
+    double v = exp(rand() / (double)RAND_MAX * 14);
+    vals.push_back(v);
+    tDDSketchAdd((i & 1) ? &s1 : &s2, v, 1);
+  }
+
+  tDDSketchMerge(&s1, &s2);
+  GTEST_ASSERT_EQ(s1.count, 100000);
+  checkQuantiles(&s1, vals);
+}
+
+TEST(TD_UTIL_DDSKETCH_TEST, collapse) {
+  SDDSketch sketch;
+  tDDSketchNewFrom(&sketch);
+
+  // far more magnitudes than bins, the lowest ones are collapsed while the higher quantiles stay accurate
+  vector<double> vals;
+  for (int32_t i = 0; i < 4000; ++i) {
+    double v = pow(10, i / 100.0 - 10);
+    vals.push_back(v);
+    tDDSketchAdd(&sketch, v, 1);
+  }
+  tDDSketchAdd(&sketch, NAN, 1);
+
+  GTEST_ASSERT_EQ(sketch.count, 4000);
+  double expect = vals[(size_t)(0.99 * (vals.size() - 1))];
+  ASSERT_LE(fabs(tDDSketchQuantile(&sketch, 0.99) - expect), expect * DDSKETCH_RELATIVE_ACCURACY * 1.01);
+}
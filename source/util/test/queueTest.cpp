@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "tqueue.h"
+
+using namespace std;
+
+namespace {
+
+void writeItems(STaosQueue *queue, const vector<pair<int32_t, EQItemPri>> &items) {
+  for (auto &item : items) {
+    int32_t *pItem = (int32_t *)taosAllocateQitem(sizeof(int32_t), DEF_QITEM, 0);
+    ASSERT_NE(pItem, nullptr);
+    *pItem = item.first;
+    ASSERT_EQ(taosWriteQitemWithPriority(queue, pItem, item.second), 0);
+  }
+}
+
+vector<int32_t> readItems(STaosQueue *queue) {
+  vector<int32_t> res;
+  int32_t        *pItem = NULL;
+  while (taosReadQitem(queue, (void **)&pItem) != 0) {
+    res.push_back(*pItem);
+    taosFreeQitem(pItem);
+  }
+  return res;
+}
+
+vector<int32_t> readAllItems(STaosQueue *queue) {
+  vector<int32_t> res;
+  STaosQall      *qall = taosAllocateQall();
+  int32_t         num = taosReadAllQitems(queue, qall);
+  int32_t        *pItem = NULL;
+  for (int32_t i = 0; i < num; ++i) {
+    if (taosGetQitem(qall, (void **)&pItem) == 0) break;
+    res.push_back(*pItem);
+    taosFreeQitem(pItem);
+  }
+  taosFreeQall(qall);
+  return res;
+}
+
+}  // namespace
+
+TEST(TD_UTIL_QUEUE_TEST, priority_order) {
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(queue, nullptr);
+
+  // high priority items overtake the normal ones and keep their own order
+  writeItems(queue, {{1, QITEM_PRI_NORMAL}, {2, QITEM_PRI_NORMAL}, {3, QITEM_PRI_HIGH}, {4, QITEM_PRI_NORMAL},
+                     {5, QITEM_PRI_HIGH}});
+  ASSERT_EQ(taosQueueItemSize(queue), 5);
+  ASSERT_EQ(readItems(queue), vector<int32_t>({3, 5, 1, 2, 4}));
+  ASSERT_TRUE(taosQueueEmpty(queue));
+
+  // only high priority items, and a high priority item into an empty queue
+  writeItems(queue, {{1, QITEM_PRI_HIGH}, {2, QITEM_PRI_HIGH}});
+  ASSERT_EQ(readItems(queue), vector<int32_t>({1, 2}));
+  writeItems(queue, {{3, QITEM_PRI_HIGH}, {4, QITEM_PRI_NORMAL}});
+  ASSERT_EQ(readItems(queue), vector<int32_t>({3, 4}));
+
+  // the high priority lane is empty again after its last item is read
+  writeItems(queue, {{1, QITEM_PRI_HIGH}, {2, QITEM_PRI_NORMAL}});
+  int32_t *pItem = NULL;
+  ASSERT_NE(taosReadQitem(queue, (void **)&pItem), 0);
+  ASSERT_EQ(*pItem, 1);
+  taosFreeQitem(pItem);
+  writeItems(queue, {{3, QITEM_PRI_NORMAL}, {4, QITEM_PRI_HIGH}});
+  ASSERT_EQ(readItems(queue), vector<int32_t>({4, 2, 3}));
+
+  taosCloseQueue(queue);
+}
+
+TEST(TD_UTIL_QUEUE_TEST, priority_read_all) {
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(queue, nullptr);
+
+  writeItems(queue, {{1, QITEM_PRI_NORMAL}, {2, QITEM_PRI_HIGH}, {3, QITEM_PRI_NORMAL}, {4, QITEM_PRI_HIGH}});
+  ASSERT_EQ(readAllItems(queue), vector<int32_t>({2, 4, 1, 3}));
+  ASSERT_TRUE(taosQueueEmpty(queue));
+
+  // the items written after a read all are not put behind the old high priority lane
+  writeItems(queue, {{5, QITEM_PRI_NORMAL}, {6, QITEM_PRI_HIGH}});
+  ASSERT_EQ(readAllItems(queue), vector<int32_t>({6, 5}));
+
+  taosCloseQueue(queue);
+}
+
+TEST(TD_UTIL_QUEUE_TEST, priority_qset) {
+  STaosQset  *qset = taosOpenQset();
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+
+  writeItems(queue, {{1, QITEM_PRI_NORMAL}, {2, QITEM_PRI_HIGH}, {3, QITEM_PRI_NORMAL}});
+
+  vector<int32_t> res;
+  for (int32_t i = 0; i < 3; ++i) {
+    SQueueInfo qinfo = {0};
+    int32_t   *pItem = NULL;
+    ASSERT_NE(taosReadQitemFromQset(qset, (void **)&pItem, &qinfo), 0);
+    res.push_back(*pItem);
+    taosUpdateItemSize((STaosQueue *)qinfo.queue, 1);
+    taosFreeQitem(pItem);
+  }
+  ASSERT_EQ(res, vector<int32_t>({2, 1, 3}));
+
+  writeItems(queue, {{4, QITEM_PRI_NORMAL}, {5, QITEM_PRI_HIGH}});
+  STaosQall *qall = taosAllocateQall();
+  SQueueInfo qinfo = {0};
+  ASSERT_EQ(taosReadAllQitemsFromQset(qset, qall, &qinfo), 2);
+  taosUpdateItemSize((STaosQueue *)qinfo.queue, 2);
+  int32_t *pItem = NULL;
+  ASSERT_NE(taosGetQitem(qall, (void **)&pItem), 0);
+  ASSERT_EQ(*pItem, 5);
+  taosFreeQitem(pItem);
+  ASSERT_NE(taosGetQitem(qall, (void **)&pItem), 0);
+  ASSERT_EQ(*pItem, 4);
+  taosFreeQitem(pItem);
+  taosFreeQall(qall);
+
+  taosRemoveFromQset(qset, queue);
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+}
@@ -218,7 +218,7 @@ class TDTestCase:
             tdSql.checkEqual(20470,len(tdSql.queryResult))
 
         tdSql.query("select * from information_schema.ins_columns where db_name ='information_schema'")
-        tdSql.checkEqual(True, len(tdSql.queryResult) in range(215, 230))
+        tdSql.checkEqual(True, len(tdSql.queryResult) in range(215, 233))
 
         tdSql.query("select * from information_schema.ins_columns where db_name ='performance_schema'")
         tdSql.checkEqual(54, len(tdSql.queryResult))
@@ -263,6 +263,14 @@ class TDTestCase:
         tdSql.error(f'select c_active_code from information_schema.ins_dnodes')
         tdSql.error('alter all dnodes "cActiveCode" ""')
 
+    def ins_vnodes_check(self):
+        tdSql.query(f'select vgroup_id, buffer_usage, buffer_waste, buffer_overflow from information_schema.ins_vnodes')
+        tdSql.checkEqual(True, len(tdSql.queryResult) > 0)
+        for row in tdSql.queryResult:
+            tdSql.checkEqual(True, row[1] >= 0)
+            tdSql.checkEqual(True, row[2] >= 0 and row[2] <= row[1])
+            tdSql.checkEqual(True, row[3] >= 0 and row[3] <= row[1])
+
     def ins_grants_check(self):
         grant_name_dict = {
             'stream':'stream',
@@ -319,6 +327,7 @@ class TDTestCase:
         self.ins_stable_check()
         self.ins_stable_check2()
         self.ins_dnodes_check()
+        self.ins_vnodes_check()
         self.ins_grants_check()
 
 
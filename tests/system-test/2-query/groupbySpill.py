@@ -0,0 +1,96 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    # the groups take more than 1MB, the rows of new groups are spilled by the partition of their key
+    updatecfgDict = {'queryBufferSize': 1}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.ts = 1537146000000
+        self.rowNum = 100000
+        # each group has two rows, the second one comes after the memory is full
+        self.groupNum = self.rowNum // 2
+        self.batchNum = 1000
+
+    def insertData(self, tbname, start, stop):
+        for batchStart in range(start, stop, self.batchNum):
+            values = ""
+            for i in range(batchStart, min(batchStart + self.batchNum, stop)):
+                c2 = "null" if i % 1000 == 0 else (i % self.groupNum) % 7
+                values += f"({self.ts + i}, {i}, {c2}, 'v{i % self.groupNum}') "
+            tdSql.execute(f"insert into {self.dbname}.{tbname} values {values}")
+
+    # the groups of c1 % groupNum, each of them is aggregated from the rows g and g + groupNum
+    def checkGroups(self, tbname):
+        dbname = self.dbname
+        tdSql.query(f"select c1 % {self.groupNum} g, count(*), sum(c1), min(c1), max(c1), last(c3) "
+                    f"from {dbname}.{tbname} group by c1 % {self.groupNum}")
+        tdSql.checkRows(self.groupNum)
+
+        groups = set()
+        for row in range(tdSql.queryRows):
+            g = int(tdSql.getData(row, 0))
+            tdSql.checkData(row, 1, 2)
+            tdSql.checkData(row, 2, 2 * g + self.groupNum)
+            tdSql.checkData(row, 3, g)
+            tdSql.checkData(row, 4, g + self.groupNum)
+            tdSql.checkData(row, 5, f"v{g}")
+            groups.add(g)
+
+        if len(groups) != self.groupNum:
+            tdLog.exit(f"table:{tbname}, {len(groups)} distinct groups, expect {self.groupNum}")
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.prepare(dbname=dbname, drop=True, vgroups=2)
+
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 int, c3 binary(32))")
+        tdSql.execute(f"create table {dbname}.stb(ts timestamp, c1 int, c2 int, c3 binary(32)) tags(t int)")
+        tdSql.execute(f"create table {dbname}.ct1 using {dbname}.stb tags(1)")
+        tdSql.execute(f"create table {dbname}.ct2 using {dbname}.stb tags(2)")
+        self.insertData("ntb", 0, self.rowNum)
+        self.insertData("ct1", 0, self.rowNum // 2)
+        self.insertData("ct2", self.rowNum // 2, self.rowNum)
+
+        # the partitions of the first pass still hold too many groups and are spilled again in the next level
+        self.checkGroups("ntb")
+        self.checkGroups("stb")
+
+        rowSum = self.rowNum * (self.rowNum - 1) // 2
+        tdSql.query(f"select count(*), sum(cnt), sum(s) from (select count(*) cnt, sum(c1) s from {dbname}.ntb "
+                    f"group by c3)")
+        tdSql.checkData(0, 0, self.groupNum)
+        tdSql.checkData(0, 1, self.rowNum)
+        tdSql.checkData(0, 2, rowSum)
+
+        # one group per row
+        tdSql.query(f"select count(*), sum(cnt) from (select count(*) cnt from {dbname}.stb group by c1)")
+        tdSql.checkData(0, 0, self.rowNum)
+        tdSql.checkData(0, 1, self.rowNum)
+
+        # the null keys are a group of their own
+        tdSql.query(f"select count(*), sum(cnt) from (select count(*) cnt from {dbname}.ntb group by c2, c3)")
+        tdSql.checkData(0, 0, self.groupNum)
+        tdSql.checkData(0, 1, self.rowNum)
+        tdSql.query(f"select count(*) from {dbname}.ntb where c2 is null")
+        nullRows = tdSql.getData(0, 0)
+        tdSql.query(f"select count(*) from {dbname}.ntb group by c2 having c2 is null")
+        tdSql.checkData(0, 0, nullRows)
+
+        # a filter of the groups after the spilled partitions are aggregated
+        tdSql.query(f"select c3, sum(c1) from {dbname}.ntb group by c3 having sum(c1) < {self.groupNum + 20}")
+        tdSql.checkRows(10)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,92 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    # the hash join of the child tables spills its build rows once they take more than 1MB
+    updatecfgDict = {'queryBufferSize': 1}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.ts = 1537146000000
+        # child tables of each super table, the tag blocks of every vgroup are spilled after the first one
+        self.tableNum = 4000
+        self.batchNum = 200
+
+    # the tags of sta are [0, tableNum), the tags of stb are [tableNum / 2, tableNum * 3 / 2),
+    # so half of the keys of each side never match and are pruned by the bloom filter of the spilled rows
+    def createTables(self, stbname, tagStart):
+        dbname = self.dbname
+        for start in range(0, self.tableNum, self.batchNum):
+            sql = "insert into"
+            for i in range(start, start + self.batchNum):
+                tag = tagStart + i
+                sql += f" {dbname}.{stbname}_{i} using {dbname}.{stbname} tags({tag}, 'n{tag}')"
+                sql += f" values({self.ts}, {tag}, {tag * 10}) ({self.ts + 1}, {tag}, {tag * 10 + 1})"
+            tdSql.execute(sql)
+
+    def checkJoinRows(self, sql, expectTags):
+        tdSql.query(sql)
+        tdSql.checkRows(len(expectTags) * 2)
+
+        tags = []
+        for row in range(tdSql.queryRows):
+            tag = tdSql.getData(row, 0)
+            tdSql.checkData(row, 1, tag)
+            tdSql.checkData(row, 2, tag)
+            tdSql.checkData(row, 3, f"n{tag}")
+            tags.append(tag)
+
+        if sorted(tags) != sorted(expectTags * 2):
+            tdLog.exit(f"sql:{sql}, unexpected tags of the join result")
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.prepare(dbname=dbname, drop=True, vgroups=4)
+
+        tdSql.execute(f"create table {dbname}.sta(ts timestamp, c1 int, c2 bigint) tags(t1 int, t2 binary(16))")
+        tdSql.execute(f"create table {dbname}.stb(ts timestamp, c1 int, c2 bigint) tags(t1 int, t2 binary(16))")
+        self.createTables("sta", 0)
+        self.createTables("stb", self.tableNum // 2)
+
+        expectTags = list(range(self.tableNum // 2, self.tableNum))
+        expectCount = len(expectTags) * 2
+
+        # every spill partition holds several pages, so it is joined in more than one round
+        self.checkJoinRows(f"select a.t1, b.t1, b.c1, a.t2 from {dbname}.sta a, {dbname}.stb b "
+                           f"where a.t1 = b.t1 and a.ts = b.ts", expectTags)
+        self.checkJoinRows(f"select b.t1, a.t1, a.c1, b.t2 from {dbname}.stb b, {dbname}.sta a "
+                           f"where a.t1 = b.t1 and a.ts = b.ts", expectTags)
+
+        tdSql.query(f"select count(*), sum(a.c1), sum(b.c2) from {dbname}.sta a, {dbname}.stb b "
+                    f"where a.t1 = b.t1 and a.ts = b.ts")
+        tdSql.checkData(0, 0, expectCount)
+        tdSql.checkData(0, 1, sum(expectTags) * 2)
+        tdSql.checkData(0, 2, sum(expectTags) * 20 + len(expectTags))
+
+        # two join keys
+        tdSql.query(f"select count(*) from {dbname}.sta a, {dbname}.stb b "
+                    f"where a.t1 = b.t1 and a.t2 = b.t2 and a.ts = b.ts")
+        tdSql.checkData(0, 0, expectCount)
+
+        # the filter of the tags leaves keys of one side only, none of them is joined
+        tdSql.query(f"select count(*) from {dbname}.sta a, {dbname}.stb b "
+                    f"where a.t1 = b.t1 and a.ts = b.ts and a.t1 < {self.tableNum // 2}")
+        tdSql.checkData(0, 0, 0)
+
+        # a few keys are left on each side after the filter
+        tdSql.query(f"select count(*) from {dbname}.sta a, {dbname}.stb b "
+                    f"where a.t1 = b.t1 and a.ts = b.ts and a.t1 < {self.tableNum // 2 + 10}")
+        tdSql.checkData(0, 0, 20)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
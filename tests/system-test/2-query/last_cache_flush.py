@@ -0,0 +1,114 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+from util.log import tdLog
+from util.cases import tdCases
+from util.sql import tdSql
+from util.dnodes import tdDnodes
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+        self.dbname = "last_cache_flush"
+        self.tbnum = 1000
+        self.colnum = 8
+        self.ts = 1700000000000
+        # last value of each column of each table, and whether the last rows have nulls
+        self.last = {}
+        self.lastRowNull = False
+
+    def restartTaosd(self, index=1):
+        tdDnodes.stop(index)
+        tdDnodes.startWithoutSleep(index)
+        tdSql.execute(f"use {self.dbname}")
+
+    def prepare(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        # a cache of 1MB cannot hold the last and last_row entries of all the columns, they are evicted while writing
+        tdSql.execute(f"create database {self.dbname} vgroups 1 cachemodel 'both' cachesize 1")
+        tdSql.execute(f"use {self.dbname}")
+        cols = ", ".join([f"c{i} int" for i in range(self.colnum)])
+        tdSql.execute(f"create stable st (ts timestamp, {cols}) tags (t int)")
+        for i in range(self.tbnum):
+            self.last[i] = [None] * self.colnum
+
+    # insert rows into every table, the last row of a table has nulls in the odd columns when nullOdd is set
+    def insert(self, rows, nullOdd):
+        for start in range(0, self.tbnum, 100):
+            sql = "insert into"
+            for i in range(start, start + 100):
+                sql += f" ct{i} using st tags({i}) values"
+                for j in range(rows):
+                    ts = self.ts + j
+                    vals = []
+                    for k in range(self.colnum):
+                        if nullOdd and j == rows - 1 and k % 2 == 1:
+                            vals.append("null")
+                        else:
+                            val = i * 10000 + j * 10 + k
+                            vals.append(str(val))
+                            self.last[i][k] = val
+                    sql += f" ({ts}, {', '.join(vals)})"
+            tdSql.execute(sql)
+        self.ts += rows
+        self.lastRowNull = nullOdd
+
+    def check(self):
+        lastCols = ", ".join([f"last(c{k})" for k in range(self.colnum)])
+        tdSql.query(f"select tbname, {lastCols} from st partition by tbname")
+        tdSql.checkRows(self.tbnum)
+        for row in tdSql.queryResult:
+            i = int(row[0][2:])
+            for k in range(self.colnum):
+                tdSql.checkEqual(row[k + 1], self.last[i][k])
+
+        tdSql.query(f"select tbname, last_row(c0), last_row(c1) from st partition by tbname")
+        tdSql.checkRows(self.tbnum)
+        for row in tdSql.queryResult:
+            i = int(row[0][2:])
+            tdSql.checkEqual(row[1], self.last[i][0])
+            tdSql.checkEqual(row[2], None if self.lastRowNull else self.last[i][1])
+
+    def run(self):
+        self.prepare()
+
+        # entries created by the writes are dirty in the cache, evicted ones are written to rocks
+        self.insert(5, False)
+        self.check()
+
+        # the dirty entries are written on commit, and read back from rocks after the restart
+        tdSql.execute(f"flush database {self.dbname}")
+        self.restartTaosd()
+        self.check()
+
+        # newer values with nulls update last_row but keep the older last values
+        self.insert(3, True)
+        self.check()
+        tdSql.execute(f"flush database {self.dbname}")
+        self.restartTaosd()
+        self.check()
+
+        # the writes after the last commit come back from the wal
+        self.insert(2, False)
+        self.restartTaosd()
+        self.check()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
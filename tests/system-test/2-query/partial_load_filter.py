@@ -0,0 +1,106 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.ts = 1537146000000
+        # one file block holds maxrows rows
+        self.blockRows = 200
+        self.rowNum = self.blockRows * 6
+
+    # c2 decides the blocks of "c2 > 100 and c2 < 900", all of their ranges cover the condition in the block sma:
+    # block 0, 3: no row qualifies, the block is released after the filter columns are loaded
+    # block 1, 4: the odd rows qualify, the remain columns are loaded after the filter
+    # block 2, 5: all rows qualify
+    def c2Value(self, i):
+        kind = (i // self.blockRows) % 3
+        if kind == 0:
+            return 0 if i % 2 == 0 else 1000
+        elif kind == 1:
+            return 0 if i % 2 == 0 else 500
+        else:
+            return 500
+
+    def qualified(self, i):
+        c2 = self.c2Value(i)
+        return c2 > 100 and c2 < 900
+
+    def insertData(self, tbname):
+        for start in range(0, self.rowNum, 100):
+            values = ""
+            for i in range(start, start + 100):
+                values += f"({self.ts + i}, {i}, {self.c2Value(i)}, 'r{i}', {i * 10}) "
+            tdSql.execute(f"insert into {self.dbname}.{tbname} values {values}")
+
+    def checkRowsOfQualified(self, sql, tables=1):
+        tdSql.query(sql)
+        expect = [i for i in range(self.rowNum) if self.qualified(i)]
+        tdSql.checkRows(len(expect) * tables)
+
+        c1List = []
+        for row in range(tdSql.queryRows):
+            c1 = tdSql.getData(row, 0)
+            c1List.append(c1)
+            tdSql.checkData(row, 1, f"r{c1}")
+            tdSql.checkData(row, 2, c1 * 10)
+
+        if sorted(c1List) != sorted(expect * tables):
+            tdLog.exit(f"sql:{sql}, unexpected rows: {c1List}")
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.prepare(dbname=dbname, drop=True, stt_trigger=1, maxrows=self.blockRows, minrows=10)
+
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 double, c3 binary(16), c4 bigint)")
+        tdSql.execute(f"create table {dbname}.stb(ts timestamp, c1 int, c2 double, c3 binary(16), c4 bigint) tags(t int)")
+        tdSql.execute(f"create table {dbname}.ct1 using {dbname}.stb tags(1)")
+        tdSql.execute(f"create table {dbname}.ct2 using {dbname}.stb tags(2)")
+        for tbname in ["ntb", "ct1", "ct2"]:
+            self.insertData(tbname)
+        tdSql.execute(f"flush database {dbname}")
+
+        cond = "c2 > 100 and c2 < 900"
+        expect = [i for i in range(self.rowNum) if self.qualified(i)]
+
+        # fully filtered blocks are released, partly filtered ones load c3 and c4 after the filter
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.ntb where {cond}")
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.ntb where {cond} order by ts desc")
+        tdSql.query(f"select c3 from {dbname}.ntb where {cond}")
+        tdSql.checkRows(len(expect))
+
+        tdSql.query(f"select count(*), sum(c4), max(c1) from {dbname}.ntb where {cond}")
+        tdSql.checkData(0, 0, len(expect))
+        tdSql.checkData(0, 1, sum(expect) * 10)
+        tdSql.checkData(0, 2, max(expect))
+
+        # no block has qualified rows
+        tdSql.query(f"select c1, c3, c4 from {dbname}.ntb where c2 > 100 and c2 < 400")
+        tdSql.checkRows(0)
+        tdSql.query(f"select count(*) from {dbname}.ntb where c2 > 100 and c2 < 400")
+        tdSql.checkData(0, 0, 0)
+
+        # the filter uses every queried column, nothing is left to load after the filter
+        tdSql.query(f"select c2 from {dbname}.ntb where {cond}")
+        tdSql.checkRows(len(expect))
+
+        # the filter uses a column and a tag
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.stb where {cond} and t = 2")
+
+        # table scan and table merge scan of the super table
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.stb where {cond}", 2)
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.stb where {cond} order by ts", 2)
+        self.checkRowsOfQualified(f"select c1, c3, c4 from {dbname}.stb where {cond} partition by tbname", 2)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())